@@ -6,6 +6,7 @@
 #include <iomanip>
 #include <sstream>
 #include <filesystem>
+#include "energy_meter.hpp"
 
 namespace fs = std::filesystem;
 
@@ -13,6 +14,7 @@ class BenchmarkLog {
 private:
     std::string filename_;
     bool fileExists_;
+    bool energyColumns_;  // false for files created before the energy columns
 
     static std::string getTimestamp() {
         auto now = std::time(nullptr);
@@ -30,20 +32,45 @@ private:
         return oss.str();
     }
 
+    // pkg_energy_j,dram_energy_j,states_per_j (NA when no counters)
+    void writeEnergy(std::ofstream& file, const EnergyReading& energy, long long states) const {
+        if (!energyColumns_) return;
+        if (!energy.valid) {
+            file << "NA,NA,NA,";
+            return;
+        }
+        file << std::fixed << std::setprecision(3) << energy.packageJ << ","
+             << energy.dramJ << ","
+             << std::scientific << std::setprecision(4)
+             << (energy.totalJ() > 0.0 ? states / energy.totalJ() : 0.0) << ","
+             << std::fixed;
+    }
+
 public:
     BenchmarkLog(const std::string& baseDir, const std::string& type) {
         fs::create_directories(baseDir);
         filename_ = baseDir + "/" + type + "_benchmark.csv";
         fileExists_ = fs::exists(filename_);
+
+        // Keep appending in the layout of an existing file
+        energyColumns_ = true;
+        if (fileExists_) {
+            std::ifstream in(filename_);
+            std::string header;
+            std::getline(in, header);
+            energyColumns_ = header.empty() || header.find("pkg_energy_j") != std::string::npos;
+        }
     }
 
     void logOpenMP(int n, int threads, int length, double time,
                    double speedup, double efficiency, long long states,
-                   const std::string& changes = "") {
+                   const std::string& changes = "",
+                   const EnergyReading& energy = EnergyReading()) {
         std::ofstream file(filename_, std::ios::app);
 
         if (!fileExists_) {
-            file << "timestamp,date,n,threads,length,time_s,speedup,efficiency_pct,states,changes\n";
+            file << "timestamp,date,n,threads,length,time_s,speedup,efficiency_pct,states,"
+                 << "pkg_energy_j,dram_energy_j,states_per_j,changes\n";
             fileExists_ = true;
         }
 
@@ -55,17 +82,20 @@ public:
              << std::fixed << std::setprecision(5) << time << ","
              << std::setprecision(2) << speedup << ","
              << std::setprecision(1) << efficiency << ","
-             << states << ","
-             << "\"" << changes << "\"\n";
+             << states << ",";
+        writeEnergy(file, energy, states);
+        file << "\"" << changes << "\"\n";
     }
 
     void logMPI(int n, int mpiProcs, int ompThreads, int length, double time,
                 double speedup, double efficiency, long long states,
-                const std::string& changes = "") {
+                const std::string& changes = "",
+                const EnergyReading& energy = EnergyReading()) {
         std::ofstream file(filename_, std::ios::app);
 
         if (!fileExists_) {
-            file << "timestamp,date,n,mpi_procs,omp_threads,length,time_s,speedup,efficiency_pct,states,changes\n";
+            file << "timestamp,date,n,mpi_procs,omp_threads,length,time_s,speedup,efficiency_pct,states,"
+                 << "pkg_energy_j,dram_energy_j,states_per_j,changes\n";
             fileExists_ = true;
         }
 
@@ -78,7 +108,47 @@ public:
              << std::fixed << std::setprecision(5) << time << ","
              << std::setprecision(2) << speedup << ","
              << std::setprecision(1) << efficiency << ","
-             << states << ","
-             << "\"" << changes << "\"\n";
+             << states << ",";
+        writeEnergy(file, energy, states);
+        file << "\"" << changes << "\"\n";
+    }
+
+    // Bound-slack sweep: one run with the initial bound at optimum + slack.
+    // firstSolution < 0 (no solution within the bound) is written NA;
+    // timeline is "length@seconds" per improvement of the shared bound.
+    void logSlack(const std::string& engine, int n, int mpiProcs, int ompThreads, int slack,
+                  int initialBound, int length, double time, double firstSolution,
+                  long long states, int boundUpdates, const std::string& timeline,
+                  const std::string& changes = "",
+                  const EnergyReading& energy = EnergyReading()) {
+        std::ofstream file(filename_, std::ios::app);
+
+        if (!fileExists_) {
+            file << "timestamp,date,engine,n,mpi_procs,omp_threads,slack,initial_bound,length,"
+                 << "time_s,first_solution_s,states,bound_updates,bound_timeline,"
+                 << "pkg_energy_j,dram_energy_j,states_per_j,changes\n";
+            fileExists_ = true;
+        }
+
+        file << getTimestamp() << ","
+             << getDateStamp() << ","
+             << engine << ","
+             << n << ","
+             << mpiProcs << ","
+             << ompThreads << ","
+             << slack << ","
+             << initialBound << ","
+             << length << ","
+             << std::fixed << std::setprecision(5) << time << ",";
+        if (firstSolution >= 0.0) {
+            file << firstSolution << ",";
+        } else {
+            file << "NA,";
+        }
+        file << states << ","
+             << boundUpdates << ","
+             << "\"" << timeline << "\",";
+        writeEnergy(file, energy, states);
+        file << "\"" << changes << "\"\n";
     }
 };
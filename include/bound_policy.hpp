@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+// =============================================================================
+// BOUND PROPAGATION POLICIES - How search threads see the shared best length
+// =============================================================================
+// The kernels read the bound once per node and once per candidate position.
+// With the bound in one shared atomic, every improvement (a CAS from any
+// socket) invalidates the line in all cores that read it. The policies trade
+// that coherence traffic against pruning delay:
+//
+//   Atomic      : shared atomic read on every node and candidate (reference)
+//   Cached      : per-thread copy, re-read from the atomic every K nodes
+//   Epoch       : per-thread copy, re-read when a sequence counter (own cache
+//                 line, written only on improvements) changes; checked per node
+//   NumaReplica : one copy of the bound per NUMA domain, read like Atomic
+//
+// Writers always go through SharedBound::lower(), which updates the atomic,
+// the replicas and the epoch. A thread's own solutions tighten its copy
+// immediately, whatever the policy.
+//
+// Instrumentation (Cached / Epoch): checks of the shared state, refreshes
+// (checks that found a tighter bound) and stale nodes: nodes expanded between
+// the last check that saw the old bound and the one that saw the new bound,
+// an upper bound on the work done with a stale bound (Cached only). Atomic
+// and NumaReplica see every improvement at the next candidate: nothing to
+// count. Throughput is read from the usual states/s.
+// =============================================================================
+
+enum class BoundPolicy {
+    Atomic,
+    Cached,
+    Epoch,
+    NumaReplica
+};
+
+constexpr int DEFAULT_BOUND_REFRESH = 256;  // Cached: nodes between two reads
+
+inline const char* boundPolicyName(BoundPolicy policy) {
+    switch (policy) {
+        case BoundPolicy::Atomic: return "atomic";
+        case BoundPolicy::Cached: return "cached";
+        case BoundPolicy::Epoch: return "epoch";
+        case BoundPolicy::NumaReplica: return "numa";
+    }
+    return "atomic";
+}
+
+inline bool parseBoundPolicy(const std::string& name, BoundPolicy& policy) {
+    if (name == "atomic") policy = BoundPolicy::Atomic;
+    else if (name == "cached") policy = BoundPolicy::Cached;
+    else if (name == "epoch") policy = BoundPolicy::Epoch;
+    else if (name == "numa") policy = BoundPolicy::NumaReplica;
+    else return false;
+    return true;
+}
+
+struct BoundPolicyStats {
+    long long checks = 0;      // Reads of the shared state (Cached / Epoch)
+    long long refreshes = 0;   // Checks that found a tighter bound
+    long long staleNodes = 0;  // Upper bound on nodes expanded with a stale bound
+
+    void add(const BoundPolicyStats& other) {
+        checks += other.checks;
+        refreshes += other.refreshes;
+        staleNodes += other.staleNodes;
+    }
+};
+
+// =============================================================================
+// NUMA TOPOLOGY - cpu -> domain from /sys/devices/system/node (Linux)
+// =============================================================================
+namespace bound_policy {
+
+struct NumaTopology {
+    std::vector<int> cpuDomain;  // Indexed by cpu id, -1 = unknown
+    int domains = 1;
+};
+
+// "0-3,8,10-11" -> {0,1,2,3,8,10,11}
+inline std::vector<int> parseCpuList(const std::string& list) {
+    std::vector<int> cpus;
+    std::istringstream iss(list);
+    std::string range;
+    while (std::getline(iss, range, ',')) {
+        if (range.empty()) continue;
+        const size_t dash = range.find('-');
+        const int first = std::atoi(range.c_str());
+        const int last = (dash == std::string::npos) ? first : std::atoi(range.c_str() + dash + 1);
+        for (int cpu = first; cpu <= last; ++cpu) {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+inline const NumaTopology& numaTopology() {
+    static const NumaTopology topology = []() {
+        NumaTopology t;
+        int domain = 0;
+        for (int node = 0; node < 1024; ++node) {
+            std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+            if (!file) break;  // Nodes are numbered contiguously in practice
+            std::string list;
+            std::getline(file, list);
+            for (int cpu : parseCpuList(list)) {
+                if (cpu >= static_cast<int>(t.cpuDomain.size())) {
+                    t.cpuDomain.resize(static_cast<size_t>(cpu) + 1, -1);
+                }
+                t.cpuDomain[static_cast<size_t>(cpu)] = domain;
+            }
+            ++domain;
+        }
+        t.domains = std::max(1, domain);
+        return t;
+    }();
+    return topology;
+}
+
+// Domain of the cpu the calling thread runs on (pin threads: OMP_PROC_BIND)
+inline int currentNumaDomain() {
+#if defined(__linux__)
+    const NumaTopology& t = numaTopology();
+    const int cpu = sched_getcpu();
+    if (cpu >= 0 && cpu < static_cast<int>(t.cpuDomain.size()) &&
+        t.cpuDomain[static_cast<size_t>(cpu)] >= 0) {
+        return t.cpuDomain[static_cast<size_t>(cpu)];
+    }
+#endif
+    return 0;
+}
+
+} // namespace bound_policy
+
+// =============================================================================
+// SHARED BOUND - Exclusive best length (maxLen + 1 = nothing found yet)
+// =============================================================================
+class SharedBound {
+private:
+    struct alignas(64) Replica {
+        std::atomic<int> value{0};
+    };
+
+    alignas(64) std::atomic<int> value_{0};
+    alignas(64) std::atomic<uint32_t> epoch_{0};
+    std::unique_ptr<Replica[]> replicas_;
+    int domains_ = 0;
+
+    static void lowerAtomic(std::atomic<int>& target, int length) {
+        int expected = target.load(std::memory_order_relaxed);
+        while (length < expected &&
+               !target.compare_exchange_weak(expected, length,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+    }
+
+public:
+    SharedBound() = default;
+    SharedBound(int initial, BoundPolicy policy) { init(initial, policy); }
+
+    SharedBound(const SharedBound&) = delete;
+    SharedBound& operator=(const SharedBound&) = delete;
+
+    // Not thread-safe: call before the parallel region
+    void init(int initial, BoundPolicy policy) {
+        value_.store(initial, std::memory_order_relaxed);
+        epoch_.store(0, std::memory_order_relaxed);
+        domains_ = (policy == BoundPolicy::NumaReplica) ? bound_policy::numaTopology().domains : 0;
+        replicas_.reset(domains_ > 0 ? new Replica[static_cast<size_t>(domains_)] : nullptr);
+        for (int d = 0; d < domains_; ++d) {
+            replicas_[static_cast<size_t>(d)].value.store(initial, std::memory_order_relaxed);
+        }
+    }
+
+    int load() const { return value_.load(std::memory_order_acquire); }
+    std::atomic<int>& value() { return value_; }
+
+    uint32_t epoch() const { return epoch_.load(std::memory_order_acquire); }
+
+    int domains() const { return domains_; }
+    // Replica of a domain (the atomic itself when there are no replicas)
+    std::atomic<int>& replica(int domain) {
+        if (domains_ == 0) return value_;
+        return replicas_[static_cast<size_t>(domain < domains_ ? domain : 0)].value;
+    }
+
+    // Lower the bound to `length` if smaller. True if this call lowered it.
+    bool lower(int length) {
+        int expected = value_.load(std::memory_order_relaxed);
+        while (length < expected &&
+               !value_.compare_exchange_weak(expected, length,
+                   std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        if (length >= expected) return false;
+
+        for (int d = 0; d < domains_; ++d) {
+            lowerAtomic(replicas_[static_cast<size_t>(d)].value, length);
+        }
+        epoch_.fetch_add(1, std::memory_order_release);
+        return true;
+    }
+};
+
+// =============================================================================
+// BOUND READERS - One per thread. Kernels call node() once per node,
+// candidate() per candidate position and improved() on their own solutions.
+// =============================================================================
+class AtomicBoundReader {
+private:
+    std::atomic<int>& value_;
+
+public:
+    explicit AtomicBoundReader(SharedBound& shared) : value_(shared.value()) {}
+
+    void begin() {}
+    inline int node() { return value_.load(std::memory_order_relaxed); }
+    inline int candidate() { return value_.load(std::memory_order_relaxed); }
+    inline void improved(int) {}
+    BoundPolicyStats stats() const { return BoundPolicyStats{}; }
+};
+
+class CachedBoundReader {
+private:
+    std::atomic<int>& value_;
+    int bound_;
+    int interval_;
+    int countdown_;
+    long long sinceCheck_ = 0;
+    BoundPolicyStats stats_;
+
+    void check() {
+        const int fresh = value_.load(std::memory_order_relaxed);
+        stats_.checks++;
+        if (fresh < bound_) {
+            stats_.refreshes++;
+            stats_.staleNodes += sinceCheck_;
+            bound_ = fresh;
+        }
+        sinceCheck_ = 0;
+        countdown_ = interval_;
+    }
+
+public:
+    CachedBoundReader(SharedBound& shared, int interval)
+        : value_(shared.value()), bound_(shared.load()),
+          interval_(interval > 0 ? interval : 1), countdown_(interval_) {}
+
+    // Start of a prefix: also re-read, a new subtree should start current
+    void begin() { check(); }
+
+    inline int node() {
+        if (--countdown_ <= 0) [[unlikely]] {
+            check();
+        }
+        ++sinceCheck_;
+        return bound_;
+    }
+    inline int candidate() { return bound_; }
+    inline void improved(int length) { bound_ = std::min(bound_, length); }
+    BoundPolicyStats stats() const { return stats_; }
+};
+
+class EpochBoundReader {
+private:
+    SharedBound& shared_;
+    uint32_t seen_;
+    int bound_;
+    BoundPolicyStats stats_;
+
+public:
+    explicit EpochBoundReader(SharedBound& shared)
+        : shared_(shared), seen_(shared.epoch()), bound_(shared.load()) {}
+
+    void begin() {}
+
+    // Checked every node: an improvement is seen by the next node, so no
+    // stale nodes are counted (only the candidates left in the current one).
+    // One check per node: the caller reports its node count with
+    // countChecks() instead of a counter increment on the hot path.
+    inline int node() {
+        const uint32_t epoch = shared_.epoch();
+        if (epoch != seen_) [[unlikely]] {
+            seen_ = epoch;
+            const int fresh = shared_.value().load(std::memory_order_relaxed);
+            if (fresh < bound_) {
+                stats_.refreshes++;
+                bound_ = fresh;
+            }
+        }
+        return bound_;
+    }
+    inline int candidate() { return bound_; }
+    inline void improved(int length) { bound_ = std::min(bound_, length); }
+    void countChecks(long long nodes) { stats_.checks += nodes; }
+    BoundPolicyStats stats() const { return stats_; }
+};
+
+class NumaBoundReader {
+private:
+    std::atomic<int>& replica_;
+
+public:
+    explicit NumaBoundReader(SharedBound& shared)
+        : replica_(shared.replica(bound_policy::currentNumaDomain())) {}
+
+    void begin() {}
+    inline int node() { return replica_.load(std::memory_order_relaxed); }
+    inline int candidate() { return replica_.load(std::memory_order_relaxed); }
+    inline void improved(int) {}
+    BoundPolicyStats stats() const { return BoundPolicyStats{}; }
+};
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+
+// =============================================================================
+// ENERGY METER - Package and DRAM energy from RAPL-style counters
+// =============================================================================
+// Sources, in order of preference:
+//   1. /sys/class/powercap/intel-rapl:*  (Intel, and AMD Zen with recent
+//      kernels): "package-N" and "dram" zones, energy_uj, wraps at
+//      max_energy_range_uj. Sub-zones "core"/"uncore" are inside the package
+//      and "psys" covers the platform, so they are skipped.
+//   2. /sys/class/hwmon/hwmon* named "amd_energy": Esocket* counters (uJ).
+//
+// energy_uj is often root-only. Unreadable or missing counters just make the
+// meter unavailable: readings are then invalid and the logs print NA.
+// Counters are per node: under MPI only one rank per node should report.
+//
+// energy_uj wraps at max_energy_range_uj (~262 kJ, i.e. every 15-20 minutes
+// on a busy package), so between start() and stop() a sampler thread reads
+// every counter each ENERGY_POLL_SECONDS and accumulates the deltas: one
+// wrap per poll interval at most, whatever the length of the run.
+// =============================================================================
+
+constexpr int ENERGY_POLL_SECONDS = 10;
+
+struct EnergyReading {
+    bool valid = false;
+    double packageJ = 0.0;  // Sum over CPU packages
+    double dramJ = 0.0;     // Sum over DRAM domains (0 when not exposed)
+
+    double totalJ() const { return packageJ + dramJ; }
+};
+
+class EnergyMeter {
+private:
+    struct Counter {
+        std::string path;     // File holding the cumulative energy in uJ
+        double rangeUj;       // Wrap-around range (0 = 64-bit, no wrap)
+        bool dram;
+        uint64_t lastUj;      // Value at the previous poll
+        double totalUj;       // Accumulated since start()
+        bool ok;              // Every read since start() succeeded
+    };
+
+    std::vector<Counter> counters_;
+    std::string source_ = "none";
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopSampler_ = false;
+    std::thread sampler_;
+
+    static bool readValue(const std::string& path, uint64_t& value) {
+        std::ifstream file(path);
+        return static_cast<bool>(file >> value);
+    }
+
+    static std::string readLine(const std::string& path) {
+        std::ifstream file(path);
+        std::string line;
+        std::getline(file, line);
+        return line;
+    }
+
+    void addCounter(const std::string& path, double rangeUj, bool dram) {
+        uint64_t value = 0;
+        if (readValue(path, value)) {
+            counters_.push_back(Counter{path, rangeUj, dram, value, 0.0, true});
+        }
+    }
+
+    void discoverPowercap() {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        for (fs::directory_iterator it("/sys/class/powercap", ec), end; !ec && it != end; it.increment(ec)) {
+            const std::string dir = it->path().string();
+            if (it->path().filename().string().rfind("intel-rapl:", 0) != 0) continue;
+
+            const std::string name = readLine(dir + "/name");
+            const bool package = name.rfind("package", 0) == 0;
+            const bool dram = (name == "dram");
+            if (!package && !dram) continue;
+
+            uint64_t range = 0;
+            readValue(dir + "/max_energy_range_uj", range);
+            addCounter(dir + "/energy_uj", static_cast<double>(range), dram);
+        }
+        if (!counters_.empty()) source_ = "intel-rapl";
+    }
+
+    void discoverAmdEnergy() {
+        namespace fs = std::filesystem;
+        std::error_code ec;
+        for (fs::directory_iterator it("/sys/class/hwmon", ec), end; !ec && it != end; it.increment(ec)) {
+            const std::string dir = it->path().string();
+            if (readLine(dir + "/name") != "amd_energy") continue;
+
+            for (int i = 1; i <= 1024; ++i) {
+                const std::string base = dir + "/energy" + std::to_string(i);
+                const std::string label = readLine(base + "_label");
+                if (label.empty()) break;
+                if (label.rfind("Esocket", 0) == 0) {
+                    addCounter(base + "_input", 0.0, false);
+                }
+            }
+        }
+        if (!counters_.empty()) source_ = "amd_energy";
+    }
+
+public:
+    EnergyMeter() {
+        discoverPowercap();
+        if (counters_.empty()) {
+            discoverAmdEnergy();
+        }
+    }
+
+    bool available() const { return !counters_.empty(); }
+    const std::string& source() const { return source_; }
+
+    ~EnergyMeter() { stopSampler(); }
+
+    EnergyMeter(const EnergyMeter&) = delete;
+    EnergyMeter& operator=(const EnergyMeter&) = delete;
+
+    void start() {
+        stopSampler();
+        for (Counter& c : counters_) {
+            c.totalUj = 0.0;
+            c.ok = readValue(c.path, c.lastUj);
+        }
+        if (counters_.empty()) return;
+
+        stopSampler_ = false;
+        sampler_ = std::thread([this] {
+            std::unique_lock<std::mutex> lock(mutex_);
+            while (!cv_.wait_for(lock, std::chrono::seconds(ENERGY_POLL_SECONDS), [this] { return stopSampler_; })) {
+                poll();
+            }
+        });
+    }
+
+    // Energy since the last start()
+    EnergyReading stop() {
+        EnergyReading reading;
+        if (counters_.empty()) return reading;
+
+        stopSampler();
+        poll();
+        reading.valid = true;
+        for (const Counter& c : counters_) {
+            if (!c.ok) {
+                reading.valid = false;
+                continue;
+            }
+            (c.dram ? reading.dramJ : reading.packageJ) += c.totalUj * 1e-6;
+        }
+        return reading;
+    }
+
+private:
+    // Adds each counter's delta since the previous poll
+    void poll() {
+        for (Counter& c : counters_) {
+            uint64_t now = 0;
+            if (!c.ok || !readValue(c.path, now)) {
+                c.ok = false;
+                continue;
+            }
+            double delta = static_cast<double>(now) - static_cast<double>(c.lastUj);
+            if (delta < 0.0) {
+                if (c.rangeUj <= 0.0) {
+                    c.ok = false;  // Went backwards without a known range: no valid total
+                    continue;
+                }
+                delta += c.rangeUj;  // Wrapped since the previous poll
+            }
+            c.totalUj += delta;
+            c.lastUj = now;
+        }
+    }
+
+    void stopSampler() {
+        if (!sampler_.joinable()) return;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopSampler_ = true;
+        }
+        cv_.notify_one();
+        sampler_.join();
+    }
+};
@@ -0,0 +1,31 @@
+#pragma once
+
+#include <mpi.h>
+#include "energy_meter.hpp"
+
+// =============================================================================
+// JOB ENERGY - RAPL counters are per node: only node-local rank 0 reports
+// =============================================================================
+// Every rank passes its own reading; nodeComm comes from
+// MPI_Comm_split_type(MPI_COMM_SHARED). The sum lands on rank 0 of
+// MPI_COMM_WORLD and is invalid if any reporting rank had no counters.
+// =============================================================================
+inline EnergyReading reduceEnergy(const EnergyReading& local, MPI_Comm nodeComm) {
+    int nodeRank;
+    MPI_Comm_rank(nodeComm, &nodeRank);
+
+    const bool reporter = (nodeRank == 0);
+    double values[2] = { reporter ? local.packageJ : 0.0, reporter ? local.dramJ : 0.0 };
+    int valid = (!reporter || local.valid) ? 1 : 0;
+
+    double sums[2] = {0.0, 0.0};
+    int allValid = 0;
+    MPI_Reduce(values, sums, 2, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&valid, &allValid, 1, MPI_INT, MPI_MIN, 0, MPI_COMM_WORLD);
+
+    EnergyReading total;
+    total.valid = (allValid == 1);
+    total.packageJ = sums[0];
+    total.dramJ = sums[1];
+    return total;
+}
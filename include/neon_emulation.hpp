@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+
+// =============================================================================
+// NEON EMULATION - The intrinsics used by Bits128Neon, in plain C++
+// =============================================================================
+// Included by simd_bitset.hpp when -DGOLOMB_SIMD_NEON is given on a target
+// without NEON: the NEON backend then builds and runs on x86 (make
+// neon-check), so it cannot rot between ARM runs. Lane semantics follow the
+// ARM definitions; only the operations Bits128Neon needs are provided.
+// =============================================================================
+
+struct uint64x1_t {
+    uint64_t val;
+};
+
+struct uint64x2_t {
+    uint64_t val[2];
+};
+
+struct int64x2_t {
+    int64_t val[2];
+};
+
+inline uint64x1_t vcreate_u64(uint64_t a) { return uint64x1_t{a}; }
+inline uint64x2_t vcombine_u64(uint64x1_t lo, uint64x1_t hi) { return uint64x2_t{{lo.val, hi.val}}; }
+inline uint64x2_t vdupq_n_u64(uint64_t a) { return uint64x2_t{{a, a}}; }
+inline int64x2_t vdupq_n_s64(int64_t a) { return int64x2_t{{a, a}}; }
+inline uint64_t vgetq_lane_u64(uint64x2_t a, int lane) { return a.val[lane]; }
+
+// EXT: lanes n.. of a followed by lanes of b
+inline uint64x2_t vextq_u64(uint64x2_t a, uint64x2_t b, int n) {
+    return n == 0 ? a : uint64x2_t{{a.val[1], b.val[0]}};
+}
+
+// USHL: signed count per lane, negative shifts right, |count| >= 64 gives zero
+inline uint64_t ushl64(uint64_t x, int64_t count) {
+    if (count >= 64 || count <= -64) return 0;
+    return count >= 0 ? x << count : x >> -count;
+}
+
+inline uint64x2_t vshlq_u64(uint64x2_t a, int64x2_t count) {
+    return uint64x2_t{{ushl64(a.val[0], count.val[0]), ushl64(a.val[1], count.val[1])}};
+}
+
+inline uint64x2_t vandq_u64(uint64x2_t a, uint64x2_t b) {
+    return uint64x2_t{{a.val[0] & b.val[0], a.val[1] & b.val[1]}};
+}
+inline uint64x2_t vorrq_u64(uint64x2_t a, uint64x2_t b) {
+    return uint64x2_t{{a.val[0] | b.val[0], a.val[1] | b.val[1]}};
+}
+inline uint64x2_t veorq_u64(uint64x2_t a, uint64x2_t b) {
+    return uint64x2_t{{a.val[0] ^ b.val[0], a.val[1] ^ b.val[1]}};
+}
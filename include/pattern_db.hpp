@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define GOLOMB_PDB_MMAP 1
+#endif
+
+// =============================================================================
+// PATTERN DATABASE - Exact span of r more marks given the small used distances
+// =============================================================================
+// The r(r+1)/2 bound of the kernels ignores used_dist, yet near the leaves
+// most small distances are taken and the remaining marks cannot pack tightly.
+//
+// The r marks after the last one form, with it, a Golomb ruler of r + 1 marks
+// from 0 whose distances avoid used_dist. Keeping only distances 1..k of
+// used_dist (bits 1..k, the low word) gives a lower bound that depends on r
+// and k bits alone:
+//   span(r, mask) = min length of an (r+1)-mark Golomb ruler with no
+//                   distance d <= k whose bit d - 1 is set in mask
+// exact for that relaxation, and >= r(r+1)/2 (mask = 0). Distances to the
+// older marks and distances above k are ignored, so it stays a lower bound.
+//
+// Table: rows r = 0..R of 2^k bytes (k = 16, R = 5: 384 KB, L2-resident),
+// one lookup per node. Above R the kernels use max(r(r+1)/2, span(R, mask)):
+// the first R of the remaining marks already need span(R, mask).
+//
+// Generation (golomb_pdb, or on first use): for each r, the shortest ruler
+// with all distances > k gives the span of the full mask, S0. Every
+// (r+1)-mark ruler shorter than S0 is enumerated once (parallel over the
+// first gap) and keeps the shortest length per signature sig (its distances
+// <= k). span(r, mask) = min over sig with sig & mask = 0, a subset-min
+// (sum over subsets) transform over the complement: k 2^k steps.
+//
+// File: 32-byte header (magic, k, R, payload checksum) then the rows,
+// memory-mapped read-only, shared by all threads and processes.
+// =============================================================================
+
+constexpr int PDB_MIN_BITS = 4;
+constexpr int PDB_MAX_BITS = 24;
+constexpr int PDB_MAX_MARKS = 8;
+constexpr int PDB_DEFAULT_BITS = 16;
+constexpr int PDB_DEFAULT_MARKS = 5;
+
+class PatternDB {
+private:
+    struct Header {
+        char magic[8];        // "GOLPDB1\0"
+        uint32_t bits;        // k
+        uint32_t maxMarks;    // R
+        uint64_t checksum;    // FNV-1a of the rows
+        uint64_t reserved;
+    };
+    static_assert(sizeof(Header) == 32, "pattern database header is 32 bytes");
+
+    int bits_ = 0;
+    int maxMarks_ = 0;
+    uint32_t mask_ = 0;
+    const uint8_t* rows_ = nullptr;
+    std::vector<uint8_t> owned_;   // Built in memory or read without mmap
+    void* map_ = nullptr;
+    size_t mapSize_ = 0;
+
+    static uint64_t checksum(const uint8_t* data, size_t size) {
+        uint64_t h = 0xCBF29CE484222325ULL;
+        for (size_t i = 0; i < size; ++i) {
+            h = (h ^ data[i]) * 0x100000001B3ULL;
+        }
+        return h;
+    }
+
+    size_t rowsSize() const {
+        return (static_cast<size_t>(maxMarks_) + 1) << bits_;
+    }
+
+    void unmap() {
+#ifdef GOLOMB_PDB_MMAP
+        if (map_) munmap(map_, mapSize_);
+#endif
+        map_ = nullptr;
+        mapSize_ = 0;
+    }
+
+    // ------------------------------------------------------------------------
+    // Generation
+    // ------------------------------------------------------------------------
+    struct Enumerator {
+        int marks;        // r + 1
+        int bits;
+        int cap;          // Longest span enumerated
+        int ruler[PDB_MAX_MARKS + 1];
+        uint64_t used[4]; // Distances up to 255
+        uint8_t* best;    // Per signature (nullptr: search the shortest, sig must be 0)
+        int shortest;
+
+        bool isUsed(int d) const { return (used[d >> 6] >> (d & 63)) & 1; }
+        void flip(int d) { used[d >> 6] ^= 1ULL << (d & 63); }
+
+        void dfs(int count, uint32_t sig) {
+            const int last = ruler[count - 1];
+            // count > PDB_MAX_MARKS never happens (marks <= PDB_MAX_MARKS + 1),
+            // it only bounds the recursion for the compiler
+            if (count == marks || count > PDB_MAX_MARKS) {
+                if (best) {
+                    best[sig] = std::min<int>(best[sig], last);
+                } else {
+                    shortest = std::min(shortest, last);
+                }
+                return;
+            }
+            const int r = marks - count;  // Marks still to place, this one included
+            const int limit = best ? cap : shortest - 1;
+            for (int pos = last + 1; pos + ((r - 1) * r) / 2 <= limit; ++pos) {
+                uint32_t newSig = sig;
+                bool ok = true;
+                for (int i = 0; i < count; ++i) {
+                    const int d = pos - ruler[i];
+                    if (isUsed(d) || (!best && d <= bits)) {
+                        ok = false;
+                        break;
+                    }
+                    if (d <= bits) newSig |= 1u << (d - 1);
+                }
+                if (!ok) continue;
+                for (int i = 0; i < count; ++i) flip(pos - ruler[i]);
+                ruler[count] = pos;
+                dfs(count + 1, newSig);
+                for (int i = 0; i < count; ++i) flip(pos - ruler[i]);
+                if (!best && pos + ((r - 1) * r) / 2 > shortest - 1) break;
+            }
+        }
+    };
+
+    // Shortest (r+1)-mark ruler with every distance > bits
+    static int shortestAvoiding(int r, int bits) {
+        Enumerator e{};
+        e.marks = r + 1;
+        e.bits = bits;
+        e.best = nullptr;
+        e.shortest = 256;
+        e.ruler[0] = 0;
+        e.dfs(1, 0);
+        return e.shortest;
+    }
+
+    // Row r: span(r, mask) for every mask; false if a span exceeds 255
+    static bool buildRow(int r, int bits, uint8_t* row) {
+        const size_t size = size_t(1) << bits;
+        if (r == 0) {
+            std::fill(row, row + size, uint8_t(0));
+            return true;
+        }
+        const int full = shortestAvoiding(r, bits);
+        if (full > 255) return false;
+
+        // Shortest length per exact signature, rulers shorter than `full`
+        std::vector<uint8_t> best(size, static_cast<uint8_t>(full));
+        const int cap = full - 1;
+        const int maxFirst = cap - ((r - 1) * r) / 2;
+
+#ifdef _OPENMP
+        #pragma omp parallel
+#endif
+        {
+            std::vector<uint8_t> local(size, static_cast<uint8_t>(full));
+            Enumerator e{};
+            e.marks = r + 1;
+            e.bits = bits;
+            e.cap = cap;
+            e.best = local.data();
+            e.ruler[0] = 0;
+
+#ifdef _OPENMP
+            #pragma omp for schedule(dynamic, 1)
+#endif
+            for (int first = 1; first <= maxFirst; ++first) {
+                e.ruler[1] = first;
+                e.flip(first);
+                e.dfs(2, first <= bits ? (1u << (first - 1)) : 0u);
+                e.flip(first);
+            }
+
+#ifdef _OPENMP
+            #pragma omp critical(pattern_db_merge)
+#endif
+            {
+                for (size_t s = 0; s < size; ++s) best[s] = std::min(best[s], local[s]);
+            }
+        }
+
+        // Subset-min: best[S] = min over signatures included in S
+        for (int b = 0; b < bits; ++b) {
+            const size_t bit = size_t(1) << b;
+            for (size_t s = 0; s < size; ++s) {
+                if (s & bit) best[s] = std::min(best[s], best[s ^ bit]);
+            }
+        }
+        const size_t all = size - 1;
+        for (size_t mask = 0; mask < size; ++mask) {
+            row[mask] = best[all & ~mask];
+        }
+        return true;
+    }
+
+public:
+    PatternDB() = default;
+    ~PatternDB() { unmap(); }
+    PatternDB(const PatternDB&) = delete;
+    PatternDB& operator=(const PatternDB&) = delete;
+
+    bool valid() const { return rows_ != nullptr; }
+    int bits() const { return bits_; }
+    int maxMarks() const { return maxMarks_; }
+    size_t bytes() const { return valid() ? rowsSize() : 0; }
+
+    static std::string defaultPath(int bits, int maxMarks) {
+        return "pdb/golomb_pdb_k" + std::to_string(bits) + "_r" + std::to_string(maxMarks) + ".bin";
+    }
+
+    // One lookup: bits 1..k of used_dist (low word)
+    inline int minSpan(int r, uint64_t used_lo) const {
+        const size_t index = static_cast<size_t>((used_lo >> 1) & mask_);
+        if (r <= maxMarks_) {
+            return rows_[(static_cast<size_t>(r) << bits_) | index];
+        }
+        const int triangular = (r * (r + 1)) / 2;
+        const int span = rows_[(static_cast<size_t>(maxMarks_) << bits_) | index];
+        return std::max(triangular, span);
+    }
+
+    // In memory, OpenMP-parallel when compiled with -fopenmp
+    bool build(int bits, int maxMarks) {
+        if (bits < PDB_MIN_BITS || bits > PDB_MAX_BITS || maxMarks < 1 || maxMarks > PDB_MAX_MARKS) {
+            return false;
+        }
+        unmap();
+        bits_ = bits;
+        maxMarks_ = maxMarks;
+        mask_ = (1u << bits) - 1;
+        owned_.assign(rowsSize(), 0);
+        for (int r = 0; r <= maxMarks; ++r) {
+            if (!buildRow(r, bits, owned_.data() + (static_cast<size_t>(r) << bits))) {
+                owned_.clear();
+                rows_ = nullptr;
+                return false;
+            }
+        }
+        rows_ = owned_.data();
+        return true;
+    }
+
+    bool save(const std::string& path) const {
+        if (!valid()) return false;
+        const std::filesystem::path p(path);
+        if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+
+        Header header{};
+        std::memcpy(header.magic, "GOLPDB1", 8);
+        header.bits = static_cast<uint32_t>(bits_);
+        header.maxMarks = static_cast<uint32_t>(maxMarks_);
+        header.checksum = checksum(rows_, rowsSize());
+
+        // Write then rename: concurrent first runs never map a partial file
+        const std::string tmp = path + ".tmp";
+        FILE* file = std::fopen(tmp.c_str(), "wb");
+        if (!file) return false;
+        const bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                        std::fwrite(rows_, 1, rowsSize(), file) == rowsSize();
+        if (std::fclose(file) != 0 || !ok) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        std::error_code ec;
+        std::filesystem::rename(tmp, path, ec);
+        return !ec;
+    }
+
+    // Memory-mapped (read into memory where mmap is not available)
+    bool load(const std::string& path) {
+        unmap();
+        owned_.clear();
+        rows_ = nullptr;
+
+        Header header{};
+        size_t fileSize = 0;
+#ifdef GOLOMB_PDB_MMAP
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st{};
+        if (fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(Header))) {
+            ::close(fd);
+            return false;
+        }
+        fileSize = static_cast<size_t>(st.st_size);
+        void* map = mmap(nullptr, fileSize, PROT_READ, MAP_SHARED, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) return false;
+        map_ = map;
+        mapSize_ = fileSize;
+        std::memcpy(&header, map, sizeof(header));
+        const uint8_t* payload = static_cast<const uint8_t*>(map) + sizeof(Header);
+#else
+        FILE* file = std::fopen(path.c_str(), "rb");
+        if (!file) return false;
+        if (std::fread(&header, sizeof(header), 1, file) != 1) {
+            std::fclose(file);
+            return false;
+        }
+        std::vector<uint8_t> data;
+        uint8_t chunk[65536];
+        size_t got = 0;
+        while ((got = std::fread(chunk, 1, sizeof(chunk), file)) > 0) {
+            data.insert(data.end(), chunk, chunk + got);
+        }
+        std::fclose(file);
+        fileSize = sizeof(Header) + data.size();
+        owned_.swap(data);
+        const uint8_t* payload = owned_.data();
+#endif
+        const bool headerOk = std::memcmp(header.magic, "GOLPDB1", 8) == 0 &&
+                              header.bits >= PDB_MIN_BITS && header.bits <= PDB_MAX_BITS &&
+                              header.maxMarks >= 1 && header.maxMarks <= PDB_MAX_MARKS;
+        if (headerOk) {
+            bits_ = static_cast<int>(header.bits);
+            maxMarks_ = static_cast<int>(header.maxMarks);
+        }
+        if (!headerOk || fileSize != sizeof(Header) + rowsSize() ||
+            checksum(payload, rowsSize()) != header.checksum) {
+            unmap();
+            owned_.clear();
+            return false;
+        }
+        mask_ = (1u << bits_) - 1;
+        rows_ = payload;
+        return true;
+    }
+
+    // Load the file, or build it and save it there (first run)
+    bool open(const std::string& path, int bits, int maxMarks, bool* built = nullptr) {
+        if (built) *built = false;
+        if (load(path) && bits_ == bits && maxMarks_ == maxMarks) return true;
+        if (!build(bits, maxMarks)) return false;
+        if (built) *built = true;
+        save(path);  // A read-only directory only costs the rebuild next time
+        return true;
+    }
+};
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// PREFIX DIGESTS - Per-prefix fingerprint of a deterministic search (audit)
+// =============================================================================
+// In deterministic mode every node has a visit threshold, and the nodes with
+// a threshold <= the final length are visited by any run (see search_v5.cpp).
+// The digest of a prefix is the number of those nodes and the sum of a 64-bit
+// hash of each of them: independent of thread count, timing and visit order,
+// so re-executing a prefix anywhere must reproduce it exactly. A mismatch
+// means a node was lost or corrupted by one of the two executions.
+//
+// File (written by golomb_openmp_v5 --digest-out, checked by audit-check):
+//   # golomb-digests n=<n> maxLen=<maxLen> depth=<depth> key=<final bound key>
+//   index,thread,nodes,hash
+// =============================================================================
+
+struct PrefixDigest {
+    int index = 0;           // Position in the generated prefix set
+    int thread = -1;         // Thread that produced it (re-execution avoids it)
+    long long nodes = 0;     // Nodes with threshold <= final length
+    uint64_t hash = 0;       // Sum of their node hashes
+};
+
+struct DigestFileHeader {
+    int n = 0;
+    int maxLen = 0;
+    int prefixDepth = 0;
+    uint64_t boundKey = 0;   // Final deterministic bound key of the recorded run
+};
+
+inline bool writePrefixDigests(const std::string& path, const DigestFileHeader& header,
+                               const std::vector<PrefixDigest>& digests) {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "# golomb-digests n=" << header.n << " maxLen=" << header.maxLen
+         << " depth=" << header.prefixDepth << " key=" << header.boundKey << "\n";
+    file << "index,thread,nodes,hash\n";
+    for (const PrefixDigest& d : digests) {
+        file << d.index << "," << d.thread << "," << d.nodes << "," << d.hash << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+inline bool readPrefixDigests(const std::string& path, DigestFileHeader& header,
+                              std::vector<PrefixDigest>& digests) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    digests.clear();
+    bool haveHeader = false;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("# golomb-digests", 0) == 0) {
+            std::istringstream iss(line.substr(16));
+            std::string field;
+            while (iss >> field) {
+                const size_t eq = field.find('=');
+                if (eq == std::string::npos) continue;
+                const std::string key = field.substr(0, eq);
+                const char* value = field.c_str() + eq + 1;
+                if (key == "n") header.n = std::atoi(value);
+                else if (key == "maxLen") header.maxLen = std::atoi(value);
+                else if (key == "depth") header.prefixDepth = std::atoi(value);
+                else if (key == "key") header.boundKey = std::strtoull(value, nullptr, 10);
+            }
+            haveHeader = true;
+            continue;
+        }
+        if (line.empty() || line[0] < '0' || line[0] > '9') continue;  // column names
+
+        std::istringstream iss(line);
+        PrefixDigest d;
+        char sep;
+        if (iss >> d.index >> sep >> d.thread >> sep >> d.nodes >> sep >> d.hash) {
+            digests.push_back(d);
+        }
+    }
+    return haveHeader;
+}
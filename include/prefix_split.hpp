@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// =============================================================================
+// ADAPTIVE PREFIX SPLITTING - Variable-depth prefixes driven by subtree cost
+// =============================================================================
+// The fixed-depth generators expand every branch to the same depth: cheap
+// branches become tiny tasks while a few huge subtrees stay monolithic and
+// dominate the tail of the run.
+//
+// This splitter expands a node only while its estimated subtree size is above
+// a target task size. Subtree size is estimated with Knuth's random-probe
+// estimator (random dives, product of branching factors). The RNG is seeded
+// from the node itself so every MPI rank generates the same prefix set.
+//
+// Prefixes are emitted in DFS order (increasing positions), exactly like the
+// fixed-depth generators, so the output is a drop-in replacement for the
+// prefix vectors consumed by the OpenMP and MPI drivers.
+//
+// Requirements on BitSet: operator<<, operator&, operator^, set(), any(),
+// and public lo/hi words. WorkItem: reversed_marks, used_dist, marks_count,
+// ruler_length.
+// =============================================================================
+
+struct PrefixSplitConfig {
+    int n;              // Target number of marks
+    int maxLen;         // Exclusive bound used for pruning (globalBestLen)
+    int maxDepth;       // Never split below this number of marks
+    int probes;         // Random dives per estimate
+    double targetCost;  // Stop splitting once estimate <= targetCost
+};
+
+namespace prefix_split {
+
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Valid children of a node (same pruning as generatePrefixes / kernels)
+template <typename BitSet>
+inline int collectChildren(const BitSet& reversed_marks, const BitSet& used_dist,
+                           int marks_count, int ruler_length,
+                           int n, int maxLen, int* children) {
+    const int remaining = n - marks_count;
+    const int min_additional = (remaining * (remaining + 1)) / 2;
+    if (ruler_length + min_additional >= maxLen) {
+        return 0;
+    }
+
+    const int max_remaining = ((remaining - 1) * remaining) / 2;
+    const int max_pos = maxLen - max_remaining - 1;
+
+    int count = 0;
+    for (int pos = ruler_length + 1; pos <= max_pos; ++pos) {
+        BitSet new_dist = reversed_marks << (pos - ruler_length);
+        if (!(new_dist & used_dist).any()) {
+            children[count++] = pos;
+        }
+    }
+    return count;
+}
+
+// Knuth estimator: average over random dives of 1 + c1 + c1*c2 + ...
+template <typename BitSet>
+inline double estimateSubtree(BitSet reversed_marks, BitSet used_dist,
+                              int marks_count, int ruler_length,
+                              const PrefixSplitConfig& config) {
+    uint64_t seed = reversed_marks.lo() ^ (reversed_marks.hi() * 0xD6E8FEB86659FD93ULL)
+                  ^ (static_cast<uint64_t>(ruler_length) << 32)
+                  ^ static_cast<uint64_t>(marks_count);
+
+    int children[256];
+    double total = 0.0;
+
+    for (int p = 0; p < config.probes; ++p) {
+        BitSet rm = reversed_marks;
+        BitSet ud = used_dist;
+        int count = marks_count;
+        int length = ruler_length;
+        double weight = 1.0;
+        double estimate = 1.0;
+
+        while (count < config.n) {
+            const int c = collectChildren(rm, ud, count, length,
+                                          config.n, config.maxLen, children);
+            if (c == 0) break;
+
+            weight *= c;
+            estimate += weight;
+
+            const int pos = children[splitmix64(seed) % static_cast<uint64_t>(c)];
+            const int offset = pos - length;
+            BitSet new_dist = rm << offset;
+            ud = ud ^ new_dist;
+            rm = new_dist;
+            rm.set(0);
+            length = pos;
+            count++;
+        }
+        total += estimate;
+    }
+
+    return total / config.probes;
+}
+
+template <typename BitSet, typename WorkItem>
+inline void split(BitSet reversed_marks, BitSet used_dist,
+                  int marks_count, int ruler_length,
+                  const PrefixSplitConfig& config,
+                  std::vector<WorkItem>& prefixes) {
+    bool leaf = marks_count >= config.maxDepth;
+    if (!leaf && marks_count >= 2) {
+        leaf = estimateSubtree(reversed_marks, used_dist, marks_count,
+                               ruler_length, config) <= config.targetCost;
+    }
+
+    if (leaf) {
+        WorkItem item;
+        item.reversed_marks = reversed_marks;
+        item.used_dist = used_dist;
+        item.marks_count = marks_count;
+        item.ruler_length = ruler_length;
+        prefixes.push_back(item);
+        return;
+    }
+
+    int children[256];
+    const int c = collectChildren(reversed_marks, used_dist, marks_count,
+                                  ruler_length, config.n, config.maxLen, children);
+
+    for (int i = 0; i < c; ++i) {
+        const int pos = children[i];
+        BitSet new_dist = reversed_marks << (pos - ruler_length);
+        BitSet new_reversed = new_dist;
+        new_reversed.set(0);
+        split(new_reversed, used_dist ^ new_dist, marks_count + 1, pos,
+              config, prefixes);
+    }
+}
+
+} // namespace prefix_split
+
+// =============================================================================
+// Generate a mixed-depth prefix set from the root {0}.
+// totalWorkers * tasksPerWorker is the number of tasks we aim for.
+// forbidden: distances that start out as used (constrained searches).
+// =============================================================================
+template <typename BitSet, typename WorkItem>
+inline void generatePrefixesAdaptive(int n, int maxLen, int totalWorkers,
+                                     int tasksPerWorker, int probes,
+                                     std::vector<WorkItem>& prefixes,
+                                     const BitSet& forbidden = BitSet()) {
+    BitSet reversed_marks;
+    BitSet used_dist = forbidden;
+    reversed_marks.set(0);
+
+    PrefixSplitConfig config;
+    config.n = n;
+    config.maxLen = maxLen;
+    config.maxDepth = (n > 4) ? n - 3 : (n > 1 ? n - 1 : 1);
+    config.probes = probes > 0 ? probes : 1;
+    config.targetCost = 0.0;
+
+    const double rootCost = prefix_split::estimateSubtree(reversed_marks, used_dist,
+                                                          1, 0, config);
+    const double tasks = static_cast<double>(totalWorkers) * tasksPerWorker;
+    config.targetCost = rootCost / (tasks > 1.0 ? tasks : 1.0);
+
+    prefix_split::split(reversed_marks, used_dist, 1, 0, config, prefixes);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <iomanip>
+
+// =============================================================================
+// PREFIX COST TRACE - Per-prefix work recorded by V5 / MPI V3
+// =============================================================================
+// One row per prefix, in generation (DFS) order. Written by the engines'
+// drivers (--trace=FILE) and read by the offline scheduler simulator
+// (main_schedsim.cpp).
+//
+// CSV: index,depth,ruler_length,nodes,time_s
+// =============================================================================
+
+struct PrefixCost {
+    int index = 0;         // Position in the generated prefix set
+    int depth = 0;         // marks_count of the prefix
+    int ruler_length = 0;
+    long long nodes = 0;   // Nodes explored in the prefix subtree
+    double time = 0.0;     // Wall time of the prefix (seconds)
+};
+
+inline bool writePrefixTrace(const std::string& path, const std::vector<PrefixCost>& costs) {
+    std::ofstream file(path);
+    if (!file) return false;
+
+    file << "index,depth,ruler_length,nodes,time_s\n";
+    file << std::setprecision(9);
+    for (const PrefixCost& c : costs) {
+        file << c.index << "," << c.depth << "," << c.ruler_length << ","
+             << c.nodes << "," << c.time << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+inline bool readPrefixTrace(const std::string& path, std::vector<PrefixCost>& costs) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    costs.clear();
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] < '0' || line[0] > '9') continue;  // header
+
+        std::istringstream iss(line);
+        PrefixCost c;
+        char sep;
+        if (iss >> c.index >> sep >> c.depth >> sep >> c.ruler_length >> sep
+                >> c.nodes >> sep >> c.time) {
+            costs.push_back(c);
+        }
+    }
+    return true;
+}
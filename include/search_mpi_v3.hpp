@@ -1,12 +1,15 @@
 #pragma once
 
 #include "golomb.hpp"
+#include "bound_policy.hpp"
+#include "prefix_trace.hpp"
+#include <vector>
 
 // =============================================================================
 // GOLOMB RULER SEARCH - MPI V3 (NO HYPERCUBE, STANDARD MPI_ALLREDUCE)
 // =============================================================================
 // Based on V5 OpenMP optimizations:
-//   - BitSet128 (2x uint64_t) for collision detection
+//   - BitSet128 (simd_bitset.hpp: SSE / NEON) for collision detection
 //   - reversed_marks encoding: shift computes all differences in O(1)
 //   - Prefix generation for better load balancing
 //   - Standard MPI_Allreduce for bound synchronization (simpler, no power-of-2)
@@ -17,5 +20,43 @@
 //   - May have slightly higher communication overhead for large P
 // =============================================================================
 
-void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best);
+// Longest bound the 2x uint64_t distance set supports; longer bounds are clamped
+constexpr int MAX_LEN_MPI_V3 = 127;
+
+struct SearchOptionsMPI_V3 {
+    // Variable-depth prefixes sized by estimated subtree cost (see
+    // prefix_split.hpp) instead of a fixed prefix depth
+    bool adaptiveSplit = false;
+    // Lexicographically smallest optimal ruler and a node count independent
+    // of ranks, threads and timing (fixed-depth split, adaptiveSplit ignored)
+    bool deterministic = false;
+    bool recordPrefixCosts = false;               // Fill getPrefixTraceMPI_V3() (complete on rank 0)
+    // How threads of a rank read the rank's bound (bound_policy.hpp); the
+    // deterministic kernel keeps its key
+    BoundPolicy boundPolicy = BoundPolicy::Atomic;
+    int boundRefresh = DEFAULT_BOUND_REFRESH;     // Cached: nodes between two reads
+};
+
+void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best,
+                        const SearchOptionsMPI_V3& options = SearchOptionsMPI_V3{});
 long long getExploredCountMPI_V3();
+// Deterministic mode: nodes visited under the final bound (same on all ranks)
+long long getDeterministicCountMPI_V3();
+
+// Per-prefix cost trace of the last search (recordPrefixCosts)
+const std::vector<PrefixCost>& getPrefixTraceMPI_V3();
+
+// Bound policy stats of the last search, summed on rank 0
+const BoundPolicyStats& getBoundPolicyStatsMPI_V3();
+
+// One improvement of the global bound by a solution (seconds since the
+// search started on the finding rank, MPI_Wtime)
+struct BoundEventMPI_V3 {
+    double time;
+    int length;
+    int rank;
+};
+
+// Bound timeline, merged by time on rank 0 after the search (only events
+// that lowered the bound across all ranks); empty in deterministic mode
+const std::vector<BoundEventMPI_V3>& getBoundTimelineMPI_V3();
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "golomb.hpp"
+#include <vector>
+
+// =============================================================================
+// SEARCH NEAR - Near-Golomb rulers: up to k repeated distances (OpenMP)
+// =============================================================================
+// A near-Golomb ruler with excess k: sum over distances d of (mult(d) - 1)
+// <= k, where mult(d) is the number of mark pairs at distance d. k = 0 is a
+// Golomb ruler. Optionally no distance may occur more than maxRepeat times.
+//
+// Distance multiplicities are stacked bitplanes of the 128-bit set of V5,
+// plane j = distances seen more than j times (thermometer code). The new
+// distances of a mark are still one shift of reversed_marks (all distinct),
+// and adding them is a bit-parallel saturating increment:
+//   plane[j] |= new_dist & plane[j - 1]   (top plane first), plane[0] |= new_dist
+//   excess   += popcount(new_dist & plane[0])
+// One plane is enough for the excess alone; a binding maxRepeat m needs m
+// planes and rejects candidates with (new_dist & plane[m - 1]).any().
+//
+// Pruning: r more marks add r gaps, of which at most e (excess left) repeat
+// a value, so at least u = max(r - e, 1) distinct gaps: the span still needed
+// is u(u+1)/2 + (r - u), r(r+1)/2 when e = 0 as in the Golomb kernels.
+//
+// Parallelism as searchGolombV5: fixed-depth prefixes explored with
+// schedule(dynamic, 1), iterative kernel, shared atomic bound.
+// =============================================================================
+
+constexpr int MAX_MARKS_NEAR = 24;
+constexpr int MAX_LEN_NEAR = 127;
+constexpr int MAX_REPEAT_NEAR = 4;   // Bitplanes for a binding maxRepeat
+
+struct NearOptions {
+    int excess = 1;       // k: total repeated distances allowed
+    int maxRepeat = 0;    // Max multiplicity of one distance (0 = k + 1, no cap)
+    int prefixDepth = 0;  // 0 = auto
+};
+
+struct NearStats {
+    long long explored = 0;
+    int prefixCount = 0;
+    int prefixDepth = 0;
+    int planes = 0;       // Bitplanes used by the kernel
+};
+
+// Shortest near-Golomb ruler of length <= maxLen. Returns false if none.
+bool searchNearGolomb(int n, int maxLen, const NearOptions& options,
+                      GolombRuler& best, NearStats& stats);
+
+// Excess of a ruler (sum of mult(d) - 1) and its largest multiplicity
+int nearRulerExcess(const std::vector<int>& marks, int* maxMultiplicity = nullptr);
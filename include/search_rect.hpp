@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// =============================================================================
+// SEARCH RECT - Golomb rectangles and Costas arrays (2-D distinct differences)
+// =============================================================================
+// N points in a width x height grid, all difference vectors distinct.
+//
+// 2-D shift: cell (x, y) is bit y * S + x of a row-major bitmap padded to a
+// stride S = 2 width - 1. A vector (dx, dy), |dx| < width, is then the single
+// index dy * S + dx, one-to-one, and the valid indices are contiguous from 1.
+// Points taken in row-major order are a 1-D ruler over the padded indices
+// with candidates restricted to x < width: the new differences of a point
+// are again one shift of reversed_marks (WideBitSet<W> words, the shift
+// moves whole rows and columns at once), checked against used_dist.
+// The same argument as the 1-D kernels gives last + r(r+1)/2 <= last index.
+//
+// Costas arrays: width = height = N, one point per row and column; point k
+// lies in row k, columns tracked in a 64-bit mask.
+//
+// Symmetry: translation (first point in row 0, leftmost point in column 0)
+// and the dihedral group of the grid, 8 elements for a square, 4 otherwise
+// (no transposition): Count keeps a set only if its sorted row-major keys
+// are the smallest over its images (lexicographic leader).
+//
+// Parallelism as searchGolombV5: fixed-depth prefixes (first points),
+// schedule(dynamic, 1); Find stops all threads at the first solution.
+// =============================================================================
+
+constexpr int MAX_SIDE_RECT = 32;
+constexpr int MAX_POINTS_RECT = 64;   // n(n-1)/2 vectors fit below 2048 for n <= 64
+
+enum class RectMode {
+    Find,   // One placement of N points (any, not reduced by symmetry)
+    Count   // Every placement, one per symmetry class
+};
+
+struct RectOptions {
+    int width = 0;
+    int height = 0;
+    int points = 0;
+    bool costas = false;     // width = height = points, one point per row / column
+    RectMode mode = RectMode::Find;
+    int prefixDepth = 0;     // Points per prefix, 0 = auto
+};
+
+struct RectPoint {
+    int x;
+    int y;
+};
+
+struct RectResult {
+    bool found = false;
+    std::vector<RectPoint> points;  // Find: the placement (row-major order)
+    long long explored = 0;
+    long long classes = 0;          // Count: symmetry classes
+    long long placements = 0;       // Count: sum of orbit sizes (up to translation)
+    int prefixCount = 0;
+    int prefixDepth = 0;
+    int words = 0;                  // 64-bit words of the padded bitmap
+    int symmetries = 0;             // Size of the dihedral group used
+};
+
+// Returns false on unsupported sizes (side > MAX_SIDE_RECT, points > MAX_POINTS_RECT)
+bool searchGolombRect(const RectOptions& options, RectResult& result);
+
+// Largest N with an N-point Golomb rectangle in width x height (Find for
+// N = 2, 3, ... until one fails); result holds the last placement found
+int maxGolombRect(int width, int height, int prefixDepth, RectResult& result,
+                  std::vector<RectResult>* steps = nullptr);
+
+// All difference vectors distinct, points inside the grid
+bool isGolombRectangle(const std::vector<RectPoint>& points, int width, int height);
@@ -6,7 +6,7 @@
 // SEARCH SEQUENTIAL V2 - BitSet128 shift-based optimization
 // =============================================================================
 // Key optimizations from V5 applied to sequential:
-// - BitSet128 (2x uint64_t) instead of explicit marks array
+// - BitSet128 (simd_bitset.hpp: SSE / NEON) instead of explicit marks array
 // - reversed_marks encoding: bit i set means mark at (ruler_length - i)
 // - O(1) collision detection: (reversed_marks << offset) & used_dist
 // - No marks array copy on push - just shift + set bit 0
@@ -3,11 +3,11 @@
 #include "golomb.hpp"
 
 // =============================================================================
-// SEARCH SEQUENTIAL V3 - SIMD optimized (SSE2/AVX)
+// SEARCH SEQUENTIAL V3 - SIMD optimized (SSE on x86, NEON on ARM)
 // =============================================================================
 // Key optimizations over V2:
-// - Native __m128i SIMD operations instead of 2x uint64_t
-// - Single instruction any() check with _mm_testz_si128
+// - 128-bit vector registers instead of 2x uint64_t (simd_bitset.hpp)
+// - Branch-free shift, single instruction any() check
 // - Avoid double shift by reusing new_dist
 // - Local bestLen cache to reduce memory access
 // - Prefetch next stack frame
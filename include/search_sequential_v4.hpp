@@ -1,6 +1,7 @@
 #pragma once
 
 #include "golomb.hpp"
+#include "pattern_db.hpp"
 
 // =============================================================================
 // SEARCH SEQUENTIAL V4 - Maximum pruning + all optimizations
@@ -17,7 +18,9 @@
 // Standard search with automatic bounds
 void searchGolombSequentialV4(int n, int maxLen, GolombRuler& best);
 
-// Search with custom initial bound (use known optimal for faster search)
-void searchGolombSequentialV4WithBound(int n, int initialBound, GolombRuler& best);
+// Search with custom initial bound (use known optimal for faster search).
+// patternDb: node prune with the pattern database span instead of r(r+1)/2
+void searchGolombSequentialV4WithBound(int n, int initialBound, GolombRuler& best,
+                                       const PatternDB* patternDb = nullptr);
 
 long long getExploredCountSequentialV4();
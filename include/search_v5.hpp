@@ -1,16 +1,151 @@
 #pragma once
 
 #include "golomb.hpp"
+#include "bound_policy.hpp"
+#include "prefix_digest.hpp"
+#include "prefix_trace.hpp"
+#include "pattern_db.hpp"
+#include <cstdint>
+#include <vector>
 
 // =============================================================================
 // SEARCH V5 - Optimized with native uint64_t operations
 // =============================================================================
 // Key optimizations over V4:
-// - Uses 2x uint64_t (128 bits) instead of std::bitset<256>
+// - Uses a 128-bit SIMD set (simd_bitset.hpp) instead of std::bitset<256>
 // - Direct bit operations without std::bitset overhead
 // - Branchless conflict detection with OR + popcount
 // - Better cache locality with smaller state structures
 // =============================================================================
 
+// Prefix generation strategy
+enum class PrefixSplitV5 {
+    FixedDepth,  // Every branch expanded to prefixDepth (default)
+    Adaptive     // Expand only while estimated subtree cost > target task size
+};
+
+// Order in which prefixes are dispatched to threads
+enum class PrefixOrderV5 {
+    Generation,  // DFS / increasing positions (default)
+    Length,      // Smallest ruler_length first
+    Slack        // Largest slack first: smallest ruler_length + r(r+1)/2
+};
+
+// Order in which the children of a node are tried
+enum class CandidateOrderV5 {
+    Increasing,          // Increasing position (default)
+    FreeSmallDistances   // Fewest small distances consumed first
+};
+
+struct SearchOptionsV5 {
+    int prefixDepth = 0;                          // FixedDepth only, 0 = auto
+    PrefixSplitV5 split = PrefixSplitV5::FixedDepth;
+    int tasksPerThread = 64;                      // Adaptive: target tasks per thread
+    int probes = 16;                              // Adaptive: random dives per estimate
+    int heuristicThreads = 0;                     // Portfolio: threads running greedy construction
+    int heuristicStallLimit = 20000;              // Portfolio: failed attempts before switching to exact
+    PrefixOrderV5 prefixOrder = PrefixOrderV5::Generation;
+    CandidateOrderV5 candidateOrder = CandidateOrderV5::Increasing;
+    std::vector<int> forbiddenDistances;          // Constraint: distances no pair may use
+    // Deterministic: lexicographically smallest optimal ruler and a timing
+    // independent node count, at any thread count. Uses fixed-depth prefixes
+    // and increasing candidates; portfolio and candidate ordering are ignored.
+    bool deterministic = false;
+    bool recordPrefixCosts = false;               // Fill SearchStatsV5::prefixCosts (scheduler traces)
+    bool recordDigests = false;                   // Deterministic only: fill SearchStatsV5::digests (audit)
+    // How threads read the shared bound (bound_policy.hpp). Applies to the
+    // default kernel; candidate ordering and the portfolio read the atomic.
+    BoundPolicy boundPolicy = BoundPolicy::Atomic;
+    int boundRefresh = DEFAULT_BOUND_REFRESH;     // Cached: nodes between two reads
+    // Node prune with the pattern database span instead of r(r+1)/2. Applies
+    // to the default kernel and batches; null keeps the triangular bound.
+    const PatternDB* patternDb = nullptr;
+};
+
+// Longest bound the 2x uint64_t distance set supports; longer bounds are
+// clamped to it by every entry point
+constexpr int MAX_LEN_V5 = 127;
+
+// One improvement of the shared bound (time in seconds since search start)
+struct BoundEventV5 {
+    double time;
+    int length;
+    bool heuristic;  // Published by a portfolio heuristic thread
+};
+
+struct SearchStatsV5 {
+    long long explored = 0;
+    int prefixCount = 0;
+    int minPrefixDepth = 0;
+    int maxPrefixDepth = 0;
+    long long deterministicExplored = 0;  // Deterministic: nodes visited under the final bound
+    std::vector<BoundEventV5> boundTimeline;
+    std::vector<PrefixCost> prefixCosts;  // recordPrefixCosts: one entry per prefix, generation order
+    BoundPolicyStats boundPolicy;         // Checks / refreshes / stale nodes of the bound readers
+    std::vector<PrefixDigest> digests;    // recordDigests: one entry per prefix, generation order
+    uint64_t finalBoundKey = 0;           // Deterministic: final bound key (audit re-execution)
+    int prefixDepth = 0;                  // Fixed-depth split: depth actually used
+};
+
 void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth = 0);
+void searchGolombV5(int n, int maxLen, GolombRuler& best, const SearchOptionsV5& options);
+// Reentrant variant: statistics go to the caller, safe for concurrent calls
+void searchGolombV5(int n, int maxLen, GolombRuler& best, const SearchOptionsV5& options,
+                    SearchStatsV5& stats);
+
+// Compact, self-contained prefix (work unit payload): the bitsets of a
+// partial ruler as raw words, so it can be written to disk or sent around
+struct PrefixStubV5 {
+    uint64_t marks_lo;   // reversed_marks
+    uint64_t marks_hi;
+    uint64_t dist_lo;    // used_dist
+    uint64_t dist_hi;
+    int32_t marks_count;
+    int32_t ruler_length;
+};
+
+// Prefix set of a search (same generation as searchGolombV5)
+void generatePrefixStubsV5(int n, int maxLen, const SearchOptionsV5& options,
+                           std::vector<PrefixStubV5>& stubs);
+
+// Explore a given set of prefixes for rulers of length <= maxLen
+void searchPrefixStubsV5(int n, int maxLen, const std::vector<PrefixStubV5>& stubs,
+                         const SearchOptionsV5& options, GolombRuler& best, SearchStatsV5& stats);
+
+// One instance of a batch: inputs (n, maxLen, constraints) and its results
+struct BatchInstanceV5 {
+    int n = 0;
+    int maxLen = 0;
+    std::vector<int> forbiddenDistances;
+    GolombRuler best;
+    SearchStatsV5 stats;
+};
+
+// Solve many independent instances with one shared prefix pool and one
+// dynamic scheduler (per-instance bounds and results). Uses the prefix
+// options of `options`; portfolio and candidate ordering are not applied.
+void searchGolombBatchV5(std::vector<BatchInstanceV5>& instances, const SearchOptionsV5& options);
+
+// Audit of a finished deterministic run: re-execute a random sample of its
+// prefixes (different threads than the recorded ones when possible) under
+// the final bound and compare their digests.
+struct AuditReportV5 {
+    int prefixes = 0;                  // Prefixes in the recorded run
+    int sampled = 0;
+    int mismatches = 0;
+    int sameThread = 0;                // Re-executed on the recording thread (single thread)
+    bool betterRulerFound = false;     // Re-execution beat the recorded bound (fault)
+    long long recordedNodes = 0;       // All prefixes, from the digests
+    long long reexecutedNodes = 0;     // Nodes of the sampled prefixes (counted ones)
+    double time = 0.0;
+    std::vector<PrefixDigest> expected;  // Mismatching prefixes: recorded digest
+    std::vector<PrefixDigest> actual;    //                       re-executed digest
+};
+
+// options must match the recorded run (prefixDepth = SearchStatsV5::prefixDepth)
+void auditPrefixesV5(int n, int maxLen, const SearchOptionsV5& options,
+                     const std::vector<PrefixDigest>& digests, uint64_t finalBoundKey,
+                     double fraction, uint64_t seed, AuditReportV5& report);
+
 long long getExploredCountV5();
+const SearchStatsV5& getSearchStatsV5();
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "golomb.hpp"
+#include <vector>
+
+// =============================================================================
+// SEARCH WIDE - Long rulers (L up to 4095): shift checks vs mark-list checks
+// =============================================================================
+// For L in the hundreds to thousands the distance set needs W = L/64 words:
+//
+//   Shift : (reversed_marks << offset) & used_dist over W words per candidate
+//           (the BitSet128 kernels of V2-V5, widened). O(W), per-frame copies.
+//   List  : one gather per placed mark, used[pos - a_i] (the usedDiffs loop of
+//           search_sequential.cpp, with AVX2 / AVX-512 gathers). O(marks),
+//           the distance set is updated in place on push / pop.
+//
+// The cost of a list check grows with depth while a shift check does not, so
+// the engine switches once, at a mark count k*: list checks while fewer than
+// k* marks are placed, shift checks from k* marks on. k* comes from a cost model of the instance (WideCheck::Auto),
+// or is forced (Shift: from the root, List: never).
+//
+// Cost model: microloops of the two checks miss what dominates in the search
+// (branches, frame traffic, cache state), so the model is measured in situ:
+// two pilot runs of a few thousand nodes (all-list, all-shift) on the same
+// instance time each depth, excluding children. Both pilots expand the same
+// nodes, so per depth T_list(k) and T_shift(k) are directly comparable and
+//   k* = argmin_k  sum_{d < k} T_list(d) + sum_{d >= k} T_shift(d)
+// Node counts do not depend on the strategy, only the time per node does.
+//
+// Shift-level state (WideState): a child frame per level, copied on push as
+// in V5 (Copy), or one shared state changed in place, the mark position as
+// undo record (InPlace, wideMake / wideUnmake): 2 W words whatever the depth,
+// instead of n frames of 2 W words. Either way a check only touches the words
+// of the candidate ruler length, not all W.
+//
+// Sequential: meant for heuristic / feasibility runs (firstSolution, forbidden
+// distances, node limits) on rulers far beyond the exact engines.
+// =============================================================================
+
+constexpr int MAX_MARKS_WIDE = 64;
+constexpr int MAX_LEN_WIDE = 4095;
+
+enum class WideCheck {
+    Auto,   // Switch depth from the cost model
+    Shift,  // Shift checks from the root
+    List    // Mark-list checks everywhere
+};
+
+enum class WideState {
+    Copy,     // Child frame per level
+    InPlace   // Shared state + undo (offset) per level
+};
+
+const char* wideCheckName(WideCheck check);
+bool parseWideCheck(const char* name, WideCheck& check);
+const char* wideStateName(WideState state);
+bool parseWideState(const char* name, WideState& state);
+
+// Per-depth cost of each strategy, from the pilots (index = mark count)
+struct WideCostModel {
+    int words = 0;                 // W (64-bit words of the distance set)
+    long long pilotNodes = 0;      // Nodes per pilot run (may end sooner)
+    std::vector<double> listNs;    // ns per candidate check at depth k (0 = not reached)
+    std::vector<double> shiftNs;
+    std::vector<long long> checks; // Candidate checks at depth k in each pilot
+    int switchMarks = 0;           // k*: shift checks from this mark count on
+    double calibrationTime = 0.0;  // s, both pilots
+};
+
+struct WideOptions {
+    WideCheck check = WideCheck::Auto;
+    WideState state = WideState::InPlace;
+    int switchMarks = -1;          // > 0: overrides the model (Auto only)
+    bool firstSolution = false;    // Stop at the first ruler of length <= maxLen
+    long long nodeLimit = 0;       // 0 = no limit
+    std::vector<int> forbidden;    // Distances no pair of marks may have
+    long long pilotNodes = 20000;  // Auto: nodes per pilot run
+};
+
+struct WideStats {
+    long long nodes = 0;
+    long long listChecks = 0;      // Candidates checked against the mark list
+    long long shiftChecks = 0;     // Candidates checked by shift
+    int switchMarks = 0;           // Depth (mark count) where shift took over
+    bool complete = false;         // Search space exhausted (optimal within maxLen)
+    bool limitReached = false;     // Stopped by nodeLimit
+    WideCostModel model;
+};
+
+// Words of the distance set for rulers up to maxLen (2, 4, ..., 64)
+int wideWords(int maxLen);
+
+// Pilot runs on the instance (options: forbidden distances, firstSolution)
+WideCostModel calibrateWideCostModel(int n, int maxLen, const WideOptions& options);
+
+// Best ruler of length <= maxLen (shortest found, or the first one with
+// firstSolution). Returns false if none was found.
+bool searchGolombWide(int n, int maxLen, const WideOptions& options,
+                      GolombRuler& best, WideStats& stats);
+
+// GolombRuler::isValid stops at MAX_DIFF: any length, plus forbidden distances
+bool isValidWideRuler(const std::vector<int>& marks, const std::vector<int>& forbidden);
@@ -0,0 +1,397 @@
+#pragma once
+
+#include <cstdint>
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#if defined(__SSE4_1__)
+#include <smmintrin.h>
+#endif
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#elif defined(GOLOMB_SIMD_NEON)
+#include "neon_emulation.hpp"
+#define GOLOMB_SIMD_NEON_EMULATED 1
+#endif
+#if defined(__AVX2__) && !defined(GOLOMB_SIMD_SCALAR)
+#include <immintrin.h>
+#endif
+
+// =============================================================================
+// PORTABLE SIMD BITSET - 128-bit distance / mark sets on x86 and ARM
+// =============================================================================
+// One interface, three backends:
+//
+//   Bits128Scalar : two uint64_t words (any compiler, MSVC included)
+//   Bits128Sse    : __m128i (SSE2; any() with PTEST when SSE4.1 is enabled)
+//   Bits128Neon   : uint64x2_t (AArch64 / ARMv7 NEON; SVE machines run it too)
+//
+// SimdBitSet128 is the backend picked at build time from the target flags
+// (-march=native picks SSE on x86, NEON on ARM). -DGOLOMB_SIMD_SCALAR forces
+// the scalar words, e.g. to compare backends with make regress.
+// -DGOLOMB_SIMD_NEON forces the NEON backend, on x86 through plain C++
+// versions of its intrinsics (neon_emulation.hpp, make neon-check).
+//
+// The shift never branches on the offset: per-lane shifts with a count >= 64
+// give zero (PSLLQ / USHL), so bits moving from the low to the high word come
+// from a second shift of [0, lo] by (n - 64), negative counts shifting right.
+// set() / test() build the single-bit mask the same way, in registers.
+//
+// AVX2 / AVX-512 add nothing at 128 bits (the sets fit one register): the
+// wide sets below (WideBitSet<W>, W x 64 bits, long rulers) are plain word
+// loops written for the auto-vectorizer, which maps them to AVX2 / AVX-512 /
+// NEON from the same source. The one loop it cannot vectorize, the mark-list
+// check (a load per mark at a computed word), is an explicit gather with
+// AVX2 / AVX-512 (scalar elsewhere and with -DGOLOMB_SIMD_SCALAR).
+// Offsets must be in [0, 128) for the 128-bit set.
+// =============================================================================
+
+namespace simd_bits {
+
+// =============================================================================
+// SCALAR - reference semantics
+// =============================================================================
+struct alignas(16) Bits128Scalar {
+    uint64_t w0;  // bits 0-63
+    uint64_t w1;  // bits 64-127
+
+    Bits128Scalar() : w0(0), w1(0) {}
+    Bits128Scalar(uint64_t lo, uint64_t hi) : w0(lo), w1(hi) {}
+
+    inline uint64_t lo() const { return w0; }
+    inline uint64_t hi() const { return w1; }
+
+    inline void set(int pos) {
+        if (pos < 64) {
+            w0 |= (1ULL << pos);
+        } else {
+            w1 |= (1ULL << (pos - 64));
+        }
+    }
+
+    inline bool test(int pos) const {
+        if (pos < 64) {
+            return (w0 >> pos) & 1;
+        }
+        return (w1 >> (pos - 64)) & 1;
+    }
+
+    inline Bits128Scalar operator<<(int n) const {
+        if (n == 0) return *this;
+        if (n >= 128) return Bits128Scalar();
+        if (n >= 64) {
+            return Bits128Scalar(0, w0 << (n - 64));
+        }
+        return Bits128Scalar(w0 << n, (w1 << n) | (w0 >> (64 - n)));
+    }
+
+    inline Bits128Scalar operator&(const Bits128Scalar& other) const {
+        return Bits128Scalar(w0 & other.w0, w1 & other.w1);
+    }
+    inline Bits128Scalar operator|(const Bits128Scalar& other) const {
+        return Bits128Scalar(w0 | other.w0, w1 | other.w1);
+    }
+    inline Bits128Scalar operator^(const Bits128Scalar& other) const {
+        return Bits128Scalar(w0 ^ other.w0, w1 ^ other.w1);
+    }
+
+    inline bool any() const { return (w0 | w1) != 0; }
+    inline void reset() { w0 = w1 = 0; }
+};
+
+// =============================================================================
+// SSE (x86-64: SSE2 is always there)
+// =============================================================================
+#if defined(__SSE2__) || defined(_M_X64)
+struct alignas(16) Bits128Sse {
+    __m128i v;
+
+    Bits128Sse() : v(_mm_setzero_si128()) {}
+    explicit Bits128Sse(__m128i d) : v(d) {}
+    Bits128Sse(uint64_t lo, uint64_t hi)
+        : v(_mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo))) {}
+
+    inline uint64_t lo() const { return static_cast<uint64_t>(_mm_cvtsi128_si64(v)); }
+    inline uint64_t hi() const {
+        return static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(v, v)));
+    }
+
+    // [lo, hi] << n: (v << n) | ([0, lo] >> (64 - n)) | ([0, lo] << (n - 64));
+    // counts are 64-bit in the low qword, out-of-range ones give zero
+    static inline __m128i shiftLeft(__m128i x, int n) {
+        const __m128i carry = _mm_slli_si128(x, 8);
+        const __m128i same = _mm_sll_epi64(x, _mm_cvtsi32_si128(n));
+        const __m128i down = _mm_srl_epi64(carry, _mm_cvtsi32_si128(64 - n));
+        const __m128i up = _mm_sll_epi64(carry, _mm_cvtsi32_si128(n - 64));
+        return _mm_or_si128(same, _mm_or_si128(down, up));
+    }
+
+    static inline __m128i bit(int pos) {
+        return shiftLeft(_mm_cvtsi32_si128(1), pos);
+    }
+
+    static inline bool nonZero(__m128i x) {
+#if defined(__SSE4_1__)
+        return !_mm_testz_si128(x, x);
+#else
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_setzero_si128())) != 0xFFFF;
+#endif
+    }
+
+    inline void set(int pos) { v = _mm_or_si128(v, bit(pos)); }
+    inline bool test(int pos) const {
+#if defined(__SSE4_1__)
+        return !_mm_testz_si128(v, bit(pos));
+#else
+        return nonZero(_mm_and_si128(v, bit(pos)));
+#endif
+    }
+
+    inline Bits128Sse operator<<(int n) const { return Bits128Sse(shiftLeft(v, n)); }
+
+    inline Bits128Sse operator&(const Bits128Sse& other) const {
+        return Bits128Sse(_mm_and_si128(v, other.v));
+    }
+    inline Bits128Sse operator|(const Bits128Sse& other) const {
+        return Bits128Sse(_mm_or_si128(v, other.v));
+    }
+    inline Bits128Sse operator^(const Bits128Sse& other) const {
+        return Bits128Sse(_mm_xor_si128(v, other.v));
+    }
+
+    inline bool any() const { return nonZero(v); }
+    inline void reset() { v = _mm_setzero_si128(); }
+};
+#define GOLOMB_SIMD_HAVE_SSE 1
+#endif
+
+// =============================================================================
+// NEON (USHL: negative counts shift right, |count| >= 64 gives zero)
+// =============================================================================
+#if defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(GOLOMB_SIMD_NEON_EMULATED)
+struct alignas(16) Bits128Neon {
+    uint64x2_t v;
+
+    Bits128Neon() : v(vdupq_n_u64(0)) {}
+    explicit Bits128Neon(uint64x2_t d) : v(d) {}
+    Bits128Neon(uint64_t lo, uint64_t hi) : v(vcombine_u64(vcreate_u64(lo), vcreate_u64(hi))) {}
+
+    inline uint64_t lo() const { return vgetq_lane_u64(v, 0); }
+    inline uint64_t hi() const { return vgetq_lane_u64(v, 1); }
+
+    static inline uint64x2_t shiftLeft(uint64x2_t x, int n) {
+        const uint64x2_t carry = vextq_u64(vdupq_n_u64(0), x, 1);  // [0, lo]
+        const uint64x2_t same = vshlq_u64(x, vdupq_n_s64(n));
+        const uint64x2_t moved = vshlq_u64(carry, vdupq_n_s64(n - 64));
+        return vorrq_u64(same, moved);
+    }
+
+    static inline uint64x2_t bit(int pos) {
+        return shiftLeft(vcombine_u64(vcreate_u64(1), vcreate_u64(0)), pos);
+    }
+
+    static inline bool nonZero(uint64x2_t x) {
+        return (vgetq_lane_u64(x, 0) | vgetq_lane_u64(x, 1)) != 0;
+    }
+
+    inline void set(int pos) { v = vorrq_u64(v, bit(pos)); }
+    inline bool test(int pos) const { return nonZero(vandq_u64(v, bit(pos))); }
+
+    inline Bits128Neon operator<<(int n) const { return Bits128Neon(shiftLeft(v, n)); }
+
+    inline Bits128Neon operator&(const Bits128Neon& other) const {
+        return Bits128Neon(vandq_u64(v, other.v));
+    }
+    inline Bits128Neon operator|(const Bits128Neon& other) const {
+        return Bits128Neon(vorrq_u64(v, other.v));
+    }
+    inline Bits128Neon operator^(const Bits128Neon& other) const {
+        return Bits128Neon(veorq_u64(v, other.v));
+    }
+
+    inline bool any() const { return nonZero(v); }
+    inline void reset() { v = vdupq_n_u64(0); }
+};
+#define GOLOMB_SIMD_HAVE_NEON 1
+#endif
+
+// =============================================================================
+// WIDE BITSET - W x 64 bits for rulers longer than 127 (search_wide.cpp)
+// =============================================================================
+// Branch-free inner loops over whole words (no early exit): the compiler
+// vectorizes them at -O3. The shift by n = 64 q + r reads word i - q and
+// i - q - 1; ((x >> 1) >> (63 - r)) is x >> (64 - r) without the r = 0 case.
+//
+// `words` arguments bound a loop to the words that can be non-zero (a ruler
+// of length len only uses words 0 .. len / 64): the caller guarantees that
+// words at and above it are zero, in the operands and in the result.
+// =============================================================================
+template <int W>
+struct alignas(64) WideBitSet {
+    static constexpr int WORDS = W;
+    static constexpr int BITS = W * 64;
+
+    uint64_t w[W];
+
+    WideBitSet() { reset(); }
+
+    inline void reset() {
+        for (int i = 0; i < W; ++i) w[i] = 0;
+    }
+
+    inline void set(int pos) { w[pos >> 6] |= (1ULL << (pos & 63)); }
+    inline void clear(int pos) { w[pos >> 6] &= ~(1ULL << (pos & 63)); }
+    inline bool test(int pos) const { return (w[pos >> 6] >> (pos & 63)) & 1; }
+
+    inline bool any() const {
+        uint64_t acc = 0;
+        for (int i = 0; i < W; ++i) acc |= w[i];
+        return acc != 0;
+    }
+
+    // out = this << n (bits shifted past BITS are dropped), n in [0, BITS)
+    inline void shiftLeftInto(int n, WideBitSet& out) const {
+        const int q = n >> 6;
+        const int r = n & 63;
+        for (int i = 0; i < q; ++i) out.w[i] = 0;
+        out.w[q] = w[0] << r;
+        for (int i = q + 1; i < W; ++i) {
+            out.w[i] = (w[i - q] << r) | ((w[i - q - 1] >> 1) >> (63 - r));
+        }
+    }
+
+    // ((this << n) & other).any() without materializing the shift
+    inline bool shiftedIntersects(int n, const WideBitSet& other, int words = W) const {
+        const int q = n >> 6;
+        const int r = n & 63;
+        uint64_t acc = (w[0] << r) & other.w[q];
+        for (int i = q + 1; i < words; ++i) {
+            acc |= ((w[i - q] << r) | ((w[i - q - 1] >> 1) >> (63 - r))) & other.w[i];
+        }
+        return acc != 0;
+    }
+
+    // ((this >> n) & other).any() over words [0, words)
+    inline bool shiftedRightIntersects(int n, const WideBitSet& other, int words) const {
+        const int q = n >> 6;
+        const int r = n & 63;
+        uint64_t acc = 0;
+        for (int i = 0; i < words - 1; ++i) {
+            acc |= ((w[i + q] >> r) | ((w[i + q + 1] << 1) << (63 - r))) & other.w[i];
+        }
+        acc |= lastRightWord(q, r, words) & other.w[words - 1];
+        return acc != 0;
+    }
+
+    // this ^= src >> n over words [0, words)
+    inline void xorShiftedRight(const WideBitSet& src, int n, int words) {
+        const int q = n >> 6;
+        const int r = n & 63;
+        for (int i = 0; i < words - 1; ++i) {
+            w[i] ^= (src.w[i + q] >> r) | ((src.w[i + q + 1] << 1) << (63 - r));
+        }
+        w[words - 1] ^= src.lastRightWord(q, r, words);
+    }
+
+    // Word words - 1 of this >> (64 q + r): its upper source word may be past the end
+    inline uint64_t lastRightWord(int q, int r, int words) const {
+        const int i = words - 1 + q;
+        return (w[i] >> r) | (i + 1 < W ? ((w[i + 1] << 1) << (63 - r)) : 0);
+    }
+
+    inline void orWith(const WideBitSet& other) {
+        for (int i = 0; i < W; ++i) w[i] |= other.w[i];
+    }
+    inline void xorWith(const WideBitSet& other, int words = W) {
+        for (int i = 0; i < words; ++i) w[i] ^= other.w[i];
+    }
+
+    // Mark-list check: any bit (pos - marks[i]) set, i < count. O(count)
+    // instead of O(W): 8 (AVX-512) or 4 (AVX2) marks per gather of words
+    // w[d >> 6], each shifted by its own d & 63; the tail is scalar
+    inline bool anyAtDistances(int pos, const int* marks, int count) const {
+        const long long* base = reinterpret_cast<const long long*>(w);
+        int i = 0;
+        uint64_t acc = 0;
+#if defined(__AVX512F__) && !defined(GOLOMB_SIMD_SCALAR)
+        const __m256i pos8 = _mm256_set1_epi32(pos);
+        const __m256i low8 = _mm256_set1_epi32(63);
+        __m512i acc8 = _mm512_setzero_si512();
+        for (; i + 8 <= count; i += 8) {
+            const __m256i d = _mm256_sub_epi32(pos8, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(marks + i)));
+            const __m512i words = _mm512_i32gather_epi64(_mm256_srli_epi32(d, 6), base, 8);
+            acc8 = _mm512_or_si512(acc8, _mm512_srlv_epi64(words, _mm512_cvtepu32_epi64(_mm256_and_si256(d, low8))));
+        }
+        acc = static_cast<uint64_t>(_mm512_reduce_or_epi64(acc8));
+#endif
+#if defined(__AVX2__) && !defined(GOLOMB_SIMD_SCALAR)
+        const __m128i pos4 = _mm_set1_epi32(pos);
+        const __m128i low4 = _mm_set1_epi32(63);
+        __m256i acc4 = _mm256_setzero_si256();
+        for (; i + 4 <= count; i += 4) {
+            const __m128i d = _mm_sub_epi32(pos4, _mm_loadu_si128(reinterpret_cast<const __m128i*>(marks + i)));
+            const __m256i words = _mm256_i32gather_epi64(base, _mm_srli_epi32(d, 6), 8);
+            acc4 = _mm256_or_si256(acc4, _mm256_srlv_epi64(words, _mm256_cvtepu32_epi64(_mm_and_si128(d, low4))));
+        }
+        const __m128i acc2 = _mm_or_si128(_mm256_castsi256_si128(acc4), _mm256_extracti128_si256(acc4, 1));
+        acc |= static_cast<uint64_t>(_mm_cvtsi128_si64(acc2) | _mm_extract_epi64(acc2, 1));
+#endif
+        for (; i < count; ++i) {
+            const int d = pos - marks[i];
+            acc |= w[d >> 6] >> (d & 63);
+        }
+        (void)base;
+        return (acc & 1) != 0;
+    }
+};
+
+// =============================================================================
+// IN-PLACE MAKE / UNMAKE - one shared { marks, used_dist } state
+// =============================================================================
+// Instead of a child frame per level (2 W words written per push, a stack of
+// n frames: 65 KB at W = 64), the search mutates one state. The marks are kept
+// in a fixed frame, bit BITS - 1 - a_i (not relative to the last mark), so
+// the distances of a new mark at pos are (marks >> (BITS - 1 - pos)): make
+// XORs them into used_dist and sets one bit, unmake clears the bit and XORs
+// them out again. The undo record of a level is its mark position alone.
+// Both touch only the words of the new ruler length: (pos >> 6) + 1.
+// =============================================================================
+template <int W>
+inline void wideMake(WideBitSet<W>& marks, WideBitSet<W>& used_dist, int pos, int words) {
+    const int n = WideBitSet<W>::BITS - 1 - pos;
+    used_dist.xorShiftedRight(marks, n, words);
+    marks.set(n);
+}
+
+template <int W>
+inline void wideUnmake(WideBitSet<W>& marks, WideBitSet<W>& used_dist, int pos, int words) {
+    const int n = WideBitSet<W>::BITS - 1 - pos;
+    marks.clear(n);
+    used_dist.xorShiftedRight(marks, n, words);
+}
+
+} // namespace simd_bits
+
+// =============================================================================
+// BUILD-TIME SELECTION
+// =============================================================================
+#if defined(GOLOMB_SIMD_SCALAR)
+using SimdBitSet128 = simd_bits::Bits128Scalar;
+#define GOLOMB_SIMD_BACKEND "scalar"
+#elif defined(GOLOMB_SIMD_NEON_EMULATED)
+using SimdBitSet128 = simd_bits::Bits128Neon;
+#define GOLOMB_SIMD_BACKEND "neon (emulated)"
+#elif defined(GOLOMB_SIMD_HAVE_NEON)
+using SimdBitSet128 = simd_bits::Bits128Neon;
+#define GOLOMB_SIMD_BACKEND "neon"
+#elif defined(GOLOMB_SIMD_HAVE_SSE) && defined(__SSE4_1__)
+using SimdBitSet128 = simd_bits::Bits128Sse;
+#define GOLOMB_SIMD_BACKEND "sse4.1"
+#elif defined(GOLOMB_SIMD_HAVE_SSE)
+using SimdBitSet128 = simd_bits::Bits128Sse;
+#define GOLOMB_SIMD_BACKEND "sse2"
+#else
+using SimdBitSet128 = simd_bits::Bits128Scalar;
+#define GOLOMB_SIMD_BACKEND "scalar"
+#endif
+
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "search_v5.hpp"
+#include <string>
+
+// =============================================================================
+// SPOOL V5 - File-based work-unit queue (multi-process runs without MPI)
+// =============================================================================
+// Layout of a spool directory (must live on a filesystem where rename() is
+// atomic, e.g. one GPFS/NFS export or a local disk):
+//
+//   spool.cfg            n, bound and unit count written by the coordinator
+//   pending/unit_N.bin   binary work units (header + PrefixStubV5 records)
+//   running/unit_N@host:pid.bin
+//                        units claimed by a worker (claim = atomic rename);
+//                        the name is the owner, the mtime the lease, renewed
+//                        every SPOOL_HEARTBEAT_V5 seconds during the search
+//   done/unit_N.result   one text line per finished unit
+//   bounds/len_L         one marker per ruler length found so far; the
+//                        shared bound is the smallest L (create-only, so
+//                        concurrent updates never lose an improvement)
+//
+// Workers re-read the shared bound before every unit and search strictly
+// below it. The merge step picks the shortest ruler, ties broken by the
+// lowest unit id.
+// =============================================================================
+
+constexpr int SPOOL_HEARTBEAT_V5 = 30;  // Seconds between two lease renewals
+
+// Coordinator: generate the prefix set and split it into units of unitSize prefixes
+int spoolInitV5(const std::string& dir, int n, int maxLen, const SearchOptionsV5& options,
+                int unitSize);
+
+// Worker: claim and solve units until the queue is empty (or maxUnits > 0 reached)
+int spoolWorkV5(const std::string& dir, int maxUnits);
+
+// Assemble the global answer once every unit is done
+int spoolMergeV5(const std::string& dir);
+
+// Progress report (pending / running / done, current bound)
+int spoolStatusV5(const std::string& dir);
+
+// Move units of crashed workers back to pending/: lease older than
+// staleSeconds (0 = no age limit), or owner is a dead process on this host
+int spoolRequeueV5(const std::string& dir, int staleSeconds);
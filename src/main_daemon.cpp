@@ -0,0 +1,598 @@
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <filesystem>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <poll.h>
+#include <omp.h>
+#include "search_v5.hpp"
+
+// =============================================================================
+// GOLOMB SOLVER DAEMON - Long-lived server over a Unix-domain socket
+// =============================================================================
+// Avoids per-query process startup, OpenMP team creation and repeated work:
+//   - one solver thread owns every omp parallel region, so the OpenMP team
+//     is created once and reused for the daemon's lifetime
+//   - pending small queries of one mode are solved together: their prefixes
+//     go into one shared pool (searchGolombBatchV5)
+//   - the batches and the large queries pending together run concurrently,
+//     each on a nested team with its share of the threads
+//   - results are cached in memory and appended to a cache file on disk
+//
+// Line-based protocol (one request per line, one response per line):
+//   SOLVE n=<n> [bound=<L>] [forbid=<d1,d2,...>] [mode=exact|adaptive|portfolio]
+//     -> OK n=<n> bound=<B> length=<L> marks=<m0,m1,...> states=<S> time=<s> cached=<0|1>
+//     -> NONE n=<n> bound=<B> states=<S> time=<s> cached=<0|1>
+//   PING     -> PONG
+//   STATS    -> STATS requests=<R> cache_hits=<H> cache_size=<C>
+//   SHUTDOWN -> BYE (daemon exits)
+//   Errors   -> ERR <message>
+//
+// Usage:
+//   golomb_daemon [--socket=PATH] [--cache=DIR] [--small-n=N]
+//   golomb_daemon --query="SOLVE n=10" [--socket=PATH]     (client mode)
+//
+// The socket defaults to $XDG_RUNTIME_DIR/golomb_daemon.sock, or
+// /tmp/golomb_daemon.<uid>.sock, and is created mode 0600: only its owner
+// can send SOLVE or SHUTDOWN. --socket=PATH overrides the path (same mode).
+// =============================================================================
+
+constexpr int DAEMON_MAX_N = 20;
+constexpr int DAEMON_MAX_LEN = 127;   // V5 limit (2x uint64_t)
+constexpr int DEFAULT_SMALL_N = 10;   // n <= this: batched together
+
+static const int KNOWN_OPTIMAL[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+
+// =============================================================================
+// REQUESTS AND QUEUE
+// =============================================================================
+// Closed when the reader and every queued request are done with it
+struct Connection {
+    int fd;
+    explicit Connection(int f) : fd(f) {}
+    ~Connection() { ::close(fd); }
+};
+
+struct SolveRequest {
+    std::shared_ptr<Connection> conn;
+    int n;
+    int bound;
+    std::vector<int> forbid;
+    std::string mode;
+    std::string key;
+};
+
+static std::deque<SolveRequest> g_queue;
+static std::mutex g_queueMutex;
+static std::condition_variable g_queueCv;
+static std::atomic<bool> g_running{true};
+
+static std::map<std::string, std::string> g_cache;  // key -> response body
+static std::mutex g_cacheMutex;
+static std::string g_cacheFile;
+static std::atomic<long long> g_requests{0};
+static std::atomic<long long> g_cacheHits{0};
+
+static std::mutex g_writeMutex;
+
+static void sendLine(int fd, const std::string& line) {
+    std::lock_guard<std::mutex> lock(g_writeMutex);
+    std::string out = line + "\n";
+    const char* data = out.c_str();
+    size_t left = out.size();
+    while (left > 0) {
+        ssize_t w = ::send(fd, data, left, MSG_NOSIGNAL);
+        if (w <= 0) return;
+        data += w;
+        left -= static_cast<size_t>(w);
+    }
+}
+
+// =============================================================================
+// CACHE - One entry per (n, bound, constraints, mode): the modes search
+// differently (states, time, heuristic bound), so their answers are kept apart
+// =============================================================================
+static std::string makeKey(int n, int bound, const std::vector<int>& forbid, const std::string& mode) {
+    std::ostringstream oss;
+    oss << n << "|" << bound << "|";
+    for (size_t i = 0; i < forbid.size(); ++i) {
+        if (i > 0) oss << ",";
+        oss << forbid[i];
+    }
+    oss << "|" << mode;
+    return oss.str();
+}
+
+static void loadCache() {
+    if (g_cacheFile.empty()) return;
+    std::ifstream file(g_cacheFile);
+    std::string line;
+    while (std::getline(file, line)) {
+        const size_t tab = line.find('\t');
+        if (tab != std::string::npos) {
+            g_cache[line.substr(0, tab)] = line.substr(tab + 1);
+        }
+    }
+}
+
+static void storeCache(const std::string& key, const std::string& body) {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    if (!g_cache.emplace(key, body).second) return;
+    if (!g_cacheFile.empty()) {
+        std::ofstream file(g_cacheFile, std::ios::app);
+        file << key << "\t" << body << "\n";
+    }
+}
+
+static bool lookupCache(const std::string& key, std::string& body) {
+    std::lock_guard<std::mutex> lock(g_cacheMutex);
+    auto it = g_cache.find(key);
+    if (it == g_cache.end()) return false;
+    body = it->second;
+    return true;
+}
+
+// =============================================================================
+// PARSING
+// =============================================================================
+static bool parseSolve(const std::string& line, SolveRequest& req, std::string& error) {
+    std::istringstream iss(line);
+    std::string token;
+    iss >> token;  // SOLVE
+
+    req.n = 0;
+    req.bound = 0;
+    req.mode = "exact";
+
+    while (iss >> token) {
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos) {
+            error = "malformed token '" + token + "'";
+            return false;
+        }
+        const std::string name = token.substr(0, eq);
+        const std::string value = token.substr(eq + 1);
+
+        if (name == "n") {
+            req.n = std::atoi(value.c_str());
+        } else if (name == "bound") {
+            req.bound = std::atoi(value.c_str());
+        } else if (name == "forbid") {
+            std::istringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (!item.empty()) req.forbid.push_back(std::atoi(item.c_str()));
+            }
+        } else if (name == "mode") {
+            req.mode = value;
+        } else {
+            error = "unknown field '" + name + "'";
+            return false;
+        }
+    }
+
+    if (req.n < 2 || req.n > DAEMON_MAX_N) {
+        error = "n must be between 2 and " + std::to_string(DAEMON_MAX_N);
+        return false;
+    }
+    if (req.mode != "exact" && req.mode != "adaptive" && req.mode != "portfolio") {
+        error = "mode must be exact, adaptive or portfolio";
+        return false;
+    }
+    if (req.bound <= 0) {
+        // Known optima are only valid bounds for unconstrained queries
+        req.bound = (req.n <= 14 && req.forbid.empty()) ? KNOWN_OPTIMAL[req.n] : DAEMON_MAX_LEN;
+    }
+    if (req.bound > DAEMON_MAX_LEN) {
+        req.bound = DAEMON_MAX_LEN;
+    }
+
+    std::sort(req.forbid.begin(), req.forbid.end());
+    req.forbid.erase(std::unique(req.forbid.begin(), req.forbid.end()), req.forbid.end());
+    req.key = makeKey(req.n, req.bound, req.forbid, req.mode);
+    return true;
+}
+
+// =============================================================================
+// SOLVER
+// =============================================================================
+static void reply(const SolveRequest& req, const std::string& body, bool cached) {
+    sendLine(req.conn->fd, body + " cached=" + (cached ? "1" : "0"));
+}
+
+static std::string formatResult(const SolveRequest& req, const GolombRuler& best,
+                                long long states, double elapsed) {
+    std::ostringstream oss;
+    if (best.marks.empty()) {
+        oss << "NONE n=" << req.n << " bound=" << req.bound;
+    } else {
+        oss << "OK n=" << req.n << " bound=" << req.bound << " length=" << best.length << " marks=";
+        for (size_t i = 0; i < best.marks.size(); ++i) {
+            if (i > 0) oss << ",";
+            oss << best.marks[i];
+        }
+    }
+    oss << " states=" << states << " time=" << elapsed;
+    return oss.str();
+}
+
+// Search options of a query mode
+static SearchOptionsV5 modeOptions(const std::string& mode) {
+    SearchOptionsV5 options;
+    if (mode == "adaptive") {
+        options.split = PrefixSplitV5::Adaptive;
+    } else if (mode == "portfolio") {
+        options.heuristicThreads = 1;
+    }
+    return options;
+}
+
+static std::string solve(const SolveRequest& req) {
+    SearchOptionsV5 options = modeOptions(req.mode);
+    options.forbiddenDistances = req.forbid;
+
+    GolombRuler best;
+    SearchStatsV5 stats;
+    const double start = omp_get_wtime();
+    searchGolombV5(req.n, req.bound, best, options, stats);
+    return formatResult(req, best, stats.explored, omp_get_wtime() - start);
+}
+
+// Small queries of one mode share one prefix pool (searchGolombBatchV5); the
+// reported time is the time of the whole batch. A request repeated within
+// the batch is solved once: the first copy answers cached=0, the others cached=1.
+static void solveBatch(const std::vector<SolveRequest>& requests) {
+    std::vector<BatchInstanceV5> instances;
+    std::vector<size_t> owner;  // request index of each instance
+    std::map<std::string, size_t> seen;
+
+    for (size_t i = 0; i < requests.size(); ++i) {
+        if (seen.emplace(requests[i].key, instances.size()).second) {
+            BatchInstanceV5 inst;
+            inst.n = requests[i].n;
+            inst.maxLen = requests[i].bound;
+            inst.forbiddenDistances = requests[i].forbid;
+            instances.push_back(inst);
+            owner.push_back(i);
+        }
+    }
+
+    const double start = omp_get_wtime();
+    searchGolombBatchV5(instances, modeOptions(requests.front().mode));
+    const double elapsed = omp_get_wtime() - start;
+
+    for (size_t k = 0; k < instances.size(); ++k) {
+        const SolveRequest& req = requests[owner[k]];
+        storeCache(req.key, formatResult(req, instances[k].best, instances[k].stats.explored, elapsed));
+    }
+    for (size_t i = 0; i < requests.size(); ++i) {
+        const SolveRequest& req = requests[i];
+        const bool duplicate = owner[seen[req.key]] != i;
+        if (duplicate) g_cacheHits++;
+        std::string body;
+        lookupCache(req.key, body);
+        reply(req, body, duplicate);
+    }
+}
+
+// One unit of a round: a batch of small queries of one mode, or one query
+// solved on its own (large n, or portfolio: the batch runs no heuristic)
+struct SolveJob {
+    std::vector<SolveRequest> requests;
+    bool batched;
+};
+
+static void runJob(const SolveJob& job) {
+    if (job.batched) {
+        solveBatch(job.requests);
+        return;
+    }
+    const SolveRequest& req = job.requests.front();
+    const std::string body = solve(req);
+    storeCache(req.key, body);
+    reply(req, body, false);
+}
+
+// Every request queued when the solver wakes up forms one round. The jobs
+// of a round run concurrently: each gets a nested team with an equal share
+// of the threads (a lone job keeps the whole team). Requests that arrive
+// during a round are picked up by the next one.
+static void solverLoop(int smallN) {
+    const int teamSize = omp_get_max_threads();
+    omp_set_max_active_levels(2);
+
+    while (true) {
+        std::vector<SolveRequest> batch;
+        {
+            std::unique_lock<std::mutex> lock(g_queueMutex);
+            g_queueCv.wait(lock, [] { return !g_queue.empty() || !g_running.load(); });
+            if (!g_running.load() && g_queue.empty()) return;
+            batch.assign(g_queue.begin(), g_queue.end());
+            g_queue.clear();
+        }
+
+        // Cache hits are answered right away; small exact and adaptive
+        // queries are batched per mode, the others are solved one by one
+        std::vector<SolveJob> jobs;
+        std::map<std::string, size_t> batchOfMode;
+        std::map<std::string, size_t> single;  // key -> job solving it
+        std::vector<SolveRequest> repeats;     // answered from that job's result
+        for (SolveRequest& req : batch) {
+            std::string body;
+            if (lookupCache(req.key, body)) {
+                g_cacheHits++;
+                reply(req, body, true);
+            } else if (req.n <= smallN && req.mode != "portfolio") {
+                auto added = batchOfMode.emplace(req.mode, jobs.size());
+                if (added.second) jobs.push_back(SolveJob{{}, true});
+                jobs[added.first->second].requests.push_back(req);
+            } else if (single.emplace(req.key, jobs.size()).second) {
+                jobs.push_back(SolveJob{{req}, false});
+            } else {
+                repeats.push_back(req);
+            }
+        }
+
+        const int numJobs = static_cast<int>(jobs.size());
+        if (numJobs == 1) {
+            runJob(jobs.front());
+        } else if (numJobs > 1) {
+            const int lanes = std::min(numJobs, teamSize);
+            #pragma omp parallel num_threads(lanes)
+            {
+                const int lane = omp_get_thread_num();
+                omp_set_num_threads(teamSize / lanes + (lane < teamSize % lanes ? 1 : 0));
+
+                #pragma omp for schedule(dynamic, 1)
+                for (int j = 0; j < numJobs; ++j) {
+                    runJob(jobs[static_cast<size_t>(j)]);
+                }
+            }
+        }
+
+        for (const SolveRequest& req : repeats) {
+            std::string body;
+            lookupCache(req.key, body);
+            g_cacheHits++;
+            reply(req, body, true);
+        }
+    }
+}
+
+// =============================================================================
+// CONNECTIONS
+// =============================================================================
+static void handleLine(const std::shared_ptr<Connection>& conn, const std::string& line) {
+    if (line.empty()) return;
+    const int fd = conn->fd;
+
+    if (line == "PING") {
+        sendLine(fd, "PONG");
+    } else if (line == "STATS") {
+        std::lock_guard<std::mutex> lock(g_cacheMutex);
+        sendLine(fd, "STATS requests=" + std::to_string(g_requests.load()) +
+                     " cache_hits=" + std::to_string(g_cacheHits.load()) +
+                     " cache_size=" + std::to_string(g_cache.size()));
+    } else if (line == "SHUTDOWN") {
+        sendLine(fd, "BYE");
+        g_running = false;
+        g_queueCv.notify_all();
+    } else if (line.rfind("SOLVE", 0) == 0) {
+        SolveRequest req;
+        std::string error;
+        if (!parseSolve(line, req, error)) {
+            sendLine(fd, "ERR " + error);
+            return;
+        }
+        req.conn = conn;
+        g_requests++;
+        {
+            std::lock_guard<std::mutex> lock(g_queueMutex);
+            g_queue.push_back(req);
+        }
+        g_queueCv.notify_one();
+    } else {
+        sendLine(fd, "ERR unknown command");
+    }
+}
+
+// The connection stays open until the client closes it; responses for
+// queued requests may arrive in any order (each echoes n and its result).
+// done is raised on exit so the accept loop can join the thread.
+static void connectionLoop(int fd, std::shared_ptr<std::atomic<bool>> done) {
+    auto conn = std::make_shared<Connection>(fd);
+    std::string buffer;
+    char chunk[4096];
+
+    while (g_running.load()) {
+        pollfd pfd{fd, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) continue;
+
+        ssize_t r = ::recv(fd, chunk, sizeof(chunk), 0);
+        if (r <= 0) break;
+        buffer.append(chunk, static_cast<size_t>(r));
+
+        size_t nl;
+        while ((nl = buffer.find('\n')) != std::string::npos) {
+            std::string line = buffer.substr(0, nl);
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            buffer.erase(0, nl + 1);
+            handleLine(conn, line);
+        }
+    }
+    done->store(true);
+}
+
+struct ClientThread {
+    std::thread thread;
+    std::shared_ptr<std::atomic<bool>> done;
+};
+
+// Join the threads of clients that have disconnected, so a long-running
+// daemon holds one thread per open connection rather than per connection
+// ever accepted. Queued requests keep their Connection alive on their own.
+static void reapConnections(std::vector<ClientThread>& connections) {
+    auto finished = [](ClientThread& c) {
+        if (!c.done->load()) return false;
+        c.thread.join();
+        return true;
+    };
+    connections.erase(std::remove_if(connections.begin(), connections.end(), finished),
+                      connections.end());
+}
+
+static int openSocket(const std::string& path, bool server) {
+    int fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+
+    if (server) {
+        ::unlink(path.c_str());
+        // Owner-only from creation on (umask), then explicitly (chmod)
+        const mode_t oldMask = ::umask(0077);
+        const bool bound = ::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) == 0;
+        ::umask(oldMask);
+        if (!bound || ::chmod(path.c_str(), 0600) < 0 || ::listen(fd, 64) < 0) {
+            ::close(fd);
+            return -1;
+        }
+    } else if (::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// =============================================================================
+// CLIENT MODE - Send one request, print one response
+// =============================================================================
+static int runQuery(const std::string& path, const std::string& query) {
+    int fd = openSocket(path, false);
+    if (fd < 0) {
+        std::cerr << "Error: cannot connect to " << path << std::endl;
+        return 1;
+    }
+    sendLine(fd, query);
+
+    std::string response;
+    char c;
+    while (::recv(fd, &c, 1, 0) == 1 && c != '\n') {
+        response += c;
+    }
+    ::close(fd);
+
+    std::cout << response << std::endl;
+    return response.rfind("ERR", 0) == 0 ? 1 : 0;
+}
+
+// Per-user default, so two users on one node never share (or hijack) a daemon
+static std::string defaultSocketPath() {
+    const char* runtimeDir = std::getenv("XDG_RUNTIME_DIR");
+    if (runtimeDir && *runtimeDir) {
+        return std::string(runtimeDir) + "/golomb_daemon.sock";
+    }
+    return "/tmp/golomb_daemon." + std::to_string(::getuid()) + ".sock";
+}
+
+int main(int argc, char* argv[])
+{
+    std::string socketPath = defaultSocketPath();
+    std::string cacheDir;
+    std::string query;
+    int smallN = DEFAULT_SMALL_N;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (arg.rfind("--socket=", 0) == 0) {
+            socketPath = value;
+        } else if (arg.rfind("--cache=", 0) == 0) {
+            cacheDir = value;
+        } else if (arg.rfind("--small-n=", 0) == 0) {
+            smallN = std::atoi(value.c_str());
+        } else if (arg.rfind("--query=", 0) == 0) {
+            query = value;
+        } else {
+            std::cerr << "Usage: " << argv[0]
+                      << " [--socket=PATH] [--cache=DIR] [--small-n=N] [--query=REQUEST]" << std::endl;
+            std::cerr << "  --socket=PATH : Unix socket, mode 0600 (default " << defaultSocketPath() << ")" << std::endl;
+            return 1;
+        }
+    }
+
+    if (!query.empty()) {
+        return runQuery(socketPath, query);
+    }
+
+    if (!cacheDir.empty()) {
+        std::filesystem::create_directories(cacheDir);
+        g_cacheFile = cacheDir + "/golomb_daemon_cache.tsv";
+        loadCache();
+    }
+
+    int serverFd = openSocket(socketPath, true);
+    if (serverFd < 0) {
+        std::cerr << "Error: cannot listen on " << socketPath << std::endl;
+        return 1;
+    }
+
+    std::cout << "=============================================================\n";
+    std::cout << "       GOLOMB SOLVER DAEMON (OpenMP V5)\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Socket     : " << socketPath << " (mode 0600)\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n";
+    std::cout << "Small n    : <= " << smallN << " (batched in one prefix pool)\n";
+    std::cout << "Cache      : " << (g_cacheFile.empty() ? "memory only" : g_cacheFile)
+              << " (" << g_cache.size() << " entries)\n";
+    std::cout << std::endl;
+
+    std::signal(SIGPIPE, SIG_IGN);
+
+    std::thread solver(solverLoop, smallN);
+    std::vector<ClientThread> connections;
+
+    while (g_running.load()) {
+        reapConnections(connections);
+        pollfd pfd{serverFd, POLLIN, 0};
+        if (::poll(&pfd, 1, 200) <= 0) continue;
+
+        int clientFd = ::accept(serverFd, nullptr, nullptr);
+        if (clientFd < 0) continue;
+        auto done = std::make_shared<std::atomic<bool>>(false);
+        connections.push_back({std::thread(connectionLoop, clientFd, done), done});
+    }
+
+    g_queueCv.notify_all();
+    solver.join();
+    for (ClientThread& c : connections) {
+        c.thread.join();
+    }
+
+    ::close(serverFd);
+    ::unlink(socketPath.c_str());
+
+    std::cout << "Served " << g_requests.load() << " requests ("
+              << g_cacheHits.load() << " cache hits)\n";
+    return 0;
+}
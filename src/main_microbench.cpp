@@ -0,0 +1,679 @@
+// Standard and shared headers at global scope first: the engine sources are
+// included below inside their own namespaces, where these includes are then
+// no-ops (include guards / #pragma once).
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <bitset>
+#include <atomic>
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <cmath>
+#include <omp.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#ifdef MICROBENCH_WITH_MPI
+#include <mpi.h>
+#endif
+#include "golomb.hpp"
+#include "bound_policy.hpp"
+#include "prefix_split.hpp"
+#include "prefix_trace.hpp"
+#include "simd_bitset.hpp"
+#include "pattern_db.hpp"   // POSIX mmap headers must not land in a namespace
+#ifdef MICROBENCH_WITH_MPI
+#include "hypercube.hpp"
+#endif
+
+// =============================================================================
+// MICROBENCHMARKS - Bitset primitives and kernel building blocks
+// =============================================================================
+// Measures, for every bitset flavour used by the engines:
+//   shift          : reversed_marks << offset, variable offsets
+//   conflict       : (a & b).any() on prepared pairs
+//   shift_conflict : full candidate test (new_dist & used_dist).any()
+//   push_pop       : child frame construction + pop, as in the iterative kernels
+//   extract_marks  : reversed_marks -> marks array (push_pop also for the
+//                    wide long-ruler state: copy-per-frame vs in place)
+//   prefix_gen     : fixed-depth prefix generation (ns per emitted prefix)
+//
+// The engine sources are compiled into this translation unit, each inside its
+// own namespace, so the benchmarks exercise the exact BitSet / StackFrame /
+// extractMarks / generatePrefixes code of the engines (all static there).
+// The MPI engines need mpicxx (make microbench_mpi): skipped otherwise.
+// simd_* rows measure each backend of simd_bitset.hpp available on the
+// target (the engines use the one selected at build time).
+//
+// Output: table on stdout + rows appended to benchmarks/microbench.csv
+//   timestamp,impl,primitive,flags,ops,ns_per_op,tsc_per_op
+// flags is the compiler flag set (-DMICROBENCH_FLAGS, see make microbench-sweep).
+// tsc_per_op is in time-stamp counter ticks (NA off x86).
+// =============================================================================
+
+namespace mb_v5 {
+#include "search_v5.cpp"
+}
+#undef POPCOUNT64
+
+namespace mb_seq2 {
+#include "search_sequential_v2.cpp"
+}
+
+namespace mb_seq3 {
+#include "search_sequential_v3.cpp"
+}
+#undef PREFETCH
+
+namespace mb_seq4 {
+#include "search_sequential_v4.cpp"
+}
+
+namespace mb_omp4 {
+#include "search_v4.cpp"
+}
+
+#ifdef MICROBENCH_WITH_MPI
+namespace mb_mpi2 {
+#include "search_mpi_v2.cpp"
+}
+
+namespace mb_mpi3 {
+#include "search_mpi_v3.cpp"
+}
+#endif
+
+#ifndef MICROBENCH_FLAGS
+#define MICROBENCH_FLAGS "default"
+#endif
+
+// =============================================================================
+// TIMING
+// =============================================================================
+template <typename T>
+static inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+static inline uint64_t readTsc() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static constexpr bool HAS_TSC =
+#if defined(__x86_64__) || defined(__i386__)
+    true;
+#else
+    false;
+#endif
+
+struct Measurement {
+    long long ops = 0;
+    double nsPerOp = 0.0;
+    double tscPerOp = 0.0;
+};
+
+// Best of `trials` runs of body(), which performs `ops` operations
+template <typename Body>
+static Measurement measure(long long ops, int trials, Body&& body) {
+    body();  // Warm-up (caches, branch predictors, page faults)
+
+    Measurement m;
+    m.ops = ops;
+    m.nsPerOp = 1e300;
+    m.tscPerOp = 1e300;
+    for (int t = 0; t < trials; ++t) {
+        const uint64_t c0 = readTsc();
+        const auto t0 = std::chrono::steady_clock::now();
+        body();
+        const auto t1 = std::chrono::steady_clock::now();
+        const uint64_t c1 = readTsc();
+
+        const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        m.nsPerOp = std::min(m.nsPerOp, ns / ops);
+        m.tscPerOp = std::min(m.tscPerOp, static_cast<double>(c1 - c0) / ops);
+    }
+    return m;
+}
+
+// =============================================================================
+// BITSET ADAPTERS - Uniform view over the engine bitsets
+// =============================================================================
+template <typename B>
+struct BitOps {
+    static B make(uint64_t lo, uint64_t hi) { return B(lo, hi); }
+    static B shl(const B& b, int n) { return b << n; }
+    static bool conflict(const B& a, const B& b) { return (a & b).any(); }
+    static B xorWith(const B& a, const B& b) { return a ^ b; }
+};
+
+template <>
+struct BitOps<std::bitset<MAX_DIFF>> {
+    using B = std::bitset<MAX_DIFF>;
+    static B make(uint64_t lo, uint64_t hi) { return (B(hi) << 64) | B(lo); }
+    static B shl(const B& b, int n) { return b << n; }
+    static bool conflict(const B& a, const B& b) { return (a & b).any(); }
+    static B xorWith(const B& a, const B& b) { return a ^ b; }
+};
+
+// Frame and extractMarks for the bare simd_bitset.hpp backends
+template <typename B>
+struct alignas(64) SimdFrame {
+    B reversed_marks;
+    B used_dist;
+    int marks_count;
+    int ruler_length;
+    int next_candidate;
+};
+
+template <typename B>
+static void extractMarksSimd(const B& reversed_marks, int ruler_length, int* marks, int& numMarks) {
+    numMarks = 0;
+    for (int i = 0; i <= ruler_length; ++i) {
+        if (reversed_marks.test(ruler_length - i)) {
+            marks[numMarks++] = i;
+        }
+    }
+}
+
+// =============================================================================
+// INPUTS - Real search states: V5 prefixes of an n-mark search
+// =============================================================================
+struct InputState {
+    uint64_t marks_lo, marks_hi;
+    uint64_t dist_lo, dist_hi;
+    int ruler_length;
+    int offset;  // Candidate offset for shift / conflict tests
+};
+
+static std::vector<InputState> buildInputs(int n, int maxLen, int depth, size_t limit) {
+    using namespace mb_v5;
+    std::vector<WorkItemV5> prefixes;
+    BitSet128 reversed_marks, used_dist;
+    reversed_marks.set(0);
+    generatePrefixesV5(reversed_marks, used_dist, 1, 0, depth, n, maxLen + 1, prefixes);
+
+    // Evenly spaced over the DFS order, not only the leftmost subtrees
+    const size_t stride = std::max<size_t>(1, prefixes.size() / limit);
+    uint64_t rng = 0x5EED;
+    std::vector<InputState> inputs;
+    for (size_t i = 0; i < prefixes.size() && inputs.size() < limit; i += stride) {
+        const WorkItemV5& p = prefixes[i];
+        const int room = std::max(1, std::min(64, maxLen - p.ruler_length));
+        inputs.push_back(InputState{p.reversed_marks.lo(), p.reversed_marks.hi(),
+                                    p.used_dist.lo(), p.used_dist.hi(), p.ruler_length,
+                                    1 + static_cast<int>(prefix_split::splitmix64(rng) % room)});
+    }
+    return inputs;
+}
+
+// =============================================================================
+// RESULTS
+// =============================================================================
+struct Row {
+    std::string impl;
+    std::string primitive;
+    Measurement m;
+};
+
+struct BenchConfig {
+    int n = 12;           // Marks of the search the inputs come from
+    int prefixDepth = 5;  // Depth of the generated prefixes (prefix_gen)
+    int reps = 200;       // Passes over the input set per measurement
+    int trials = 5;
+    std::string filter;   // Only implementations containing this string
+};
+
+// Known optimal lengths (prefix generation bound)
+static const int KNOWN_OPTIMAL_MB[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+
+// =============================================================================
+// GENERIC SUITE - Bitset primitives, frame push/pop, extractMarks
+// =============================================================================
+template <typename B, typename Frame, typename Extract>
+static void runBitsetSuite(const std::string& impl, const std::vector<InputState>& inputs,
+                           const BenchConfig& config, Extract extract, std::vector<Row>& rows) {
+    using Ops = BitOps<B>;
+    const size_t count = inputs.size();
+    const long long ops = static_cast<long long>(count) * config.reps;
+
+    std::vector<B> marks(count), dist(count);
+    std::vector<int> offsets(count);
+    for (size_t i = 0; i < count; ++i) {
+        marks[i] = Ops::make(inputs[i].marks_lo, inputs[i].marks_hi);
+        dist[i] = Ops::make(inputs[i].dist_lo, inputs[i].dist_hi);
+        offsets[i] = inputs[i].offset;
+    }
+
+    // --- shift by variable offsets ---
+    rows.push_back({impl, "shift", measure(ops, config.trials, [&]() {
+        B acc = Ops::make(0, 0);
+        for (int r = 0; r < config.reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                acc = Ops::xorWith(acc, Ops::shl(marks[i], offsets[i]));
+            }
+        }
+        doNotOptimize(acc);
+    })});
+
+    // --- conflict test on prepared pairs ---
+    rows.push_back({impl, "conflict", measure(ops, config.trials, [&]() {
+        long long hits = 0;
+        for (int r = 0; r < config.reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                hits += Ops::conflict(marks[i], dist[i]);
+            }
+        }
+        doNotOptimize(hits);
+    })});
+
+    // --- candidate test: shift + conflict ---
+    rows.push_back({impl, "shift_conflict", measure(ops, config.trials, [&]() {
+        long long hits = 0;
+        for (int r = 0; r < config.reps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                hits += Ops::conflict(Ops::shl(marks[i], offsets[i]), dist[i]);
+            }
+        }
+        doNotOptimize(hits);
+    })});
+
+    // --- push/pop: child frame construction as in the kernels, DEPTH levels
+    //     down then back up (one op = one push + one pop) ---
+    constexpr int DEPTH = 8;
+    std::vector<Frame> stack(DEPTH + 1);
+    rows.push_back({impl, "push_pop", measure(ops, config.trials, [&]() {
+        long long resumed = 0;
+        for (int r = 0; r < config.reps; ++r) {
+            for (size_t i = 0; i + DEPTH <= count; i += DEPTH) {
+                Frame& root = stack[0];
+                root.reversed_marks = marks[i];
+                root.used_dist = dist[i];
+                root.marks_count = 1;
+                root.ruler_length = inputs[i].ruler_length;
+                root.next_candidate = root.ruler_length + 1;
+
+                for (int d = 0; d < DEPTH; ++d) {
+                    const Frame& cur = stack[d];
+                    Frame& child = stack[d + 1];
+                    const int offset = 1 + (offsets[i + d] & 7);
+                    const B new_dist = Ops::shl(cur.reversed_marks, offset);
+                    child.reversed_marks = new_dist;
+                    child.reversed_marks.set(0);
+                    child.used_dist = Ops::xorWith(cur.used_dist, new_dist);
+                    child.marks_count = cur.marks_count + 1;
+                    child.ruler_length = cur.ruler_length + offset;
+                    child.next_candidate = child.ruler_length + 1;
+                }
+                for (int d = DEPTH; d > 0; --d) {
+                    resumed += stack[d - 1].next_candidate++;
+                }
+            }
+        }
+        doNotOptimize(resumed);
+        doNotOptimize(stack[DEPTH]);
+    })});
+    // Pushes performed per pass are rounded down to whole DEPTH blocks
+    rows.back().m.nsPerOp *= static_cast<double>(count) / (count / DEPTH * DEPTH);
+    rows.back().m.tscPerOp *= static_cast<double>(count) / (count / DEPTH * DEPTH);
+
+    // --- extractMarks ---
+    const int extractReps = std::max(1, config.reps / 10);
+    rows.push_back({impl, "extract_marks", measure(static_cast<long long>(count) * extractReps,
+                                                   config.trials, [&]() {
+        int out[MAX_DIFF];
+        int numMarks = 0;
+        long long total = 0;
+        for (int r = 0; r < extractReps; ++r) {
+            for (size_t i = 0; i < count; ++i) {
+                extract(marks[i], inputs[i].ruler_length, out, numMarks);
+                total += numMarks + out[numMarks - 1];
+            }
+        }
+        doNotOptimize(total);
+    })});
+}
+
+// =============================================================================
+// WIDE PUSH / POP - Long-ruler shift state (search_wide.cpp), per W
+// =============================================================================
+// copy    : child frame per level, shift + copy + OR over all W words (as V5)
+// inplace : wideMake / wideUnmake on one state, words of the ruler length only
+//           (includes the reset of the marks, 1 per path)
+// A path of `depth` pushes then as many pops (one op = push + pop), from a
+// ruler of length BITS / 4, offsets up to BITS / (2 depth). In copy mode the
+// stack is depth x 2 W words: 24 KB at W = 64 for 12 levels (L1-resident),
+// 96 KB for 48 (a 50-mark search, not).
+// =============================================================================
+template <int W>
+static void runWidePushPop(int depth, const BenchConfig& config, std::vector<Row>& rows) {
+    using Bits = simd_bits::WideBitSet<W>;
+    struct Frame {
+        Bits rev;
+        Bits used;
+    };
+
+    constexpr int PATHS = 64;
+    const int baseLen = Bits::BITS / 4;
+    const int maxStep = std::max(1, Bits::BITS / (2 * depth));
+    uint64_t rng = 0x5EED + W;
+    std::vector<int> offsets(static_cast<size_t>(PATHS) * depth);
+    for (int& offset : offsets) {
+        offset = 1 + static_cast<int>(prefix_split::splitmix64(rng) % maxStep);
+    }
+
+    Bits baseRev, baseUsed;
+    baseRev.set(0);
+    baseRev.set(baseLen);
+    baseUsed.set(baseLen);
+
+    const long long ops = static_cast<long long>(PATHS) * depth * config.reps;
+    const std::string prefix = "wide" + std::to_string(W) + "_d" + std::to_string(depth);
+
+    std::vector<Frame> stack(static_cast<size_t>(depth) + 1);
+    rows.push_back({prefix + "_copy", "push_pop", measure(ops, config.trials, [&]() {
+        long long total = 0;
+        for (int r = 0; r < config.reps; ++r) {
+            for (int p = 0; p < PATHS; ++p) {
+                const int* path = &offsets[static_cast<size_t>(p) * depth];
+                stack[0].rev = baseRev;
+                stack[0].used = baseUsed;
+                for (int d = 0; d < depth; ++d) {
+                    const Frame& cur = stack[static_cast<size_t>(d)];
+                    Frame& child = stack[static_cast<size_t>(d) + 1];
+                    cur.rev.shiftLeftInto(path[d], child.rev);
+                    child.used = cur.used;
+                    child.used.orWith(child.rev);
+                    child.rev.set(0);
+                }
+                for (int d = depth; d > 0; --d) {
+                    total += static_cast<long long>(stack[static_cast<size_t>(d) - 1].used.w[0] & 1);
+                }
+            }
+        }
+        doNotOptimize(total);
+        doNotOptimize(stack[static_cast<size_t>(depth)]);
+    })});
+
+    Bits fixedMarks, used;
+    rows.push_back({prefix + "_inplace", "push_pop", measure(ops, config.trials, [&]() {
+        long long total = 0;
+        for (int r = 0; r < config.reps; ++r) {
+            for (int p = 0; p < PATHS; ++p) {
+                const int* path = &offsets[static_cast<size_t>(p) * depth];
+                fixedMarks.reset();
+                fixedMarks.set(Bits::BITS - 1);
+                fixedMarks.set(Bits::BITS - 1 - baseLen);
+                used = baseUsed;
+                int len = baseLen;
+                for (int d = 0; d < depth; ++d) {
+                    len += path[d];
+                    simd_bits::wideMake(fixedMarks, used, len, (len >> 6) + 1);
+                }
+                for (int d = depth - 1; d >= 0; --d) {
+                    simd_bits::wideUnmake(fixedMarks, used, len, (len >> 6) + 1);
+                    len -= path[d];
+                    total += static_cast<long long>(used.w[0] & 1);
+                }
+            }
+        }
+        doNotOptimize(total);
+        doNotOptimize(fixedMarks);
+        doNotOptimize(used);
+    })});
+}
+
+// =============================================================================
+// PREFIX GENERATION RATE
+// =============================================================================
+template <typename Generate>
+static void runPrefixGeneration(const std::string& impl, const BenchConfig& config,
+                                Generate generate, std::vector<Row>& rows) {
+    const int maxLen = KNOWN_OPTIMAL_MB[config.n] + 1;  // Exclusive bound, as the drivers
+    const long long produced = generate(maxLen);
+    if (produced <= 0) return;
+
+    rows.push_back({impl, "prefix_gen", measure(produced, config.trials, [&]() {
+        doNotOptimize(generate(maxLen));
+    })});
+}
+
+// =============================================================================
+// DRIVER
+// =============================================================================
+static bool selected(const BenchConfig& config, const std::string& impl) {
+    return config.filter.empty() || impl.find(config.filter) != std::string::npos;
+}
+
+static void runAll(const BenchConfig& config, std::vector<Row>& rows) {
+    const int n = config.n;
+    const int depth = config.prefixDepth;
+    const std::vector<InputState> inputs = buildInputs(n, KNOWN_OPTIMAL_MB[n], depth, 4096);
+
+    if (selected(config, "v5")) {
+        using namespace mb_v5;
+        runBitsetSuite<BitSet128, StackFrameV5>("v5", inputs, config, extractMarksV5, rows);
+        runPrefixGeneration("v5", config, [&](int maxLen) {
+            std::vector<WorkItemV5> prefixes;
+            BitSet128 reversed_marks, used_dist;
+            reversed_marks.set(0);
+            generatePrefixesV5(reversed_marks, used_dist, 1, 0, depth, n, maxLen, prefixes);
+            return static_cast<long long>(prefixes.size());
+        }, rows);
+    }
+    if (selected(config, "v5_adaptive")) {
+        using namespace mb_v5;
+        // Includes the random-probe cost estimates; roughly as many prefixes
+        // as the fixed split for a 64-thread run
+        runPrefixGeneration("v5_adaptive", config, [&](int maxLen) {
+            std::vector<WorkItemV5> prefixes;
+            generatePrefixesAdaptive<BitSet128, WorkItemV5>(
+                n, maxLen, 64, 64, 16, prefixes);
+            return static_cast<long long>(prefixes.size());
+        }, rows);
+    }
+    if (selected(config, "seq_v2")) {
+        using namespace mb_seq2;
+        runBitsetSuite<BitSet128, StackFrameV2>("seq_v2", inputs, config, extractMarks, rows);
+    }
+    if (selected(config, "seq_v3_simd")) {
+        using namespace mb_seq3;
+        runBitsetSuite<BitSet128SIMD, StackFrameV3>("seq_v3_simd", inputs, config, extractMarks, rows);
+    }
+    if (selected(config, "simd_scalar")) {
+        using B = simd_bits::Bits128Scalar;
+        runBitsetSuite<B, SimdFrame<B>>("simd_scalar", inputs, config, extractMarksSimd<B>, rows);
+    }
+#ifdef GOLOMB_SIMD_HAVE_SSE
+    if (selected(config, "simd_sse")) {
+        using B = simd_bits::Bits128Sse;
+        runBitsetSuite<B, SimdFrame<B>>("simd_sse", inputs, config, extractMarksSimd<B>, rows);
+    }
+#endif
+#ifdef GOLOMB_SIMD_HAVE_NEON
+    if (selected(config, "simd_neon")) {
+        using B = simd_bits::Bits128Neon;
+        runBitsetSuite<B, SimdFrame<B>>("simd_neon", inputs, config, extractMarksSimd<B>, rows);
+    }
+#endif
+    if (selected(config, "seq_v4")) {
+        using namespace mb_seq4;
+        runBitsetSuite<BitSet128V4, StackFrameV4>("seq_v4", inputs, config, extractMarksV4, rows);
+    }
+    if (selected(config, "omp_v4_bitset256")) {
+        using namespace mb_omp4;
+        runBitsetSuite<std::bitset<MAX_DISTANCE_V4>, StackFrameV4>(
+            "omp_v4_bitset256", inputs, config, extractMarksV4, rows);
+        runPrefixGeneration("omp_v4_bitset256", config, [&](int maxLen) {
+            std::vector<WorkItemV4> prefixes;
+            std::bitset<MAX_DISTANCE_V4> reversed_marks, used_dist;
+            reversed_marks.set(0);
+            generatePrefixes(reversed_marks, used_dist, 1, 0, depth, n, maxLen, prefixes);
+            return static_cast<long long>(prefixes.size());
+        }, rows);
+    }
+    if (selected(config, "wide")) {
+        for (int depth : {12, 48}) {
+            runWidePushPop<4>(depth, config, rows);
+            runWidePushPop<16>(depth, config, rows);
+            runWidePushPop<64>(depth, config, rows);
+        }
+    }
+#ifdef MICROBENCH_WITH_MPI
+    if (selected(config, "mpi_v2")) {
+        using namespace mb_mpi2;
+        runBitsetSuite<BitSet128, StackFrameMPI_V2>("mpi_v2", inputs, config, extractMarksMPI_V2, rows);
+        runPrefixGeneration("mpi_v2", config, [&](int maxLen) {
+            std::vector<WorkItemMPI_V2> prefixes;
+            BitSet128 reversed_marks, used_dist;
+            reversed_marks.set(0);
+            generatePrefixesMPI_V2(reversed_marks, used_dist, 1, 0, depth, n, maxLen, prefixes);
+            return static_cast<long long>(prefixes.size());
+        }, rows);
+    }
+    if (selected(config, "mpi_v3")) {
+        using namespace mb_mpi3;
+        runBitsetSuite<BitSet128_V3, StackFrameMPI_V3>("mpi_v3", inputs, config, extractMarksMPI_V3, rows);
+        runPrefixGeneration("mpi_v3", config, [&](int maxLen) {
+            std::vector<WorkItemMPI_V3> prefixes;
+            BitSet128_V3 reversed_marks, used_dist;
+            reversed_marks.set(0);
+            generatePrefixesMPI_V3(reversed_marks, used_dist, 1, 0, depth, n, maxLen, prefixes);
+            return static_cast<long long>(prefixes.size());
+        }, rows);
+    }
+#endif
+}
+
+static std::string timestampNow() {
+    auto now = std::chrono::system_clock::now();
+    auto time = std::chrono::system_clock::to_time_t(now);
+    std::tm tm = *std::localtime(&time);
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
+
+static bool appendCsv(const std::string& path, const std::vector<Row>& rows) {
+    const bool exists = std::filesystem::exists(path);
+    std::ofstream file(path, std::ios::app);
+    if (!file) return false;
+
+    if (!exists) {
+        file << "timestamp,impl,primitive,flags,ops,ns_per_op,tsc_per_op\n";
+    }
+    const std::string timestamp = timestampNow();
+    for (const Row& row : rows) {
+        file << timestamp << "," << row.impl << "," << row.primitive << ",\""
+             << MICROBENCH_FLAGS << "\"," << row.m.ops << ","
+             << std::fixed << std::setprecision(3) << row.m.nsPerOp << ",";
+        if (HAS_TSC) {
+            file << row.m.tscPerOp;
+        } else {
+            file << "NA";
+        }
+        file << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+static void printUsage(const char* prog) {
+    std::cout << "Usage: " << prog << " [options]\n"
+              << "  --n=N          marks of the search providing the inputs (default 12)\n"
+              << "  --depth=D      prefix depth for inputs and prefix_gen (default 5)\n"
+              << "  --reps=R       passes over the inputs per measurement (default 200)\n"
+              << "  --trials=T     measurements per primitive, best kept (default 5)\n"
+              << "  --impl=NAME    only implementations whose name contains NAME\n"
+              << "  --csv=FILE     CSV output (default benchmarks/microbench.csv)\n"
+              << "  --no-csv       print only\n";
+}
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    std::string csvPath = "benchmarks/microbench.csv";
+    bool writeCsv = true;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg.rfind("--n=", 0) == 0) {
+            config.n = std::atoi(arg.c_str() + 4);
+        } else if (arg.rfind("--depth=", 0) == 0) {
+            config.prefixDepth = std::atoi(arg.c_str() + 8);
+        } else if (arg.rfind("--reps=", 0) == 0) {
+            config.reps = std::max(1, std::atoi(arg.c_str() + 7));
+        } else if (arg.rfind("--trials=", 0) == 0) {
+            config.trials = std::max(1, std::atoi(arg.c_str() + 9));
+        } else if (arg.rfind("--impl=", 0) == 0) {
+            config.filter = arg.substr(7);
+        } else if (arg.rfind("--csv=", 0) == 0) {
+            csvPath = arg.substr(6);
+        } else if (arg == "--no-csv") {
+            writeCsv = false;
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    const int maxN = sizeof(KNOWN_OPTIMAL_MB) / sizeof(KNOWN_OPTIMAL_MB[0]) - 1;
+    if (config.n < 4 || config.n > maxN) {
+        std::cerr << "n must be between 4 and " << maxN << std::endl;
+        return 1;
+    }
+    if (config.prefixDepth < 2 || config.prefixDepth >= config.n) {
+        std::cerr << "depth must be between 2 and n-1" << std::endl;
+        return 1;
+    }
+
+    std::cout << "===========================================" << std::endl;
+    std::cout << " GOLOMB MICROBENCHMARKS" << std::endl;
+    std::cout << "===========================================" << std::endl;
+    std::cout << "Flags    : " << MICROBENCH_FLAGS << std::endl;
+    std::cout << "SIMD     : " << GOLOMB_SIMD_BACKEND << " (engines)" << std::endl;
+    std::cout << "Inputs   : n=" << config.n << " prefixes at depth " << config.prefixDepth
+              << ", " << config.reps << " passes, best of " << config.trials << std::endl;
+    std::cout << std::endl;
+
+    std::vector<Row> rows;
+    runAll(config, rows);
+
+    std::cout << std::left << std::setw(20) << "impl" << std::setw(16) << "primitive"
+              << std::right << std::setw(14) << "ops" << std::setw(12) << "ns/op"
+              << std::setw(12) << "tsc/op" << std::endl;
+    std::cout << std::string(74, '-') << std::endl;
+    for (const Row& row : rows) {
+        std::cout << std::left << std::setw(20) << row.impl << std::setw(16) << row.primitive
+                  << std::right << std::setw(14) << row.m.ops
+                  << std::fixed << std::setprecision(3) << std::setw(12) << row.m.nsPerOp;
+        if (HAS_TSC) {
+            std::cout << std::setprecision(2) << std::setw(12) << row.m.tscPerOp;
+        } else {
+            std::cout << std::setw(12) << "NA";
+        }
+        std::cout << std::endl;
+    }
+
+    if (writeCsv) {
+        if (appendCsv(csvPath, rows)) {
+            std::cout << std::endl << "CSV      : " << csvPath << std::endl;
+        } else {
+            std::cerr << "Error: cannot write " << csvPath << std::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,5 +1,6 @@
 #include "search_mpi.hpp"
 #include "benchmark_log.hpp"
+#include "energy_meter_mpi.hpp"
 #include <iostream>
 #include <chrono>
 #include <vector>
@@ -103,6 +104,10 @@ int main(int argc, char** argv) {
     int ompThreads = omp_get_max_threads();
     int totalCores = size * ompThreads;
 
+    EnergyMeter meter;
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+
     if (rank == 0) {
         std::cout << "=== Optimal Golomb Ruler MPI+OpenMP Hybrid Benchmark ===\n";
         std::cout << "Mode: " << MODE_NAME << "\n";
@@ -122,20 +127,24 @@ int main(int argc, char** argv) {
                   << std::setw(10) << "Length"
                   << std::setw(15) << "Time (s)"
                   << std::setw(20) << "Explored States"
-                  << std::setw(15) << "States/sec" << std::endl;
-        std::cout << std::string(66, '-') << std::endl;
+                  << std::setw(15) << "States/sec"
+                  << std::setw(14) << "Energy (J)"
+                  << std::setw(14) << "States/J" << std::endl;
+        std::cout << std::string(94, '-') << std::endl;
     }
 
     for (int n : sizes) {
         MPI_Barrier(MPI_COMM_WORLD);
 
         GolombRuler best;
+        meter.start();
         double start = MPI_Wtime();
 
         searchGolombMPI(n, maxLen, best, hypercube);
 
         double end = MPI_Wtime();
         double elapsed = end - start;
+        const EnergyReading energy = reduceEnergy(meter.stop(), nodeComm);
 
         double maxTime;
         MPI_Reduce(&elapsed, &maxTime, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
@@ -150,17 +159,25 @@ int main(int argc, char** argv) {
                       << std::setw(10) << best.length
                       << std::setw(15) << std::fixed << std::setprecision(3) << maxTime
                       << std::setw(20) << exploredStates
-                      << std::setw(15) << std::scientific << std::setprecision(2) << statesPerSec
-                      << std::endl;
+                      << std::setw(15) << std::scientific << std::setprecision(2) << statesPerSec;
+            if (energy.valid) {
+                std::cout << std::setw(14) << std::fixed << energy.totalJ()
+                          << std::setw(14) << std::scientific << (exploredStates / energy.totalJ());
+            } else {
+                std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a";
+            }
+            std::cout << std::endl;
 
             // Log to CSV - speedup et efficiency seront calculés à partir des données CSV
             logger->logMPI(n, size, ompThreads, best.length, maxTime, 1.0, 100.0 / totalCores,
-                          exploredStates, CHANGES);
+                          exploredStates, CHANGES, energy);
         }
 
         MPI_Barrier(MPI_COMM_WORLD);
     }
 
+    MPI_Comm_free(&nodeComm);
+
     if (rank == 0) {
         std::cout << "\n[Results saved to benchmarks/mpi_benchmark.csv]\n";
         std::cout << "=== Benchmark Complete ===\n";
@@ -1,9 +1,131 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <mpi.h>
 #include <omp.h>
 #include "search_mpi_v3.hpp"
+#include "benchmark_log.hpp"
+#include "energy_meter_mpi.hpp"
+
+// Known optimal lengths for validation
+static const int KNOWN_OPTIMAL_MPI_V3[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+static const int MAX_KNOWN_MPI_V3 = sizeof(KNOWN_OPTIMAL_MPI_V3) / sizeof(KNOWN_OPTIMAL_MPI_V3[0]) - 1;
+
+static std::string formatTimelineMPI_V3(const std::vector<BoundEventMPI_V3>& timeline)
+{
+    std::ostringstream oss;
+    oss << std::fixed << std::setprecision(4);
+    for (size_t i = 0; i < timeline.size(); ++i) {
+        oss << (i > 0 ? ";" : "") << timeline[i].length << "@" << timeline[i].time;
+    }
+    return oss.str();
+}
+
+// =============================================================================
+// SLACK SWEEP - Same search with the initial bound at optimum + k
+// =============================================================================
+// One run per k (all ranks), timeline merged on rank 0: first solution,
+// bound improvements, states and time in benchmarks/bound_slack_benchmark.csv
+// =============================================================================
+static int runSlackSweepMPI_V3(int n, const std::vector<int>& slacks, const SearchOptionsMPI_V3& options,
+                               const std::string& note)
+{
+    int rank, size;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    const int threads = omp_get_max_threads();
+
+    EnergyMeter meter;  // Every rank measures, one reporter per node
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
+
+    if (rank == 0) {
+        std::cout << "===========================================" << std::endl;
+        std::cout << " MPI V3 BOUND-SLACK SWEEP (n = " << n << ", optimum "
+                  << KNOWN_OPTIMAL_MPI_V3[n] << ")" << std::endl;
+        std::cout << "===========================================" << std::endl;
+        std::cout << "MPI processes: " << size << ", OpenMP threads per process: " << threads << std::endl;
+        std::cout << "Config: " << note << std::endl;
+        std::cout << "Energy: " << (meter.available() ? meter.source() : std::string("n/a (no readable RAPL counters)"))
+                  << std::endl << std::endl;
+        std::cout << std::setw(6) << "slack" << std::setw(6) << "bound" << " " << std::setw(8) << "length"
+                  << std::setw(11) << "time(s)" << std::setw(12) << "first(s)" << std::setw(15) << "states"
+                  << std::setw(9) << "updates" << "  timeline" << std::endl;
+        std::cout << std::string(78, '-') << std::endl;
+    }
+
+    std::unique_ptr<BenchmarkLog> logger;  // Rank 0 writes the CSV
+    if (rank == 0) logger = std::make_unique<BenchmarkLog>("benchmarks", "bound_slack");
+    bool allOptimal = true;
+    bool anyClamped = false;
+
+    for (int slack : slacks) {
+        // The engine clamps the bound: log the bound actually searched
+        const bool clamped = KNOWN_OPTIMAL_MPI_V3[n] + slack > MAX_LEN_MPI_V3;
+        const int maxLen = clamped ? MAX_LEN_MPI_V3 : KNOWN_OPTIMAL_MPI_V3[n] + slack;
+        anyClamped = anyClamped || clamped;
+        GolombRuler best;
+
+        MPI_Barrier(MPI_COMM_WORLD);
+        meter.start();
+        const auto start = std::chrono::high_resolution_clock::now();
+        searchGolombMPI_V3(n, maxLen, best, options);
+        MPI_Barrier(MPI_COMM_WORLD);
+        const auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = reduceEnergy(meter.stop(), nodeComm);
+        const double elapsed = std::chrono::duration<double>(end - start).count();
+        const long long states = getExploredCountMPI_V3();
+
+        if (rank == 0) {
+            const std::vector<BoundEventMPI_V3>& timeline = getBoundTimelineMPI_V3();
+            const std::string timelineText = formatTimelineMPI_V3(timeline);
+            const double firstSolution = timeline.empty() ? -1.0 : timeline.front().time;
+            const bool optimal = best.length == KNOWN_OPTIMAL_MPI_V3[n] && GolombRuler::isValid(best.marks);
+            allOptimal = allOptimal && optimal;
+
+            std::cout << std::setw(6) << slack << std::setw(6) << maxLen << (clamped ? "*" : " ")
+                      << std::setw(8) << best.length << std::fixed << std::setprecision(3) << std::setw(11) << elapsed;
+            if (firstSolution >= 0.0) {
+                std::cout << std::setw(12) << std::setprecision(4) << firstSolution;
+            } else {
+                std::cout << std::setw(12) << "-";
+            }
+            std::cout << std::setw(15) << states << std::setw(9) << timeline.size()
+                      << "  " << timelineText << (optimal ? "" : "  (NOT OPTIMAL)") << std::endl;
+
+            logger->logSlack("mpi_v3", n, size, threads, slack, maxLen, best.length, elapsed,
+                             firstSolution, states, static_cast<int>(timeline.size()), timelineText, note,
+                             energy);
+        }
+    }
+    MPI_Comm_free(&nodeComm);
+
+    if (rank == 0) {
+        std::cout << std::string(78, '-') << std::endl;
+        if (anyClamped) {
+            std::cout << "* optimum + slack exceeds " << MAX_LEN_MPI_V3
+                      << ": bound clamped (128-bit distance set)" << std::endl;
+        }
+        std::cout << "[Results saved to benchmarks/bound_slack_benchmark.csv]" << std::endl;
+    }
+    return allOptimal ? 0 : 1;
+}
+
+static void printUsageMPI_V3(const char* program)
+{
+    std::cerr << "Usage: mpiexec -n <P> " << program << " <n> [adaptive] [options]" << std::endl;
+    std::cerr << "  --deterministic : smallest optimal ruler and node count independent of P x threads" << std::endl;
+    std::cerr << "  --trace=FILE  : write per-prefix costs (CSV) for golomb_schedsim" << std::endl;
+    std::cerr << "  --bound-policy=atomic|cached|epoch|numa : how threads read the shared bound" << std::endl;
+    std::cerr << "  --bound-refresh=K : cached policy, nodes between two reads (default "
+              << DEFAULT_BOUND_REFRESH << ")" << std::endl;
+    std::cerr << "  --slack=K     : start from bound = known optimum + K (loose bound)" << std::endl;
+    std::cerr << "  --slack-sweep=K1,K2,... : one run per slack, rows in benchmarks/bound_slack_benchmark.csv" << std::endl;
+}
 
 int main(int argc, char* argv[])
 {
@@ -14,6 +136,49 @@ int main(int argc, char* argv[])
     MPI_Comm_size(MPI_COMM_WORLD, &size);
 
     int n = 11;
+    SearchOptionsMPI_V3 options;
+    std::string tracePath;
+    int slack = 0;
+    std::vector<int> slackSweep;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (arg == "adaptive") {
+            options.adaptiveSplit = true;
+        } else if (arg == "--deterministic") {
+            options.deterministic = true;
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            tracePath = value;
+        } else if (arg.rfind("--bound-policy=", 0) == 0) {
+            if (!parseBoundPolicy(value, options.boundPolicy)) {
+                if (rank == 0) {
+                    std::cerr << "Unknown bound policy " << value << std::endl;
+                }
+                MPI_Finalize();
+                return 1;
+            }
+        } else if (arg.rfind("--bound-refresh=", 0) == 0) {
+            options.boundRefresh = std::atoi(value.c_str());
+        } else if (arg.rfind("--slack=", 0) == 0) {
+            slack = std::atoi(value.c_str());
+        } else if (arg.rfind("--slack-sweep=", 0) == 0) {
+            std::istringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (!item.empty()) slackSweep.push_back(std::atoi(item.c_str()));
+            }
+        } else {
+            if (rank == 0) {
+                std::cerr << "Unknown option " << argv[i] << std::endl;
+                printUsageMPI_V3(argv[0]);
+            }
+            MPI_Finalize();
+            return 1;
+        }
+    }
+    options.recordPrefixCosts = !tracePath.empty();
     if (argc > 1) {
         n = std::atoi(argv[1]);
         if (n < 2 || n > 24) {
@@ -25,6 +190,25 @@ int main(int argc, char* argv[])
         }
     }
 
+    if (!slackSweep.empty()) {
+        if (n > MAX_KNOWN_MPI_V3) {
+            if (rank == 0) {
+                std::cerr << "--slack-sweep needs a known optimum (n <= " << MAX_KNOWN_MPI_V3 << ")" << std::endl;
+            }
+            MPI_Finalize();
+            return 1;
+        }
+        std::string note = std::string("MPI V3") +
+                           (options.adaptiveSplit && !options.deterministic ? " adaptive" : "") +
+                           (options.deterministic ? " deterministic" : "");
+        if (!options.deterministic && options.boundPolicy != BoundPolicy::Atomic) {
+            note += std::string(" bound=") + boundPolicyName(options.boundPolicy);
+        }
+        const int status = runSlackSweepMPI_V3(n, slackSweep, options, note);
+        MPI_Finalize();
+        return status;
+    }
+
     // Print header only on rank 0
     if (rank == 0) {
         std::cout << "===========================================" << std::endl;
@@ -34,25 +218,50 @@ int main(int argc, char* argv[])
         std::cout << "MPI processes: " << size << std::endl;
         std::cout << "OpenMP threads per process: " << omp_get_max_threads() << std::endl;
         std::cout << "Total workers: " << size * omp_get_max_threads() << std::endl;
+        std::cout << "Prefix split: " << (options.adaptiveSplit && !options.deterministic ? "adaptive" : "fixed depth")
+                  << std::endl;
+        if (options.deterministic) {
+            std::cout << "Deterministic: yes (lexicographic tie-break)" << std::endl;
+        } else if (options.boundPolicy != BoundPolicy::Atomic) {
+            std::cout << "Bound policy: " << boundPolicyName(options.boundPolicy);
+            if (options.boundPolicy == BoundPolicy::Cached) {
+                std::cout << " (refresh every " << options.boundRefresh << " nodes)";
+            }
+            std::cout << std::endl;
+        }
+        if (slack > 0) {
+            const int requested = ((n <= MAX_KNOWN_MPI_V3) ? KNOWN_OPTIMAL_MPI_V3[n] : 200) + slack;
+            std::cout << "Initial bound: optimum + " << slack;
+            if (requested > MAX_LEN_MPI_V3) {
+                std::cout << " (clamped to " << MAX_LEN_MPI_V3 << ", 128-bit distance set)";
+            }
+            std::cout << std::endl;
+        }
         std::cout << std::endl;
     }
 
-    // Known optimal lengths for validation
-    int knownOptimal[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
-    int maxN = sizeof(knownOptimal) / sizeof(knownOptimal[0]) - 1;
+    const int* knownOptimal = KNOWN_OPTIMAL_MPI_V3;
+    const int maxN = MAX_KNOWN_MPI_V3;
 
-    int maxLen = (n <= maxN) ? knownOptimal[n] : 200;
+    int maxLen = ((n <= maxN) ? knownOptimal[n] : 200) + slack;
+    if (maxLen > MAX_LEN_MPI_V3) maxLen = MAX_LEN_MPI_V3;  // As the engine does
 
     GolombRuler best;
+    EnergyMeter meter;  // Every rank measures, one reporter per node
+    MPI_Comm nodeComm;
+    MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, rank, MPI_INFO_NULL, &nodeComm);
 
     MPI_Barrier(MPI_COMM_WORLD);
+    meter.start();
     auto start = std::chrono::high_resolution_clock::now();
 
-    searchGolombMPI_V3(n, maxLen, best);
+    searchGolombMPI_V3(n, maxLen, best, options);
 
     MPI_Barrier(MPI_COMM_WORLD);
     auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double> elapsed = end - start;
+    const EnergyReading energy = reduceEnergy(meter.stop(), nodeComm);
+    MPI_Comm_free(&nodeComm);
 
     long long exploredCount = getExploredCountMPI_V3();
 
@@ -85,6 +294,27 @@ int main(int argc, char* argv[])
         std::cout << "Time     : " << std::fixed << std::setprecision(3)
                   << elapsed.count() << " seconds" << std::endl;
         std::cout << "States   : " << exploredCount << std::endl;
+        if (options.deterministic) {
+            std::cout << "Det. states: " << getDeterministicCountMPI_V3() << std::endl;
+        } else if (options.boundPolicy == BoundPolicy::Cached || options.boundPolicy == BoundPolicy::Epoch) {
+            const BoundPolicyStats& boundStats = getBoundPolicyStatsMPI_V3();
+            std::cout << "Bound reads: " << boundStats.checks << " checks, "
+                      << boundStats.refreshes << " refreshes, "
+                      << boundStats.staleNodes << " stale nodes" << std::endl;
+        }
+        const std::vector<BoundEventMPI_V3>& timeline = getBoundTimelineMPI_V3();
+        if (!timeline.empty()) {
+            std::cout << "First sol.: " << std::fixed << std::setprecision(4) << timeline.front().time
+                      << " s (rank " << timeline.front().rank << ")" << std::endl;
+            std::cout << "Bound timeline: " << formatTimelineMPI_V3(timeline) << std::endl;
+        }
+        if (!tracePath.empty()) {
+            if (writePrefixTrace(tracePath, getPrefixTraceMPI_V3())) {
+                std::cout << "Trace    : " << tracePath << std::endl;
+            } else {
+                std::cerr << "Error: cannot write " << tracePath << std::endl;
+            }
+        }
 
         double statesPerSec = exploredCount / elapsed.count();
         if (statesPerSec >= 1e9) {
@@ -97,6 +327,14 @@ int main(int argc, char* argv[])
             std::cout << "States/sec: " << std::fixed << std::setprecision(0)
                       << statesPerSec << std::endl;
         }
+        if (energy.valid) {
+            std::cout << "Energy   : " << std::fixed << std::setprecision(2) << energy.packageJ << " J pkg + "
+                      << energy.dramJ << " J dram (" << meter.source() << ", one rank per node)" << std::endl;
+            std::cout << "States/J : " << std::scientific << std::setprecision(2)
+                      << (exploredCount / energy.totalJ()) << std::endl;
+        } else {
+            std::cout << "Energy   : n/a (no readable RAPL counters)" << std::endl;
+        }
     }
 
     MPI_Finalize();
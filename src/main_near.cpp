@@ -0,0 +1,230 @@
+#include "search_near.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+// =============================================================================
+// GOLOMB NEAR - Optimal near-Golomb rulers (up to k repeated distances)
+// =============================================================================
+// Single run:
+//   golomb_near <n> [--excess=K] [--max-repeat=M] [--len=L] [--depth=D]
+//
+// Table (--table): optimal length for every n of --n and k of --k. The
+// optimum can only shrink as k grows, so each k starts from the length
+// found for k - 1 (k = 0 from the known Golomb optimum).
+// =============================================================================
+
+namespace {
+
+static const int KNOWN_OPTIMAL[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+
+std::vector<int> parseIntList(const char* list) {
+    std::vector<int> values;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+int defaultMaxLen(int n) {
+    return (n <= 14) ? KNOWN_OPTIMAL[n] : MAX_LEN_NEAR;
+}
+
+void printRuler(const GolombRuler& ruler) {
+    std::cout << "Ruler      : { ";
+    for (size_t i = 0; i < ruler.marks.size(); ++i) {
+        std::cout << ruler.marks[i];
+        if (i < ruler.marks.size() - 1) std::cout << ", ";
+    }
+    std::cout << " }\n";
+}
+
+// Excess within k and multiplicity within the cap
+bool checkNearRuler(const GolombRuler& ruler, const NearOptions& options, int& excess, int& maxMult) {
+    excess = nearRulerExcess(ruler.marks, &maxMult);
+    if (excess < 0 || excess > options.excess) return false;
+    return options.maxRepeat <= 0 || maxMult <= options.maxRepeat;
+}
+
+int runSingle(int n, int maxLen, const NearOptions& options) {
+    std::cout << "=============================================================\n";
+    std::cout << "     GOLOMB NEAR (n=" << n << ", k=" << options.excess;
+    if (options.maxRepeat > 0) std::cout << ", max repeat=" << options.maxRepeat;
+    std::cout << ", L<=" << maxLen << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n";
+
+    GolombRuler result;
+    NearStats stats;
+    const auto start = std::chrono::high_resolution_clock::now();
+    const bool found = searchNearGolomb(n, maxLen, options, result, stats);
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double time = std::chrono::duration<double>(end - start).count();
+
+    std::cout << "Planes     : " << stats.planes << "\n";
+    std::cout << "Prefixes   : " << stats.prefixCount << " (depth " << stats.prefixDepth << ")\n";
+    std::cout << "Length     : " << (found ? result.length : -1) << "\n";
+    std::cout << "Time       : " << std::fixed << std::setprecision(3) << time << " s\n";
+    std::cout << "States     : " << stats.explored << "\n";
+    std::cout << "States/sec : " << std::scientific << std::setprecision(2)
+              << (time > 0.0 ? stats.explored / time : 0.0) << "\n";
+
+    if (!found) {
+        std::cout << "No ruler within L=" << maxLen << "\n";
+        return 0;
+    }
+    int excess = 0;
+    int maxMult = 0;
+    const bool valid = checkNearRuler(result, options, excess, maxMult);
+    std::cout << "Excess     : " << excess << " (max multiplicity " << maxMult << ")\n";
+    std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
+    printRuler(result);
+    return valid ? 0 : 1;
+}
+
+int runTable(const std::vector<int>& sizes, const std::vector<int>& excesses, const NearOptions& base) {
+    std::cout << "=============================================================\n";
+    std::cout << "   GOLOMB NEAR TABLE - optimal length by (n, k)";
+    if (base.maxRepeat > 0) std::cout << ", max repeat " << base.maxRepeat;
+    std::cout << "\n=============================================================\n";
+    std::cout << "Threads: " << omp_get_max_threads() << "\n\n";
+    std::cout << std::setw(4) << "n" << std::setw(4) << "k" << std::setw(6) << "Len"
+              << std::setw(6) << "Exc" << std::setw(14) << "States" << std::setw(10) << "Time(s)"
+              << "  Ruler\n";
+    std::cout << std::string(72, '-') << "\n";
+
+    bool allValid = true;
+    for (int n : sizes) {
+        int maxLen = defaultMaxLen(n);
+        for (int k : excesses) {
+            NearOptions options = base;
+            options.excess = k;
+
+            GolombRuler result;
+            NearStats stats;
+            const auto start = std::chrono::high_resolution_clock::now();
+            const bool found = searchNearGolomb(n, maxLen, options, result, stats);
+            const auto end = std::chrono::high_resolution_clock::now();
+            const double time = std::chrono::duration<double>(end - start).count();
+
+            int excess = -1;
+            int maxMult = 0;
+            if (found && !checkNearRuler(result, options, excess, maxMult)) allValid = false;
+
+            std::cout << std::setw(4) << n << std::setw(4) << k
+                      << std::setw(6) << (found ? result.length : -1) << std::setw(6) << excess
+                      << std::setw(14) << stats.explored
+                      << std::setw(10) << std::fixed << std::setprecision(3) << time << "  { ";
+            for (size_t i = 0; i < result.marks.size(); ++i) {
+                std::cout << result.marks[i] << (i + 1 < result.marks.size() ? "," : "");
+            }
+            std::cout << " }\n";
+
+            if (found) maxLen = result.length;  // Optimum for k + 1 is no longer
+        }
+    }
+
+    std::cout << std::string(72, '-') << "\n";
+    std::cout << "All rulers within their excess: " << (allValid ? "YES" : "NO") << "\n";
+    return allValid ? 0 : 1;
+}
+
+void printUsage(const char* progName) {
+    std::cout << "Usage: " << progName << " <n> [options]\n"
+              << "       " << progName << " --table [--n=LIST] [--k=LIST] [--max-repeat=M]\n"
+              << "  --excess=K      repeated distances allowed: sum of (multiplicity - 1) (default 1)\n"
+              << "  --max-repeat=M  no distance more than M times (0 = no cap, at most "
+              << MAX_REPEAT_NEAR << ")\n"
+              << "  --len=L         initial bound (default: Golomb optimum for n <= 14, else "
+              << MAX_LEN_NEAR << ")\n"
+              << "  --depth=D       prefix depth (0 = auto)\n"
+              << "  --n=LIST        table sizes (default 6,7,8,9,10,11)\n"
+              << "  --k=LIST        table excesses (default 0,1,2,3)\n"
+              << "\nExamples:\n"
+              << "  " << progName << " 12 --excess=2\n"
+              << "  " << progName << " --table --n=8,10 --k=0,1,2,4 --max-repeat=2\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    NearOptions options;
+    bool table = false;
+    int maxLen = 0;
+    std::vector<int> sizes = {6, 7, 8, 9, 10, 11};
+    std::vector<int> excesses = {0, 1, 2, 3};
+    std::vector<int> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (std::strcmp(arg, "--table") == 0) {
+            table = true;
+        } else if (std::strncmp(arg, "--excess=", 9) == 0) {
+            options.excess = std::atoi(arg + 9);
+        } else if (std::strncmp(arg, "--max-repeat=", 13) == 0) {
+            options.maxRepeat = std::atoi(arg + 13);
+        } else if (std::strncmp(arg, "--len=", 6) == 0) {
+            maxLen = std::atoi(arg + 6);
+        } else if (std::strncmp(arg, "--depth=", 8) == 0) {
+            options.prefixDepth = std::atoi(arg + 8);
+        } else if (std::strncmp(arg, "--n=", 4) == 0) {
+            sizes = parseIntList(arg + 4);
+        } else if (std::strncmp(arg, "--k=", 4) == 0) {
+            excesses = parseIntList(arg + 4);
+        } else if (arg[0] != '-') {
+            positional.push_back(std::atoi(arg));
+        } else {
+            std::cerr << "ERROR: unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (options.maxRepeat < 0 || options.maxRepeat > MAX_REPEAT_NEAR) {
+        std::cerr << "ERROR: --max-repeat must be between 0 and " << MAX_REPEAT_NEAR << "\n";
+        return 1;
+    }
+
+    if (table) {
+        for (int n : sizes) {
+            if (n < 3 || n > MAX_MARKS_NEAR) {
+                std::cerr << "ERROR: n must be between 3 and " << MAX_MARKS_NEAR << "\n";
+                return 1;
+            }
+        }
+        std::sort(excesses.begin(), excesses.end());
+        if (!excesses.empty() && excesses.front() < 0) {
+            std::cerr << "ERROR: k must be >= 0\n";
+            return 1;
+        }
+        return runTable(sizes, excesses, options);
+    }
+
+    if (positional.size() != 1) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    const int n = positional[0];
+    if (n < 2 || n > MAX_MARKS_NEAR || options.excess < 0) {
+        std::cerr << "ERROR: n must be between 2 and " << MAX_MARKS_NEAR << ", k >= 0\n";
+        return 1;
+    }
+    if (maxLen <= 0) maxLen = defaultMaxLen(n);
+    if (maxLen > MAX_LEN_NEAR) {
+        std::cerr << "ERROR: maxLen must be at most " << MAX_LEN_NEAR << "\n";
+        return 1;
+    }
+    return runSingle(n, maxLen, options);
+}
@@ -37,10 +37,13 @@ void runSingleN(int n) {
     std::cout << "Threads: " << numThreads << "\n\n";
 
     GolombRuler result;
+    EnergyMeter meter;
 
+    meter.start();
     auto start = std::chrono::high_resolution_clock::now();
     searchGolomb(n, DEFAULT_MAX_LEN, result);
     auto end = std::chrono::high_resolution_clock::now();
+    const EnergyReading energy = meter.stop();
 
     double time = std::chrono::duration<double>(end - start).count();
     long long states = getExploredCount();
@@ -52,6 +55,13 @@ void runSingleN(int n) {
     std::cout << "Time       : " << std::fixed << std::setprecision(3) << time << " s\n";
     std::cout << "States     : " << states << "\n";
     std::cout << "States/sec : " << std::scientific << std::setprecision(2) << statesPerSec << "\n";
+    if (energy.valid) {
+        std::cout << "Energy     : " << std::fixed << std::setprecision(2) << energy.packageJ << " J pkg + "
+                  << energy.dramJ << " J dram (" << meter.source() << ")\n";
+        std::cout << "States/J   : " << std::scientific << std::setprecision(2) << (states / energy.totalJ()) << "\n";
+    } else {
+        std::cout << "Energy     : n/a (no readable RAPL counters)\n";
+    }
     std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
     std::cout << "\nRuler: { ";
     for (size_t i = 0; i < result.marks.size(); ++i) {
@@ -86,6 +96,8 @@ int main(int argc, char** argv) {
 
     // Logger CSV
     BenchmarkLog logger("benchmarks", "openmp");
+    EnergyMeter meter;
+    std::cout << "Energy: " << (meter.available() ? meter.source() : std::string("n/a (no readable RAPL counters)")) << "\n";
 
     if (!CHANGES.empty()) {
         std::cout << "Changes: " << CHANGES << "\n";
@@ -98,8 +110,10 @@ int main(int argc, char** argv) {
             << std::setw(15) << "Time (s)"
             << std::setw(15) << "Speedup"
             << std::setw(15) << "Efficiency (%)"
-            << std::setw(20) << "Explored States" << std::endl;
-        std::cout << std::string(85, '-') << std::endl;
+            << std::setw(20) << "Explored States"
+            << std::setw(14) << "Energy (J)"
+            << std::setw(14) << "States/J" << std::endl;
+        std::cout << std::string(113, '-') << std::endl;
 
         double baseTime = 0.0;
 
@@ -108,11 +122,13 @@ int main(int argc, char** argv) {
             omp_set_num_threads(t);
 
             GolombRuler best;
+            meter.start();
             auto start = std::chrono::high_resolution_clock::now();
 
             searchGolomb(n, maxLen, best);
 
             auto end = std::chrono::high_resolution_clock::now();
+            const EnergyReading energy = meter.stop();
             std::chrono::duration<double> elapsed = end - start;
             double time = elapsed.count();
             if (t == 1) baseTime = time;
@@ -130,11 +146,17 @@ int main(int argc, char** argv) {
                 << std::setw(15) << std::setprecision(2) << speedup
                 << std::setw(15) << std::setprecision(1) << efficiency
                 << std::setw(20) << states;
+            if (energy.valid) {
+                std::cout << std::setw(14) << std::setprecision(2) << energy.totalJ()
+                          << std::setw(14) << std::scientific << (states / energy.totalJ()) << std::fixed;
+            } else {
+                std::cout << std::setw(14) << "n/a" << std::setw(14) << "n/a";
+            }
             if (!valid) std::cout << " INVALID!";
             std::cout << std::endl;
 
             // Log to CSV
-            logger.logOpenMP(n, t, best.length, time, speedup, efficiency, states, CHANGES);
+            logger.logOpenMP(n, t, best.length, time, speedup, efficiency, states, CHANGES, energy);
         }
     }
 
@@ -1,15 +1,409 @@
 #include <iostream>
 #include <iomanip>
 #include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
 #include <omp.h>
 #include "search_v5.hpp"
+#include "benchmark_log.hpp"
+#include "pattern_db.hpp"
+#include "spool_v5.hpp"
+#include "simd_bitset.hpp"
+
+// Known optimal lengths (upper bounds)
+static const int KNOWN_OPTIMAL[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
+
+// =============================================================================
+// BATCH MODE - One line per instance: "n [bound=L] [forbid=d1,d2,...]"
+// =============================================================================
+static int runBatch(const std::string& path, bool adaptive, bool serial)
+{
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "Error: cannot open " << path << std::endl;
+        return 1;
+    }
+
+    std::vector<BatchInstanceV5> instances;
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') continue;
+
+        std::istringstream iss(line);
+        BatchInstanceV5 inst;
+        iss >> inst.n;
+        if (inst.n < 2 || inst.n > 20) {
+            std::cerr << "Error: bad instance line '" << line << "'" << std::endl;
+            return 1;
+        }
+
+        std::string token;
+        while (iss >> token) {
+            if (token.rfind("bound=", 0) == 0) {
+                inst.maxLen = std::atoi(token.c_str() + 6);
+            } else if (token.rfind("forbid=", 0) == 0) {
+                std::istringstream list(token.substr(7));
+                std::string item;
+                while (std::getline(list, item, ',')) {
+                    if (!item.empty()) inst.forbiddenDistances.push_back(std::atoi(item.c_str()));
+                }
+            }
+        }
+        if (inst.maxLen <= 0) {
+            inst.maxLen = (inst.n <= 14 && inst.forbiddenDistances.empty()) ? KNOWN_OPTIMAL[inst.n] : 127;
+        }
+        instances.push_back(inst);
+    }
+
+    SearchOptionsV5 options;
+    if (adaptive) {
+        options.split = PrefixSplitV5::Adaptive;
+    }
+
+    std::cout << "=============================================================\n";
+    std::cout << "       OPTIMAL GOLOMB RULER - OPENMP V5 BATCH\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Instances: " << instances.size() << "\n";
+    std::cout << "Threads: " << omp_get_max_threads() << "\n";
+    std::cout << "Scheduler: " << (serial ? "serial (one search per instance)" : "shared prefix pool") << "\n";
+    std::cout << std::endl;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    if (serial) {
+        for (BatchInstanceV5& inst : instances) {
+            SearchOptionsV5 instOptions = options;
+            instOptions.forbiddenDistances = inst.forbiddenDistances;
+            searchGolombV5(inst.n, inst.maxLen, inst.best, instOptions, inst.stats);
+        }
+    } else {
+        searchGolombBatchV5(instances, options);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    double elapsed = std::chrono::duration<double>(end - start).count();
+
+    std::cout << std::setw(5) << "n"
+              << std::setw(8) << "Bound"
+              << std::setw(8) << "Length"
+              << std::setw(10) << "Prefixes"
+              << std::setw(14) << "States"
+              << std::setw(8) << "Valid" << "  Ruler\n";
+    std::cout << std::string(70, '-') << "\n";
+
+    bool allValid = true;
+    long long totalStates = 0;
+    for (const BatchInstanceV5& inst : instances) {
+        const bool valid = inst.best.marks.empty() || GolombRuler::isValid(inst.best.marks);
+        allValid = allValid && valid;
+        totalStates += inst.stats.explored;
+
+        std::cout << std::setw(5) << inst.n
+                  << std::setw(8) << inst.maxLen
+                  << std::setw(8) << (inst.best.marks.empty() ? std::string("-") : std::to_string(inst.best.length))
+                  << std::setw(10) << inst.stats.prefixCount
+                  << std::setw(14) << inst.stats.explored
+                  << std::setw(8) << (valid ? "YES" : "NO") << "  {";
+        for (size_t i = 0; i < inst.best.marks.size(); ++i) {
+            std::cout << (i > 0 ? ", " : " ") << inst.best.marks[i];
+        }
+        std::cout << " }\n";
+    }
+
+    std::cout << std::string(70, '-') << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Time       : " << elapsed << " s\n";
+    std::cout << "States     : " << totalStates << "\n";
+    std::cout << "Instances/s: " << (instances.size() / elapsed) << "\n";
+    std::cout << "=============================================================\n";
+
+    return allValid ? 0 : 1;
+}
+
+// =============================================================================
+// SLACK SWEEP - Same search with the initial bound at optimum + k
+// =============================================================================
+// Published timings start at the known optimum, where the bound never moves
+// until the end. A discovery run starts loose: the sweep shows how fast the
+// bound comes down (first solution, timeline) and what the loose start costs
+// in states and time. One row per k in benchmarks/bound_slack_benchmark.csv.
+// =============================================================================
+static std::string describeOptionsV5(const SearchOptionsV5& options)
+{
+    std::string note = "V5";
+    if (options.split == PrefixSplitV5::Adaptive) note += " adaptive";
+    if (options.prefixDepth > 0) note += " depth=" + std::to_string(options.prefixDepth);
+    if (options.deterministic) note += " deterministic";
+    if (options.heuristicThreads > 0) note += " portfolio=" + std::to_string(options.heuristicThreads);
+    if (options.candidateOrder == CandidateOrderV5::FreeSmallDistances) note += " small-free";
+    if (options.prefixOrder == PrefixOrderV5::Length) note += " order=length";
+    if (options.prefixOrder == PrefixOrderV5::Slack) note += " order=slack";
+    if (options.boundPolicy != BoundPolicy::Atomic) {
+        note += std::string(" bound=") + boundPolicyName(options.boundPolicy);
+    }
+    if (options.patternDb) note += " pdb k=" + std::to_string(options.patternDb->bits());
+    return note;
+}
+
+static int runSlackSweep(int n, const SearchOptionsV5& options, const std::vector<int>& slacks)
+{
+    if (n > 14) {
+        std::cerr << "Error: slack sweep needs a known optimum (n <= 14)" << std::endl;
+        return 1;
+    }
+    const int numThreads = omp_get_max_threads();
+    const std::string note = describeOptionsV5(options);
+    EnergyMeter meter;
+
+    std::cout << "=============================================================\n";
+    std::cout << "       GOLOMB V5 BOUND-SLACK SWEEP (n=" << n << ", optimum " << KNOWN_OPTIMAL[n] << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Threads    : " << numThreads << "\n";
+    std::cout << "Config     : " << note << "\n";
+    std::cout << "Energy     : " << (meter.available() ? meter.source() : std::string("n/a (no readable RAPL counters)"))
+              << "\n\n";
+    std::cout << std::setw(6) << "slack" << std::setw(6) << "bound" << " " << std::setw(8) << "length"
+              << std::setw(11) << "time(s)" << std::setw(12) << "first(s)" << std::setw(15) << "states"
+              << std::setw(9) << "updates" << "  timeline\n";
+    std::cout << std::string(78, '-') << "\n";
+
+    BenchmarkLog logger("benchmarks", "bound_slack");
+    bool allOptimal = true;
+    bool anyClamped = false;
+
+    for (int slack : slacks) {
+        // The engine clamps the bound: log the bound actually searched
+        const bool clamped = KNOWN_OPTIMAL[n] + slack > MAX_LEN_V5;
+        const int maxLen = clamped ? MAX_LEN_V5 : KNOWN_OPTIMAL[n] + slack;
+        anyClamped = anyClamped || clamped;
+        GolombRuler best;
+        SearchStatsV5 stats;
+
+        meter.start();
+        const auto start = std::chrono::high_resolution_clock::now();
+        searchGolombV5(n, maxLen, best, options, stats);
+        const auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = meter.stop();
+        const double elapsed = std::chrono::duration<double>(end - start).count();
+
+        std::ostringstream timeline;
+        timeline << std::fixed << std::setprecision(4);
+        for (size_t i = 0; i < stats.boundTimeline.size(); ++i) {
+            const BoundEventV5& event = stats.boundTimeline[i];
+            timeline << (i > 0 ? ";" : "") << event.length << "@" << event.time
+                     << (event.heuristic ? "(h)" : "");
+        }
+        const double firstSolution = stats.boundTimeline.empty() ? -1.0 : stats.boundTimeline.front().time;
+        const bool optimal = best.length == KNOWN_OPTIMAL[n] && GolombRuler::isValid(best.marks);
+        allOptimal = allOptimal && optimal;
+
+        std::cout << std::setw(6) << slack << std::setw(6) << maxLen << (clamped ? "*" : " ")
+                  << std::setw(8) << best.length << std::fixed << std::setprecision(3) << std::setw(11) << elapsed;
+        if (firstSolution >= 0.0) {
+            std::cout << std::setw(12) << std::setprecision(4) << firstSolution;
+        } else {
+            std::cout << std::setw(12) << "-";
+        }
+        std::cout << std::setw(15) << stats.explored << std::setw(9) << stats.boundTimeline.size()
+                  << "  " << timeline.str() << (optimal ? "" : "  (NOT OPTIMAL)") << "\n";
+
+        logger.logSlack("openmp_v5", n, 1, numThreads, slack, maxLen, best.length, elapsed,
+                        firstSolution, stats.explored, static_cast<int>(stats.boundTimeline.size()),
+                        timeline.str(), note, energy);
+    }
+
+    std::cout << std::string(78, '-') << "\n";
+    if (anyClamped) {
+        std::cout << "* optimum + slack exceeds " << MAX_LEN_V5 << ": bound clamped (128-bit distance set)\n";
+    }
+    std::cout << "[Results saved to benchmarks/bound_slack_benchmark.csv]\n";
+    return allOptimal ? 0 : 1;
+}
+
+// =============================================================================
+// AUDIT - Sampled re-execution of deterministic prefixes
+// =============================================================================
+static bool printAuditReport(const AuditReportV5& report)
+{
+    if (report.mismatches < 0) {
+        std::cout << "Audit      : prefix set differs from the recorded run ("
+                  << report.prefixes << " prefixes), check n / depth / bound\n";
+        return false;
+    }
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Audit      : " << report.sampled << "/" << report.prefixes << " prefixes re-executed ("
+              << report.sameThread << " on the recording thread), "
+              << report.mismatches << " mismatch(es)\n";
+    std::cout << "Audit cost : " << report.reexecutedNodes << " nodes ("
+              << std::setprecision(2)
+              << (report.recordedNodes > 0 ? 100.0 * report.reexecutedNodes / report.recordedNodes : 0.0)
+              << "% of the run), " << std::setprecision(3) << report.time << " s\n";
+    for (size_t i = 0; i < report.expected.size(); ++i) {
+        std::cout << "  prefix " << report.expected[i].index
+                  << ": recorded " << report.expected[i].nodes << " nodes / " << std::hex
+                  << report.expected[i].hash << std::dec
+                  << " (thread " << report.expected[i].thread << "), re-executed "
+                  << report.actual[i].nodes << " / " << std::hex << report.actual[i].hash << std::dec
+                  << " (thread " << report.actual[i].thread << ")\n";
+    }
+    if (report.betterRulerFound) {
+        std::cout << "Audit      : re-execution found a shorter ruler than the recorded one\n";
+    }
+    return report.mismatches == 0 && !report.betterRulerFound;
+}
+
+// Cross-node check: digests written by --digest-out on another machine
+static int runAuditCheck(const std::string& path, double fraction, uint64_t seed)
+{
+    DigestFileHeader header;
+    std::vector<PrefixDigest> digests;
+    if (!readPrefixDigests(path, header, digests) || header.n < 2 || header.n > 20) {
+        std::cerr << "Error: cannot read digests from " << path << std::endl;
+        return 1;
+    }
+
+    SearchOptionsV5 options;
+    options.deterministic = true;
+    options.prefixDepth = header.prefixDepth;
+
+    std::cout << "=============================================================\n";
+    std::cout << "       GOLOMB V5 AUDIT (n=" << header.n << ", bound " << header.maxLen
+              << ", depth " << header.prefixDepth << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Digests    : " << path << " (" << digests.size() << " prefixes)\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n";
+
+    AuditReportV5 report;
+    auditPrefixesV5(header.n, header.maxLen, options, digests, header.boundKey, fraction, seed, report);
+    const bool ok = printAuditReport(report);
+    std::cout << "=============================================================\n";
+    return ok ? 0 : 1;
+}
+
+static void printUsageV5(const char* program)
+{
+    std::cerr << "Usage: " << program << " <n> [prefix_depth|adaptive] [options]" << std::endl;
+    std::cerr << "       " << program << " batch <instances_file> [adaptive] [--serial]" << std::endl;
+    std::cerr << "       " << program << " spool-init <dir> <n> [prefix_depth|adaptive] [--bound=L] [--per-unit=N]" << std::endl;
+    std::cerr << "       " << program << " spool-work <dir> [--max-units=K]" << std::endl;
+    std::cerr << "       " << program << " spool-merge|spool-status <dir>" << std::endl;
+    std::cerr << "       " << program << " spool-requeue <dir> [--stale=SECONDS]" << std::endl;
+    std::cerr << "       " << program << " audit-check <digest_file> [--audit=F] [--audit-seed=S]" << std::endl;
+    std::cerr << "  n            : number of marks (e.g., 10, 11, 12, 13)" << std::endl;
+    std::cerr << "  prefix_depth : optional prefix depth (default: auto)" << std::endl;
+    std::cerr << "  adaptive     : variable-depth prefixes sized by estimated cost" << std::endl;
+    std::cerr << "Options:" << std::endl;
+    std::cerr << "  --portfolio=K : K threads run randomized greedy construction first" << std::endl;
+    std::cerr << "  --stall=N     : greedy attempts without improvement before going exact" << std::endl;
+    std::cerr << "  --slack=K     : start from bound = known optimum + K (loose bound)" << std::endl;
+    std::cerr << "  --slack-sweep=K1,K2,... : one run per slack, rows in benchmarks/bound_slack_benchmark.csv" << std::endl;
+    std::cerr << "  --prefix-order=generation|length|slack : prefix dispatch order" << std::endl;
+    std::cerr << "  --candidate-order=increasing|small-free : child order inside a node" << std::endl;
+    std::cerr << "  --deterministic : smallest optimal ruler and node count independent of threads" << std::endl;
+    std::cerr << "  --trace=FILE  : write per-prefix costs (CSV) for golomb_schedsim" << std::endl;
+    std::cerr << "  --bound-policy=atomic|cached|epoch|numa : how threads read the shared bound" << std::endl;
+    std::cerr << "  --bound-refresh=K : cached policy, nodes between two reads (default "
+              << DEFAULT_BOUND_REFRESH << ")" << std::endl;
+    std::cerr << "  --audit=F     : deterministic run, then re-execute a fraction F of the prefixes" << std::endl;
+    std::cerr << "  --audit-seed=S : seed of the audit sample (default 1)" << std::endl;
+    std::cerr << "  --digest-out=FILE : deterministic run, write per-prefix digests for audit-check" << std::endl;
+    std::cerr << "  --pdb[=K]     : prune with the pattern database of the K smallest distances (default "
+              << PDB_DEFAULT_BITS << "), built on first use" << std::endl;
+}
 
 int main(int argc, char* argv[])
 {
+    if (argc >= 3 && std::string(argv[1]) == "batch") {
+        bool adaptive = false;
+        bool serial = false;
+        for (int i = 3; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "adaptive") adaptive = true;
+            if (arg == "--serial") serial = true;
+        }
+        return runBatch(argv[2], adaptive, serial);
+    }
+
+    if (argc >= 3 && std::string(argv[1]) == "audit-check") {
+        double fraction = 0.05;
+        uint64_t seed = 1;
+        for (int i = 3; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg.rfind("--audit=", 0) == 0) fraction = std::atof(arg.c_str() + 8);
+            if (arg.rfind("--audit-seed=", 0) == 0) seed = std::strtoull(arg.c_str() + 13, nullptr, 10);
+        }
+        return runAuditCheck(argv[2], fraction, seed);
+    }
+
+    if (argc >= 3 && std::string(argv[1]).rfind("spool-", 0) == 0) {
+        const std::string command = argv[1];
+        const std::string dir = argv[2];
+        if (command == "spool-init" && argc >= 4) {
+            const int n = std::atoi(argv[3]);
+            if (n < 2 || n > 20) {
+                std::cerr << "Error: n must be between 2 and 20" << std::endl;
+                return 1;
+            }
+            SearchOptionsV5 options;
+            int maxLen = (n <= 14) ? KNOWN_OPTIMAL[n] : (n * n);
+            int unitSize = 64;
+            for (int i = 4; i < argc; ++i) {
+                const std::string arg = argv[i];
+                if (arg == "adaptive") {
+                    options.split = PrefixSplitV5::Adaptive;
+                } else if (arg.rfind("--bound=", 0) == 0) {
+                    maxLen = std::atoi(arg.c_str() + 8);
+                } else if (arg.rfind("--per-unit=", 0) == 0) {
+                    unitSize = std::atoi(arg.c_str() + 11);
+                } else if (arg.find_first_not_of("0123456789") == std::string::npos) {
+                    options.prefixDepth = std::atoi(arg.c_str());
+                } else {
+                    std::cerr << "Error: unknown option " << arg << std::endl;
+                    printUsageV5(argv[0]);
+                    return 1;
+                }
+            }
+            return spoolInitV5(dir, n, maxLen, options, unitSize);
+        }
+        if (command == "spool-work") {
+            int maxUnits = 0;
+            for (int i = 3; i < argc; ++i) {
+                const std::string arg = argv[i];
+                if (arg.rfind("--max-units=", 0) == 0) {
+                    maxUnits = std::atoi(arg.c_str() + 12);
+                } else {
+                    std::cerr << "Error: unknown option " << arg << std::endl;
+                    printUsageV5(argv[0]);
+                    return 1;
+                }
+            }
+            return spoolWorkV5(dir, maxUnits);
+        }
+        if (command == "spool-merge") return spoolMergeV5(dir);
+        if (command == "spool-status") return spoolStatusV5(dir);
+        if (command == "spool-requeue") {
+            int staleSeconds = 0;
+            for (int i = 3; i < argc; ++i) {
+                const std::string arg = argv[i];
+                if (arg.rfind("--stale=", 0) == 0) {
+                    staleSeconds = std::atoi(arg.c_str() + 8);
+                } else {
+                    std::cerr << "Error: unknown option " << arg << std::endl;
+                    printUsageV5(argv[0]);
+                    return 1;
+                }
+            }
+            if (staleSeconds != 0 && staleSeconds <= 2 * SPOOL_HEARTBEAT_V5) {
+                std::cerr << "Error: --stale must exceed two lease renewals ("
+                          << 2 * SPOOL_HEARTBEAT_V5 << " s)" << std::endl;
+                return 1;
+            }
+            return spoolRequeueV5(dir, staleSeconds);
+        }
+    }
+
     if (argc < 2) {
-        std::cerr << "Usage: " << argv[0] << " <n> [prefix_depth]" << std::endl;
-        std::cerr << "  n            : number of marks (e.g., 10, 11, 12, 13)" << std::endl;
-        std::cerr << "  prefix_depth : optional prefix depth (default: auto)" << std::endl;
+        printUsageV5(argv[0]);
         return 1;
     }
 
@@ -19,41 +413,221 @@ int main(int argc, char* argv[])
         return 1;
     }
 
-    int prefixDepth = 0;  // auto
-    if (argc >= 3) {
-        prefixDepth = std::atoi(argv[2]);
+    SearchOptionsV5 options;  // fixed depth, auto
+    int slack = 0;
+    std::string tracePath;
+    std::string digestPath;
+    double auditFraction = 0.0;
+    uint64_t auditSeed = 1;
+    int pdbBits = 0;
+    std::vector<int> slackSweep;
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (arg == "adaptive") {
+            options.split = PrefixSplitV5::Adaptive;
+        } else if (arg.rfind("--portfolio=", 0) == 0) {
+            options.heuristicThreads = std::atoi(value.c_str());
+        } else if (arg.rfind("--stall=", 0) == 0) {
+            options.heuristicStallLimit = std::atoi(value.c_str());
+        } else if (arg.rfind("--slack=", 0) == 0) {
+            slack = std::atoi(value.c_str());
+        } else if (arg.rfind("--slack-sweep=", 0) == 0) {
+            std::istringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (!item.empty()) slackSweep.push_back(std::atoi(item.c_str()));
+            }
+        } else if (arg.rfind("--prefix-order=", 0) == 0) {
+            if (value == "generation") {
+                options.prefixOrder = PrefixOrderV5::Generation;
+            } else if (value == "length") {
+                options.prefixOrder = PrefixOrderV5::Length;
+            } else if (value == "slack") {
+                options.prefixOrder = PrefixOrderV5::Slack;
+            } else {
+                std::cerr << "Error: unknown prefix order " << value << std::endl;
+                printUsageV5(argv[0]);
+                return 1;
+            }
+        } else if (arg.rfind("--candidate-order=", 0) == 0) {
+            if (value == "increasing") {
+                options.candidateOrder = CandidateOrderV5::Increasing;
+            } else if (value == "small-free") {
+                options.candidateOrder = CandidateOrderV5::FreeSmallDistances;
+            } else {
+                std::cerr << "Error: unknown candidate order " << value << std::endl;
+                printUsageV5(argv[0]);
+                return 1;
+            }
+        } else if (arg.rfind("--trace=", 0) == 0) {
+            tracePath = value;
+            options.recordPrefixCosts = true;
+        } else if (arg == "--deterministic") {
+            options.deterministic = true;
+        } else if (arg.rfind("--audit=", 0) == 0) {
+            auditFraction = std::atof(value.c_str());
+            options.deterministic = true;
+            options.recordDigests = true;
+        } else if (arg.rfind("--audit-seed=", 0) == 0) {
+            auditSeed = std::strtoull(value.c_str(), nullptr, 10);
+        } else if (arg.rfind("--digest-out=", 0) == 0) {
+            digestPath = value;
+            options.deterministic = true;
+            options.recordDigests = true;
+        } else if (arg.rfind("--bound-policy=", 0) == 0) {
+            if (!parseBoundPolicy(value, options.boundPolicy)) {
+                std::cerr << "Error: unknown bound policy " << value << std::endl;
+                return 1;
+            }
+        } else if (arg.rfind("--bound-refresh=", 0) == 0) {
+            options.boundRefresh = std::atoi(value.c_str());
+        } else if (arg == "--pdb" || arg.rfind("--pdb=", 0) == 0) {
+            pdbBits = value.empty() ? PDB_DEFAULT_BITS : std::atoi(value.c_str());
+        } else if (arg.rfind("--", 0) != 0) {
+            options.prefixDepth = std::atoi(arg.c_str());
+        } else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            return 1;
+        }
     }
 
-    // Known optimal lengths (upper bounds)
-    int knownOptimal[] = {0, 0, 1, 3, 6, 11, 17, 25, 34, 44, 55, 72, 85, 106, 127};
-    int maxLen = (n <= 14) ? knownOptimal[n] : (n * n);
+    int maxLen = (n <= 14) ? KNOWN_OPTIMAL[n] : (n * n);
+    maxLen += slack;
+    const bool clamped = maxLen > MAX_LEN_V5;
+    if (clamped) maxLen = MAX_LEN_V5;
+
+    PatternDB patternDb;
+    bool pdbBuilt = false;
+    if (pdbBits > 0) {
+        const std::string pdbPath = PatternDB::defaultPath(pdbBits, PDB_DEFAULT_MARKS);
+        if (!patternDb.open(pdbPath, pdbBits, PDB_DEFAULT_MARKS, &pdbBuilt)) {
+            std::cerr << "Error: pattern database k=" << pdbBits << " unavailable (k in "
+                      << PDB_MIN_BITS << ".." << PDB_MAX_BITS << ")" << std::endl;
+            return 1;
+        }
+        options.patternDb = &patternDb;
+    }
+    if (!slackSweep.empty()) {
+        return runSlackSweep(n, options, slackSweep);
+    }
 
     int numThreads = omp_get_max_threads();
 
     std::cout << "=============================================================\n";
     std::cout << "       OPTIMAL GOLOMB RULER - OPENMP V5 (n=" << n << ")\n";
     std::cout << "=============================================================\n";
-    std::cout << "Algorithm: uint64_t ops + prefix-based + iterative\n";
+    std::cout << "Algorithm: 128-bit SIMD (" << GOLOMB_SIMD_BACKEND << ") + prefix-based + iterative\n";
     std::cout << "Threads: " << numThreads << "\n";
-    std::cout << "Prefix depth: " << (prefixDepth > 0 ? std::to_string(prefixDepth) : "auto") << "\n";
+    if (options.split == PrefixSplitV5::Adaptive) {
+        std::cout << "Prefix depth: adaptive (" << options.tasksPerThread << " tasks/thread)\n";
+    } else {
+        std::cout << "Prefix depth: " << (options.prefixDepth > 0 ? std::to_string(options.prefixDepth) : "auto") << "\n";
+    }
+    if (options.deterministic) {
+        std::cout << "Deterministic: yes (fixed-depth prefixes, lexicographic tie-break)\n";
+    } else if (options.heuristicThreads > 0) {
+        std::cout << "Portfolio: " << options.heuristicThreads << " greedy thread(s), stall after "
+                  << options.heuristicStallLimit << " attempts\n";
+    }
+    if (!options.deterministic && options.boundPolicy != BoundPolicy::Atomic) {
+        std::cout << "Bound policy: " << boundPolicyName(options.boundPolicy);
+        if (options.boundPolicy == BoundPolicy::Cached) {
+            std::cout << " (refresh every " << options.boundRefresh << " nodes)";
+        }
+        std::cout << "\n";
+    }
+    if (options.patternDb) {
+        std::cout << "Pattern DB: k=" << patternDb.bits() << ", R=" << patternDb.maxMarks() << ", "
+                  << patternDb.bytes() / 1024 << " KB (" << (pdbBuilt ? "built" : "mapped") << ")";
+        if (options.deterministic || options.candidateOrder != CandidateOrderV5::Increasing) {
+            std::cout << ", unused by this kernel";
+        }
+        std::cout << "\n";
+    }
+    std::cout << "Initial bound: " << maxLen << (slack > 0 ? " (optimum + " + std::to_string(slack) + ")" : "")
+              << (clamped ? " (clamped, 128-bit distance set)" : "") << "\n";
     std::cout << std::endl;
 
     GolombRuler best;
+    EnergyMeter meter;
 
+    meter.start();
     auto start = std::chrono::high_resolution_clock::now();
-    searchGolombV5(n, maxLen, best, prefixDepth);
+    searchGolombV5(n, maxLen, best, options);
     auto end = std::chrono::high_resolution_clock::now();
+    const EnergyReading energy = meter.stop();
 
     double elapsed = std::chrono::duration<double>(end - start).count();
     long long explored = getExploredCountV5();
+    const SearchStatsV5& stats = getSearchStatsV5();
 
     std::cout << "n          : " << n << "\n";
     std::cout << "Length     : " << best.length << "\n";
     std::cout << std::fixed << std::setprecision(3);
     std::cout << "Time       : " << elapsed << " s\n";
     std::cout << "States     : " << explored << "\n";
+    if (options.deterministic) {
+        std::cout << "Det. states: " << stats.deterministicExplored << "\n";
+    }
+    std::cout << "Prefixes   : " << stats.prefixCount
+              << " (depth " << stats.minPrefixDepth << "-" << stats.maxPrefixDepth << ")\n";
     std::cout << std::scientific << std::setprecision(2);
     std::cout << "States/sec : " << (explored / elapsed) << "\n";
+    if (energy.valid) {
+        std::cout << "Energy     : " << std::fixed << std::setprecision(2) << energy.packageJ << " J pkg + "
+                  << energy.dramJ << " J dram (" << meter.source() << ")\n";
+        std::cout << "States/J   : " << std::scientific << std::setprecision(2) << (explored / energy.totalJ()) << "\n";
+    } else {
+        std::cout << "Energy     : n/a (no readable RAPL counters)\n";
+    }
+    if (!options.deterministic && (options.boundPolicy == BoundPolicy::Cached ||
+                                   options.boundPolicy == BoundPolicy::Epoch)) {
+        std::cout << "Bound reads: " << stats.boundPolicy.checks << " checks, "
+                  << stats.boundPolicy.refreshes << " refreshes, "
+                  << stats.boundPolicy.staleNodes << " stale nodes (<= "
+                  << std::fixed << std::setprecision(4)
+                  << (explored > 0 ? 100.0 * stats.boundPolicy.staleNodes / explored : 0.0)
+                  << "% of states)\n";
+    }
+
+    if (!stats.boundTimeline.empty()) {
+        std::cout << std::fixed << std::setprecision(4);
+        std::cout << "First sol. : " << stats.boundTimeline.front().time << " s\n";
+        std::cout << "Bound timeline:";
+        for (const BoundEventV5& event : stats.boundTimeline) {
+            std::cout << " " << event.length << "@" << event.time << "s"
+                      << (event.heuristic ? "(h)" : "");
+        }
+        std::cout << "\n";
+    }
+
+    if (!tracePath.empty()) {
+        if (writePrefixTrace(tracePath, stats.prefixCosts)) {
+            std::cout << "Trace      : " << tracePath << " (" << stats.prefixCosts.size() << " prefixes)\n";
+        } else {
+            std::cerr << "Error: cannot write " << tracePath << std::endl;
+        }
+    }
+
+    if (!digestPath.empty()) {
+        const DigestFileHeader header{n, maxLen, stats.prefixDepth, stats.finalBoundKey};
+        if (writePrefixDigests(digestPath, header, stats.digests)) {
+            std::cout << "Digests    : " << digestPath << " (" << stats.digests.size() << " prefixes)\n";
+        } else {
+            std::cerr << "Error: cannot write " << digestPath << std::endl;
+        }
+    }
+
+    bool auditOk = true;
+    if (auditFraction > 0.0) {
+        AuditReportV5 report;
+        auditPrefixesV5(n, maxLen, options, stats.digests, stats.finalBoundKey,
+                        auditFraction, auditSeed, report);
+        auditOk = printAuditReport(report);
+    }
 
     // Validate
     bool valid = GolombRuler::isValid(best.marks);
@@ -67,5 +641,5 @@ int main(int argc, char* argv[])
     std::cout << " }\n";
     std::cout << "=============================================================\n";
 
-    return valid ? 0 : 1;
+    return (valid && auditOk) ? 0 : 1;
 }
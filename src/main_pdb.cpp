@@ -0,0 +1,160 @@
+#include "pattern_db.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <omp.h>
+
+// =============================================================================
+// GOLOMB PDB - Pattern database generator (pattern_db.hpp)
+// =============================================================================
+//   golomb_pdb [--bits=K] [--marks=R] [--out=PATH] [--check=S]
+//
+// Builds span(r, mask) for r = 0..R and every mask of K bits (OpenMP over
+// the first gap), saves it, maps the file back and compares. --check=S
+// recomputes S random entries per row with a direct search.
+// =============================================================================
+
+namespace {
+
+// Shortest (r+1)-mark Golomb ruler avoiding the distances d <= bits of mask
+int directSpan(int r, int bits, uint32_t mask) {
+    int ruler[PDB_MAX_MARKS + 1] = {0};
+    bool used[256] = {false};
+    for (int d = 1; d <= bits; ++d) used[d] = (mask >> (d - 1)) & 1;
+    int best = 256;
+
+    auto dfs = [&](auto&& self, int count) -> void {
+        if (count == r + 1) {
+            best = std::min(best, ruler[count - 1]);
+            return;
+        }
+        const int remaining = r + 1 - count;
+        for (int pos = ruler[count - 1] + 1; pos + ((remaining - 1) * remaining) / 2 < best; ++pos) {
+            bool ok = true;
+            for (int i = 0; i < count && ok; ++i) ok = !used[pos - ruler[i]];
+            if (!ok) continue;
+            for (int i = 0; i < count; ++i) used[pos - ruler[i]] = true;
+            ruler[count] = pos;
+            self(self, count + 1);
+            for (int i = 0; i < count; ++i) used[pos - ruler[i]] = false;
+        }
+    };
+    dfs(dfs, 1);
+    return best;
+}
+
+void printUsage(const char* progName) {
+    std::cout << "Usage: " << progName << " [--bits=K] [--marks=R] [--out=PATH] [--check=S]\n"
+              << "  --bits=K     low distances indexed (" << PDB_MIN_BITS << ".." << PDB_MAX_BITS
+              << ", default " << PDB_DEFAULT_BITS << ")\n"
+              << "  --marks=R    rows r = 0..R (1.." << PDB_MAX_MARKS
+              << ", default " << PDB_DEFAULT_MARKS << ")\n"
+              << "  --out=PATH   default " << PatternDB::defaultPath(PDB_DEFAULT_BITS, PDB_DEFAULT_MARKS) << "\n"
+              << "  --check=S    verify S random entries per row by direct search\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int bits = PDB_DEFAULT_BITS;
+    int marks = PDB_DEFAULT_MARKS;
+    int checks = 0;
+    std::string out;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (std::strncmp(arg, "--bits=", 7) == 0) {
+            bits = std::atoi(arg + 7);
+        } else if (std::strncmp(arg, "--marks=", 8) == 0) {
+            marks = std::atoi(arg + 8);
+        } else if (std::strncmp(arg, "--out=", 6) == 0) {
+            out = arg + 6;
+        } else if (std::strncmp(arg, "--check=", 8) == 0) {
+            checks = std::atoi(arg + 8);
+        } else {
+            std::cerr << "ERROR: unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    if (out.empty()) out = PatternDB::defaultPath(bits, marks);
+
+    std::cout << "=============================================================\n";
+    std::cout << "     GOLOMB PATTERN DATABASE (k=" << bits << ", R=" << marks << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n";
+
+    PatternDB db;
+    const auto start = std::chrono::high_resolution_clock::now();
+    if (!db.build(bits, marks)) {
+        std::cerr << "ERROR: bits in " << PDB_MIN_BITS << ".." << PDB_MAX_BITS << ", marks in 1.."
+                  << PDB_MAX_MARKS << ", spans <= 255\n";
+        return 1;
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::cout << "Build      : " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double>(end - start).count() << " s\n";
+    std::cout << "Size       : " << db.bytes() / 1024 << " KB\n\n";
+
+    // Per row: triangular bound, full mask, mean gain over the triangular bound
+    const size_t size = size_t(1) << bits;
+    std::cout << std::setw(4) << "r" << std::setw(10) << "r(r+1)/2" << std::setw(8) << "max"
+              << std::setw(12) << "mean gain" << "\n";
+    std::cout << std::string(34, '-') << "\n";
+    for (int r = 0; r <= marks; ++r) {
+        const int triangular = (r * (r + 1)) / 2;
+        double gain = 0.0;
+        for (size_t mask = 0; mask < size; ++mask) {
+            gain += db.minSpan(r, static_cast<uint64_t>(mask) << 1) - triangular;
+        }
+        std::cout << std::setw(4) << r << std::setw(10) << triangular
+                  << std::setw(8) << db.minSpan(r, static_cast<uint64_t>(size - 1) << 1)
+                  << std::setw(12) << std::setprecision(2) << gain / static_cast<double>(size) << "\n";
+    }
+
+    int failures = 0;
+    if (checks > 0) {
+        std::mt19937_64 rng(12345);
+        for (int r = 0; r <= marks; ++r) {
+            for (int s = 0; s < checks; ++s) {
+                // Dense masks matter most: keep each bit with probability 3/4
+                uint32_t mask = static_cast<uint32_t>(rng() | rng()) & static_cast<uint32_t>(size - 1);
+                if (s == 0) mask = static_cast<uint32_t>(size - 1);
+                if (s == 1) mask = 0;
+                const int expected = directSpan(r, bits, mask);
+                const int got = db.minSpan(r, static_cast<uint64_t>(mask) << 1);
+                if (expected != got) {
+                    if (failures++ < 10) {
+                        std::cerr << "MISMATCH r=" << r << " mask=0x" << std::hex << mask << std::dec
+                                  << " table=" << got << " direct=" << expected << "\n";
+                    }
+                }
+            }
+        }
+        std::cout << "\nCheck      : " << checks * (marks + 1) << " entries, "
+                  << (failures == 0 ? "all match" : std::to_string(failures) + " MISMATCH") << "\n";
+    }
+
+    if (!db.save(out)) {
+        std::cerr << "ERROR: cannot write " << out << "\n";
+        return 1;
+    }
+    PatternDB mapped;
+    const bool reloaded = mapped.load(out) && mapped.bits() == bits && mapped.maxMarks() == marks;
+    bool same = reloaded;
+    for (int r = 0; same && r <= marks; ++r) {
+        for (size_t mask = 0; mask < size && same; ++mask) {
+            const uint64_t used = static_cast<uint64_t>(mask) << 1;
+            same = mapped.minSpan(r, used) == db.minSpan(r, used);
+        }
+    }
+    std::cout << "Saved      : " << out << (same ? " (reloaded, identical)" : " (RELOAD MISMATCH)") << "\n";
+    return (same && failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+#include "search_rect.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <omp.h>
+
+// =============================================================================
+// GOLOMB RECT - Golomb rectangles and Costas arrays
+// =============================================================================
+//   golomb_rect <width> <height>             largest N (Find for N = 2, 3, ...)
+//   golomb_rect <width> <height> --n=N       one N-point placement
+//   golomb_rect <width> <height> --n=N --count   symmetry classes
+//   golomb_rect --costas <N> [--count]       one Costas array / all of them
+// =============================================================================
+
+namespace {
+
+// Known numbers of Costas arrays (all / up to symmetry), N = 1..16
+const long long COSTAS_TOTAL[] = {0, 1, 2, 4, 12, 40, 116, 200, 444, 760, 2160, 4368, 7852,
+                                  12828, 17252, 19612, 21104};
+const long long COSTAS_CLASSES[] = {0, 1, 1, 1, 2, 6, 17, 30, 60, 100, 277, 555, 990,
+                                    1616, 2168, 2467, 2648};
+constexpr int COSTAS_KNOWN = 16;
+
+void printGrid(const std::vector<RectPoint>& points, int width, int height) {
+    std::vector<std::string> rows(static_cast<size_t>(height), std::string(static_cast<size_t>(width), '.'));
+    for (const RectPoint& p : points) {
+        rows[static_cast<size_t>(p.y)][static_cast<size_t>(p.x)] = 'X';
+    }
+    for (const std::string& row : rows) {
+        std::cout << "  ";
+        for (char ch : row) std::cout << ch << ' ';
+        std::cout << "\n";
+    }
+}
+
+void printPoints(const std::vector<RectPoint>& points) {
+    std::cout << "Points     : { ";
+    for (size_t i = 0; i < points.size(); ++i) {
+        std::cout << "(" << points[i].x << "," << points[i].y << ")";
+        if (i < points.size() - 1) std::cout << ", ";
+    }
+    std::cout << " }\n";
+}
+
+void printStats(const RectResult& result, double time) {
+    std::cout << "Bitmap     : " << result.words << " words, " << result.symmetries << " symmetries\n";
+    std::cout << "Prefixes   : " << result.prefixCount << " (depth " << result.prefixDepth << ")\n";
+    std::cout << "Time       : " << std::fixed << std::setprecision(3) << time << " s\n";
+    std::cout << "States     : " << result.explored << "\n";
+    std::cout << "States/sec : " << std::scientific << std::setprecision(2)
+              << (time > 0.0 ? result.explored / time : 0.0) << std::fixed << "\n";
+}
+
+int runSearch(const RectOptions& options) {
+    const int width = options.costas ? options.points : options.width;
+    const int height = options.costas ? options.points : options.height;
+
+    std::cout << "=============================================================\n";
+    if (options.costas) {
+        std::cout << "     COSTAS ARRAYS (N=" << options.points << ")\n";
+    } else {
+        std::cout << "     GOLOMB RECTANGLE (" << width << " x " << height << ", N="
+                  << options.points << ")\n";
+    }
+    std::cout << "=============================================================\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n";
+
+    RectResult result;
+    const auto start = std::chrono::high_resolution_clock::now();
+    if (!searchGolombRect(options, result)) {
+        std::cerr << "ERROR: unsupported size (side <= " << MAX_SIDE_RECT << ", N <= "
+                  << MAX_POINTS_RECT << ")\n";
+        return 1;
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double time = std::chrono::duration<double>(end - start).count();
+    printStats(result, time);
+
+    if (options.mode == RectMode::Count) {
+        std::cout << "Classes    : " << result.classes << " (up to symmetry";
+        std::cout << (options.costas ? ")\n" : " and translation)\n");
+        std::cout << "Placements : " << result.placements << "\n";
+        if (options.costas && options.points <= COSTAS_KNOWN) {
+            const bool match = result.placements == COSTAS_TOTAL[options.points] &&
+                               result.classes == COSTAS_CLASSES[options.points];
+            std::cout << "Known      : " << COSTAS_TOTAL[options.points] << " / "
+                      << COSTAS_CLASSES[options.points] << (match ? " (match)" : " (MISMATCH)") << "\n";
+            return match ? 0 : 1;
+        }
+        return 0;
+    }
+
+    if (!result.found) {
+        std::cout << "No placement of " << options.points << " points\n";
+        return 0;
+    }
+    const bool valid = isGolombRectangle(result.points, width, height);
+    std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
+    printPoints(result.points);
+    printGrid(result.points, width, height);
+    return valid ? 0 : 1;
+}
+
+int runMax(int width, int height, int prefixDepth) {
+    std::cout << "=============================================================\n";
+    std::cout << "     LARGEST GOLOMB RECTANGLE (" << width << " x " << height << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Threads    : " << omp_get_max_threads() << "\n\n";
+    std::cout << std::setw(5) << "N" << std::setw(8) << "Found" << std::setw(16) << "States"
+              << std::setw(11) << "Time(s)" << "\n";
+    std::cout << std::string(40, '-') << "\n";
+
+    RectResult result;
+    std::vector<RectResult> steps;
+    const auto start = std::chrono::high_resolution_clock::now();
+    const int best = maxGolombRect(width, height, prefixDepth, result, &steps);
+    const auto end = std::chrono::high_resolution_clock::now();
+    if (best < 0) {
+        std::cerr << "ERROR: unsupported size (side <= " << MAX_SIDE_RECT << ")\n";
+        return 1;
+    }
+
+    // Per-step times are not kept: states give the split, the total is timed
+    for (size_t i = 0; i < steps.size(); ++i) {
+        std::cout << std::setw(5) << i + 1 << std::setw(8) << (steps[i].found ? "yes" : "no")
+                  << std::setw(16) << steps[i].explored << "\n";
+    }
+    std::cout << std::string(40, '-') << "\n";
+    std::cout << "Largest N  : " << best << "\n";
+    std::cout << "Time       : " << std::fixed << std::setprecision(3)
+              << std::chrono::duration<double>(end - start).count() << " s\n";
+
+    const bool valid = isGolombRectangle(result.points, width, height);
+    std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
+    printPoints(result.points);
+    printGrid(result.points, width, height);
+    return valid ? 0 : 1;
+}
+
+void printUsage(const char* progName) {
+    std::cout << "Usage: " << progName << " <width> <height> [--n=N [--count]]\n"
+              << "       " << progName << " --costas <N> [--count]\n"
+              << "  (no --n)     largest N with distinct difference vectors\n"
+              << "  --n=N        one placement of N points\n"
+              << "  --count      every placement, one per symmetry class\n"
+              << "  --costas     N x N, one point per row and column\n"
+              << "  --depth=D    points per prefix (0 = auto)\n"
+              << "\nExamples:\n"
+              << "  " << progName << " 6 6\n"
+              << "  " << progName << " 10 5 --n=9\n"
+              << "  " << progName << " --costas 12 --count\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    RectOptions options;
+    std::vector<int> positional;
+    int prefixDepth = 0;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (std::strcmp(arg, "--costas") == 0) {
+            options.costas = true;
+        } else if (std::strcmp(arg, "--count") == 0) {
+            options.mode = RectMode::Count;
+        } else if (std::strncmp(arg, "--n=", 4) == 0) {
+            options.points = std::atoi(arg + 4);
+        } else if (std::strncmp(arg, "--depth=", 8) == 0) {
+            prefixDepth = std::atoi(arg + 8);
+        } else if (arg[0] != '-') {
+            positional.push_back(std::atoi(arg));
+        } else {
+            std::cerr << "ERROR: unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    options.prefixDepth = prefixDepth;
+
+    if (options.costas) {
+        if (positional.size() != 1 || positional[0] < 1 || positional[0] > MAX_SIDE_RECT) {
+            std::cerr << "ERROR: --costas takes N between 1 and " << MAX_SIDE_RECT << "\n";
+            return 1;
+        }
+        options.points = positional[0];
+        return runSearch(options);
+    }
+
+    if (positional.size() != 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    options.width = positional[0];
+    options.height = positional[1];
+    if (options.width < 1 || options.height < 1 ||
+        options.width > MAX_SIDE_RECT || options.height > MAX_SIDE_RECT) {
+        std::cerr << "ERROR: width and height must be between 1 and " << MAX_SIDE_RECT << "\n";
+        return 1;
+    }
+    if (options.points <= 0) {
+        return runMax(options.width, options.height, prefixDepth);
+    }
+    return runSearch(options);
+}
@@ -0,0 +1,464 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <unistd.h>
+
+#ifndef REGRESS_FLAGS
+#define REGRESS_FLAGS "unknown"
+#endif
+
+// =============================================================================
+// PERFORMANCE REGRESSION GATE - Engines vs a stored baseline
+// =============================================================================
+// Runs a fixed workload matrix through the engine binaries (build/golomb_*)
+// and compares each case with benchmarks/regression_baseline.csv:
+//
+//   length  : optimal length, exact
+//   states  : explored states, exact where the count is reproducible
+//             (sequential engines, V5 / MPI V3 "Det. states"); '-' otherwise
+//   time    : median over --reps runs, fails above baseline * (1 + tol) + slack
+//   rate    : median states/s, fails below baseline * t / (t * (1 + tol) + slack)
+//             with t the baseline time (same slack as the time check)
+//
+// Timing is only compared when the baseline was recorded on the same host:
+// elsewhere the correctness columns are checked and the timing is reported
+// as skipped. Record a new baseline with --update-baseline.
+//
+// Each run is a separate process, with OMP_NUM_THREADS set per case, MPI
+// through $MPIEXEC -n R (local ranks). The engines' own output is parsed:
+// "Length", "Time", "States" and "Det. states" lines.
+// =============================================================================
+
+struct RegressCase {
+    std::string id;        // Key in the baseline file
+    std::string binary;    // Under the build directory
+    std::string args;
+    int threads;           // OMP_NUM_THREADS
+    int ranks;             // 0 = no MPI
+    bool exactStates;      // Sequential "States" or deterministic "Det. states"
+};
+
+// Fixed matrix: n=10 everywhere (~0.05-0.2 s per run), n=11 where it is cheap
+static const std::vector<RegressCase> REGRESS_CASES = {
+    {"seq_v1_n10",      "golomb_sequential",    "10",                 1, 0, true},
+    {"seq_v2_n10",      "golomb_sequential_v2", "10",                 1, 0, true},
+    {"seq_v3_n10",      "golomb_sequential_v3", "10",                 1, 0, true},
+    {"seq_v4_n10",      "golomb_sequential_v4", "10",                 1, 0, true},
+    {"seq_v4_n11",      "golomb_sequential_v4", "11",                 1, 0, true},
+    {"omp_v1_n10",      "golomb_openmp",        "10",                 2, 0, false},
+    {"omp_v2_n10",      "golomb_openmp_v2",     "10",                 2, 0, false},
+    {"omp_v3_n10",      "golomb_openmp_v3",     "10",                 2, 0, false},
+    {"omp_v4_n10",      "golomb_openmp_v4",     "10",                 2, 0, false},
+    {"omp_v5_n10",      "golomb_openmp_v5",     "10",                 2, 0, false},
+    {"omp_v5_det_n10",  "golomb_openmp_v5",     "10 --deterministic", 2, 0, true},
+    {"omp_v5_det_n11",  "golomb_openmp_v5",     "11 --deterministic", 2, 0, true},
+    {"mpi_v3_det_n10",  "golomb_mpi_v3",        "10 --deterministic", 1, 2, true},
+};
+
+struct CaseResult {
+    bool ran = false;
+    bool ok = true;          // Every run exited 0 and printed a length
+    int length = 0;
+    long long states = -1;   // Exact count (-1 = not exact)
+    double time = 0.0;       // Median
+    double rate = 0.0;       // Median states/s
+    std::string error;
+};
+
+struct Baseline {
+    std::string host;
+    std::string flags;
+    std::map<std::string, CaseResult> cases;
+};
+
+struct RegressConfig {
+    std::string buildDir = "build";
+    std::string baselinePath = "benchmarks/regression_baseline.csv";
+    std::string mpiexec = "mpiexec";
+    std::string only;          // Substring filter on case ids
+    int reps = 5;
+    double timeTolerance = 0.15;
+    double timeSlack = 0.01;   // Seconds: absorbs jitter on short runs
+    double rateTolerance = 0.15;
+    bool update = false;
+    bool skipMpi = false;
+};
+
+static std::string hostName() {
+    char buffer[256] = {0};
+    if (gethostname(buffer, sizeof(buffer) - 1) != 0) return "unknown";
+    return buffer;
+}
+
+static double median(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    const size_t mid = values.size() / 2;
+    return (values.size() % 2) ? values[mid] : 0.5 * (values[mid - 1] + values[mid]);
+}
+
+// "Key   : value" -> value for the wanted key (exact match after trimming)
+static bool parseField(const std::string& line, const std::string& key, std::string& value) {
+    const size_t colon = line.find(':');
+    if (colon == std::string::npos) return false;
+    std::string name = line.substr(0, colon);
+    while (!name.empty() && name.back() == ' ') name.pop_back();
+    if (name != key) return false;
+    value = line.substr(colon + 1);
+    return true;
+}
+
+// =============================================================================
+// ONE RUN - popen the engine, parse its summary
+// =============================================================================
+struct RunOutput {
+    int status = -1;
+    int length = 0;
+    double time = 0.0;
+    long long states = -1;
+    long long detStates = -1;
+};
+
+static RunOutput runOnce(const RegressCase& c, const RegressConfig& config) {
+    std::ostringstream cmd;
+    cmd << "OMP_NUM_THREADS=" << c.threads << " ";
+    if (c.ranks > 0) {
+        cmd << config.mpiexec << " -n " << c.ranks << " ";
+    }
+    cmd << config.buildDir << "/" << c.binary << " " << c.args << " 2>&1";
+
+    RunOutput out;
+    FILE* pipe = popen(cmd.str().c_str(), "r");
+    if (!pipe) return out;
+
+    char buffer[512];
+    std::string value;
+    while (fgets(buffer, sizeof(buffer), pipe)) {
+        const std::string line(buffer);
+        if (parseField(line, "Length", value)) {
+            out.length = std::atoi(value.c_str());
+        } else if (parseField(line, "Time", value)) {
+            out.time = std::atof(value.c_str());
+        } else if (parseField(line, "States", value)) {
+            out.states = std::atoll(value.c_str());
+        } else if (parseField(line, "Det. states", value)) {
+            out.detStates = std::atoll(value.c_str());
+        }
+    }
+    out.status = pclose(pipe);
+    return out;
+}
+
+static CaseResult runCase(const RegressCase& c, const RegressConfig& config) {
+    CaseResult result;
+    result.ran = true;
+
+    std::vector<double> times;
+    std::vector<double> rates;
+    for (int rep = 0; rep < config.reps; ++rep) {
+        const RunOutput out = runOnce(c, config);
+        if (out.status != 0 || out.length <= 0 || out.states < 0) {
+            result.ok = false;
+            result.error = "run " + std::to_string(rep + 1) + " failed (exit status " +
+                           std::to_string(out.status) + ")";
+            return result;
+        }
+
+        const long long exact = (c.exactStates && out.detStates >= 0) ? out.detStates
+                              : (c.exactStates ? out.states : -1);
+        if (rep == 0) {
+            result.length = out.length;
+            result.states = exact;
+        } else if (out.length != result.length || exact != result.states) {
+            // An exact count that moves between runs is itself a regression
+            result.ok = false;
+            result.error = "not reproducible across runs";
+            return result;
+        }
+        times.push_back(out.time);
+        rates.push_back(out.time > 0.0 ? static_cast<double>(out.states) / out.time : 0.0);
+    }
+    result.time = median(times);
+    result.rate = median(rates);
+    return result;
+}
+
+// =============================================================================
+// BASELINE FILE
+// =============================================================================
+//   # golomb-regress host=<host> flags=<OPTFLAGS>
+//   case,length,states,median_time,median_rate
+static bool readBaseline(const std::string& path, Baseline& baseline) {
+    std::ifstream file(path);
+    if (!file) return false;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("# golomb-regress", 0) == 0) {
+            // flags= comes last and may contain spaces
+            const size_t flags = line.find(" flags=");
+            if (flags != std::string::npos) baseline.flags = line.substr(flags + 7);
+            std::istringstream iss(line.substr(16, flags == std::string::npos ? std::string::npos : flags - 16));
+            std::string field;
+            while (iss >> field) {
+                if (field.rfind("host=", 0) == 0) baseline.host = field.substr(5);
+            }
+            continue;
+        }
+        if (line.empty() || line[0] == '#' || line.rfind("case,", 0) == 0) continue;
+
+        std::istringstream iss(line);
+        std::string id, length, states, time, rate;
+        if (!std::getline(iss, id, ',') || !std::getline(iss, length, ',') ||
+            !std::getline(iss, states, ',') || !std::getline(iss, time, ',') ||
+            !std::getline(iss, rate, ',')) {
+            continue;
+        }
+        CaseResult r;
+        r.ran = true;
+        r.length = std::atoi(length.c_str());
+        r.states = (states == "-") ? -1 : std::atoll(states.c_str());
+        r.time = std::atof(time.c_str());
+        r.rate = std::atof(rate.c_str());
+        baseline.cases[id] = r;
+    }
+    return true;
+}
+
+static bool writeBaseline(const std::string& path, const std::vector<RegressCase>& cases,
+                          const std::vector<CaseResult>& results, const Baseline& previous) {
+    // Cases not run this time (filter, --no-mpi) keep their previous entry
+    std::map<std::string, CaseResult> merged = previous.cases;
+    for (size_t i = 0; i < cases.size(); ++i) {
+        if (results[i].ran && results[i].ok) merged[cases[i].id] = results[i];
+    }
+
+    std::ofstream file(path);
+    if (!file) return false;
+    file << "# golomb-regress host=" << hostName() << " flags=" << REGRESS_FLAGS << "\n";
+    file << "case,length,states,median_time,median_rate\n";
+    for (const RegressCase& c : REGRESS_CASES) {
+        const auto it = merged.find(c.id);
+        if (it == merged.end()) continue;
+        const CaseResult& r = it->second;
+        file << c.id << "," << r.length << ",";
+        if (r.states >= 0) file << r.states; else file << "-";
+        file << "," << std::fixed << std::setprecision(5) << r.time
+             << "," << std::scientific << std::setprecision(4) << r.rate << "\n";
+        file.unsetf(std::ios::floatfield);
+    }
+    return static_cast<bool>(file);
+}
+
+// =============================================================================
+// COMPARISON - One line per check that did not pass
+// =============================================================================
+struct Finding {
+    std::string id;
+    std::string metric;
+    std::string baseline;
+    std::string current;
+    std::string verdict;   // FAIL / faster / skipped
+};
+
+static std::string formatDouble(double value, int precision, bool scientific) {
+    std::ostringstream oss;
+    if (scientific) oss << std::scientific; else oss << std::fixed;
+    oss << std::setprecision(precision) << value;
+    return oss.str();
+}
+
+static std::string formatDelta(double baseline, double current) {
+    if (baseline <= 0.0) return "";
+    std::ostringstream oss;
+    oss << std::showpos << std::fixed << std::setprecision(1)
+        << 100.0 * (current - baseline) / baseline << "%";
+    return oss.str();
+}
+
+static void compareCase(const RegressCase& c, const CaseResult& cur, const CaseResult& base,
+                        bool compareTiming, const RegressConfig& config,
+                        std::vector<Finding>& findings) {
+    if (cur.length != base.length) {
+        findings.push_back({c.id, "length", std::to_string(base.length),
+                            std::to_string(cur.length), "FAIL"});
+    }
+    if (base.states >= 0 && cur.states != base.states) {
+        const long long diff = cur.states - base.states;
+        findings.push_back({c.id, "states", std::to_string(base.states),
+                            std::to_string(cur.states) + " (" + (diff > 0 ? "+" : "") + std::to_string(diff) + ")",
+                            "FAIL"});
+    }
+    if (!compareTiming) return;
+
+    const double maxTime = base.time * (1.0 + config.timeTolerance) + config.timeSlack;
+    if (cur.time > maxTime) {
+        findings.push_back({c.id, "time", formatDouble(base.time, 4, false) + " s",
+                            formatDouble(cur.time, 4, false) + " s (" + formatDelta(base.time, cur.time) + ")",
+                            "FAIL"});
+    } else if (cur.time < base.time * (1.0 - config.timeTolerance) - config.timeSlack) {
+        findings.push_back({c.id, "time", formatDouble(base.time, 4, false) + " s",
+                            formatDouble(cur.time, 4, false) + " s (" + formatDelta(base.time, cur.time) + ")",
+                            "faster"});
+    }
+
+    const double minRate = base.rate * base.time /
+                           (base.time * (1.0 + config.rateTolerance) + config.timeSlack);
+    if (cur.rate < minRate) {
+        findings.push_back({c.id, "states/s", formatDouble(base.rate, 3, true),
+                            formatDouble(cur.rate, 3, true) + " (" + formatDelta(base.rate, cur.rate) + ")",
+                            "FAIL"});
+    }
+}
+
+static void printUsage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [options]" << std::endl;
+    std::cerr << "  --baseline=FILE   : baseline (default benchmarks/regression_baseline.csv)" << std::endl;
+    std::cerr << "  --update-baseline : record the current results as the new baseline" << std::endl;
+    std::cerr << "  --reps=K          : runs per case, median kept (default 5)" << std::endl;
+    std::cerr << "  --time-tol=F      : allowed median time increase (default 0.15)" << std::endl;
+    std::cerr << "  --time-slack=S    : absolute time slack in seconds (default 0.01)" << std::endl;
+    std::cerr << "  --rate-tol=F      : allowed states/s decrease (default 0.15)" << std::endl;
+    std::cerr << "  --build-dir=DIR   : engine binaries (default build)" << std::endl;
+    std::cerr << "  --mpiexec=CMD     : MPI launcher (default mpiexec)" << std::endl;
+    std::cerr << "  --no-mpi          : skip the MPI cases" << std::endl;
+    std::cerr << "  --only=SUBSTR     : run the cases whose id contains SUBSTR" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    RegressConfig config;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (arg.rfind("--baseline=", 0) == 0) config.baselinePath = value;
+        else if (arg == "--update-baseline") config.update = true;
+        else if (arg.rfind("--reps=", 0) == 0) config.reps = std::max(1, std::atoi(value.c_str()));
+        else if (arg.rfind("--time-tol=", 0) == 0) config.timeTolerance = std::atof(value.c_str());
+        else if (arg.rfind("--time-slack=", 0) == 0) config.timeSlack = std::atof(value.c_str());
+        else if (arg.rfind("--rate-tol=", 0) == 0) config.rateTolerance = std::atof(value.c_str());
+        else if (arg.rfind("--build-dir=", 0) == 0) config.buildDir = value;
+        else if (arg.rfind("--mpiexec=", 0) == 0) config.mpiexec = value;
+        else if (arg == "--no-mpi") config.skipMpi = true;
+        else if (arg.rfind("--only=", 0) == 0) config.only = value;
+        else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    Baseline baseline;
+    const bool haveBaseline = readBaseline(config.baselinePath, baseline);
+    if (!haveBaseline && !config.update) {
+        std::cerr << "Error: no baseline at " << config.baselinePath
+                  << " (create it with --update-baseline)" << std::endl;
+        return 1;
+    }
+    const bool sameHost = haveBaseline && baseline.host == hostName();
+
+    std::cout << "=============================================================\n";
+    std::cout << "       GOLOMB PERFORMANCE REGRESSION GATE\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Baseline : " << config.baselinePath;
+    if (haveBaseline) std::cout << " (host " << baseline.host << ", flags " << baseline.flags << ")";
+    std::cout << "\n";
+    std::cout << "Host     : " << hostName() << "\n";
+    std::cout << "Reps     : " << config.reps << " (median), time tol "
+              << config.timeTolerance * 100.0 << "% + " << config.timeSlack << " s, rate tol "
+              << config.rateTolerance * 100.0 << "%\n";
+    if (haveBaseline && !sameHost && !config.update) {
+        std::cout << "Timing   : skipped (baseline from another host), lengths and exact states checked\n";
+    }
+    std::cout << std::endl;
+
+    std::cout << std::left << std::setw(18) << "case" << std::right
+              << std::setw(6) << "len" << std::setw(14) << "states"
+              << std::setw(11) << "time (s)" << std::setw(12) << "states/s" << "  status\n";
+    std::cout << std::string(68, '-') << "\n";
+
+    std::vector<CaseResult> results(REGRESS_CASES.size());
+    std::vector<Finding> findings;
+    int failures = 0;
+
+    for (size_t i = 0; i < REGRESS_CASES.size(); ++i) {
+        const RegressCase& c = REGRESS_CASES[i];
+        if (!config.only.empty() && c.id.find(config.only) == std::string::npos) continue;
+        if (c.ranks > 0 && config.skipMpi) continue;
+
+        if (access((config.buildDir + "/" + c.binary).c_str(), X_OK) != 0) {
+            std::cout << std::left << std::setw(18) << c.id << std::right
+                      << "  missing " << config.buildDir << "/" << c.binary << "\n";
+            findings.push_back({c.id, "binary", "", "missing", "FAIL"});
+            failures++;
+            continue;
+        }
+
+        CaseResult& r = results[i];
+        r = runCase(c, config);
+
+        std::string status = "ok";
+        if (!r.ok) {
+            status = r.error;
+            findings.push_back({c.id, "run", "", r.error, "FAIL"});
+        } else if (!config.update) {
+            const auto it = baseline.cases.find(c.id);
+            if (it == baseline.cases.end()) {
+                status = "new (not in baseline)";
+            } else {
+                const size_t before = findings.size();
+                compareCase(c, r, it->second, sameHost, config, findings);
+                for (size_t f = before; f < findings.size(); ++f) {
+                    if (findings[f].verdict == "FAIL") status = "FAIL";
+                    else if (status == "ok") status = findings[f].verdict;
+                }
+            }
+        }
+        if (status != "ok" && status != "faster" && status.rfind("new", 0) != 0) failures++;
+
+        std::cout << std::left << std::setw(18) << c.id << std::right
+                  << std::setw(6) << r.length
+                  << std::setw(14) << (r.states >= 0 ? std::to_string(r.states) : "-")
+                  << std::setw(11) << std::fixed << std::setprecision(4) << r.time
+                  << std::setw(12) << std::scientific << std::setprecision(2) << r.rate
+                  << "  " << status << "\n";
+        std::cout.unsetf(std::ios::floatfield);
+    }
+    std::cout << std::string(68, '-') << "\n";
+
+    if (config.update) {
+        if (failures > 0) {
+            std::cerr << "Error: " << failures << " case(s) failed, baseline not written" << std::endl;
+            return 1;
+        }
+        if (!writeBaseline(config.baselinePath, REGRESS_CASES, results, baseline)) {
+            std::cerr << "Error: cannot write " << config.baselinePath << std::endl;
+            return 1;
+        }
+        std::cout << "Baseline written: " << config.baselinePath << "\n";
+        return 0;
+    }
+
+    if (!findings.empty()) {
+        std::cout << "\n" << std::left << std::setw(18) << "case" << std::setw(10) << "metric"
+                  << std::setw(18) << "baseline" << std::setw(28) << "current" << "verdict\n";
+        for (const Finding& f : findings) {
+            std::cout << std::setw(18) << f.id << std::setw(10) << f.metric
+                      << std::setw(18) << f.baseline << std::setw(28) << f.current << f.verdict << "\n";
+        }
+        std::cout << std::right;
+    }
+
+    std::cout << "\nResult: " << (failures == 0 ? "PASS" : "FAIL (" + std::to_string(failures) + " case(s))") << "\n";
+    std::cout << "=============================================================\n";
+    return failures == 0 ? 0 : 1;
+}
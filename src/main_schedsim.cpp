@@ -0,0 +1,355 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <queue>
+#include <deque>
+#include <algorithm>
+#include <functional>
+#include <cstdint>
+#include <cstdlib>
+#include "prefix_split.hpp"
+#include "prefix_trace.hpp"
+
+// =============================================================================
+// OFFLINE SCHEDULER SIMULATOR - Replays recorded per-prefix costs
+// =============================================================================
+// Input: a prefix cost trace (golomb_openmp_v5 --trace=FILE or
+// golomb_mpi_v3 --trace=FILE). Each prefix is a task of fixed cost; the
+// simulator predicts the makespan of several dispatch policies for any
+// number of workers P:
+//
+//   static-rr  : prefix i -> rank i % R, dynamic,1 among T threads (MPI V3
+//                distribution without the sync rounds)
+//   dynamic    : OpenMP schedule(dynamic, 1) over all P workers, in order
+//   lpt        : longest processing time first (needs costs in advance)
+//   stealing   : contiguous blocks per worker, idle workers steal half of a
+//                random victim's remaining queue
+//   lockstep   : MPI V3 as implemented: round-robin ranks, SYNC_INTERVAL
+//                prefixes per round, every round ends with an allreduce
+//
+// Costs are fixed: bound improvements that would shrink later prefixes are
+// not modelled, so record traces with the bound at the optimum (the default
+// of the drivers) for a schedule-independent workload.
+// =============================================================================
+
+struct SimConfig {
+    int threadsPerRank = 1;     // T: workers per MPI rank (static-rr, lockstep)
+    int syncInterval = 64;      // Prefixes per rank and round (lockstep)
+    double syncLatency = 20e-6; // Allreduce latency per round (s)
+    double dispatchCost = 0.0;  // Per-task dispatch overhead (dynamic, static-rr)
+    double stealCost = 2e-6;    // Per steal attempt (stealing)
+    uint64_t seed = 1;
+};
+
+struct SimResult {
+    std::string policy;
+    int workers;
+    std::string layout;  // ranks x threads (static-rr, lockstep), empty otherwise
+    double makespan;
+};
+
+// =============================================================================
+// LIST SCHEDULING - Tasks in the given order, each to the earliest free worker
+// =============================================================================
+static double listSchedule(const std::vector<double>& costs, const std::vector<int>& order,
+                           int workers, double dispatchCost) {
+    std::priority_queue<double, std::vector<double>, std::greater<double>> freeAt;
+    for (int w = 0; w < workers; ++w) freeAt.push(0.0);
+
+    double makespan = 0.0;
+    for (int i : order) {
+        const double start = freeAt.top();
+        freeAt.pop();
+        const double end = start + dispatchCost + costs[static_cast<size_t>(i)];
+        makespan = std::max(makespan, end);
+        freeAt.push(end);
+    }
+    return makespan;
+}
+
+static std::vector<int> identityOrder(size_t count) {
+    std::vector<int> order(count);
+    for (size_t i = 0; i < count; ++i) order[i] = static_cast<int>(i);
+    return order;
+}
+
+static double simulateDynamic(const std::vector<double>& costs, int workers, const SimConfig& config) {
+    return listSchedule(costs, identityOrder(costs.size()), workers, config.dispatchCost);
+}
+
+static double simulateLPT(const std::vector<double>& costs, int workers) {
+    std::vector<int> order = identityOrder(costs.size());
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return costs[static_cast<size_t>(a)] > costs[static_cast<size_t>(b)]; });
+    return listSchedule(costs, order, workers, 0.0);
+}
+
+// MPI layout of P workers with T threads per rank: P / T ranks, the
+// P % T leftover workers go one each to the last ranks (P < T: one rank of P)
+static std::vector<int> rankThreads(int workers, int threadsPerRank) {
+    const int T = std::max(1, threadsPerRank);
+    const int ranks = std::max(1, workers / T);
+    std::vector<int> threads(static_cast<size_t>(ranks), workers / ranks);
+    for (int r = ranks - workers % ranks; r < ranks; ++r) threads[static_cast<size_t>(r)]++;
+    return threads;
+}
+
+// "8x48" or "6x48+2x49": the layout actually simulated
+static std::string describeLayout(const std::vector<int>& threads) {
+    std::string text;
+    size_t i = 0;
+    while (i < threads.size()) {
+        size_t j = i;
+        while (j < threads.size() && threads[j] == threads[i]) ++j;
+        if (!text.empty()) text += '+';
+        text += std::to_string(j - i) + 'x' + std::to_string(threads[i]);
+        i = j;
+    }
+    return text;
+}
+
+static double simulateStaticRR(const std::vector<double>& costs, int workers, const SimConfig& config) {
+    const std::vector<int> threads = rankThreads(workers, config.threadsPerRank);
+    const size_t ranks = threads.size();
+
+    double makespan = 0.0;
+    for (size_t r = 0; r < ranks; ++r) {
+        std::vector<int> mine;
+        for (size_t i = r; i < costs.size(); i += ranks) {
+            mine.push_back(static_cast<int>(i));
+        }
+        makespan = std::max(makespan, listSchedule(costs, mine, threads[r], config.dispatchCost));
+    }
+    return makespan;
+}
+
+static double simulateLockstep(const std::vector<double>& costs, int workers, const SimConfig& config) {
+    const std::vector<int> threads = rankThreads(workers, config.threadsPerRank);
+    const size_t ranks = threads.size();
+    const size_t perRank = (costs.size() + ranks - 1) / ranks;
+    const size_t S = static_cast<size_t>(std::max(1, config.syncInterval));
+
+    double makespan = 0.0;
+    for (size_t start = 0; start < perRank; start += S) {
+        double roundTime = 0.0;
+        for (size_t r = 0; r < ranks; ++r) {
+            // Local indices [start, start + S) of rank r -> global r + k * ranks
+            std::vector<int> chunk;
+            for (size_t k = start; k < start + S; ++k) {
+                const size_t i = r + k * ranks;
+                if (i >= costs.size()) break;
+                chunk.push_back(static_cast<int>(i));
+            }
+            roundTime = std::max(roundTime, listSchedule(costs, chunk, threads[r], config.dispatchCost));
+        }
+        makespan += roundTime + config.syncLatency;
+    }
+    return makespan;
+}
+
+// Event-driven: each worker pops from the front of its own deque; an idle
+// worker steals the back half of a random non-empty victim's deque.
+static double simulateStealing(const std::vector<double>& costs, int workers, const SimConfig& config) {
+    const size_t N = costs.size();
+    std::vector<std::deque<int>> queues(static_cast<size_t>(workers));
+    for (int w = 0; w < workers; ++w) {
+        const size_t begin = N * static_cast<size_t>(w) / static_cast<size_t>(workers);
+        const size_t end = N * static_cast<size_t>(w + 1) / static_cast<size_t>(workers);
+        for (size_t i = begin; i < end; ++i) queues[static_cast<size_t>(w)].push_back(static_cast<int>(i));
+    }
+
+    using Event = std::pair<double, int>;  // (time the worker becomes free, worker)
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+    for (int w = 0; w < workers; ++w) events.push(Event{0.0, w});
+
+    uint64_t rng = config.seed;
+    size_t remaining = N;
+    double makespan = 0.0;
+
+    while (!events.empty()) {
+        auto [now, w] = events.top();
+        events.pop();
+        std::deque<int>& own = queues[static_cast<size_t>(w)];
+
+        if (!own.empty()) {
+            const int task = own.front();
+            own.pop_front();
+            remaining--;
+            const double end = now + costs[static_cast<size_t>(task)];
+            makespan = std::max(makespan, end);
+            events.push(Event{end, w});
+            continue;
+        }
+        if (remaining == 0) continue;  // Worker retires
+
+        // One steal attempt on a random victim
+        const int victim = static_cast<int>(prefix_split::splitmix64(rng) % static_cast<uint64_t>(workers));
+        std::deque<int>& other = queues[static_cast<size_t>(victim)];
+        const size_t take = (other.size() + 1) / 2;
+        for (size_t k = 0; k < take; ++k) {
+            own.push_front(other.back());
+            other.pop_back();
+        }
+        events.push(Event{now + config.stealCost, w});
+    }
+    return makespan;
+}
+
+// =============================================================================
+// MAIN
+// =============================================================================
+static std::vector<int> parseList(const std::string& text) {
+    std::vector<int> values;
+    std::istringstream list(text);
+    std::string item;
+    while (std::getline(list, item, ',')) {
+        if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <trace.csv> [options]" << std::endl;
+        std::cerr << "  --procs=P1,P2,...   : worker counts to simulate (default 1,8,32,192,384,768)" << std::endl;
+        std::cerr << "  --threads=T         : threads per rank for static-rr/lockstep (default 1)" << std::endl;
+        std::cerr << "  --sync-interval=S   : prefixes per rank and round (default 64, SYNC_INTERVAL_V3)" << std::endl;
+        std::cerr << "  --sync-latency=SEC  : allreduce latency per round (default 20e-6)" << std::endl;
+        std::cerr << "  --dispatch=SEC      : per-task dispatch overhead (default 0)" << std::endl;
+        std::cerr << "  --steal=SEC         : cost of one steal attempt (default 2e-6)" << std::endl;
+        std::cerr << "  --cost=time|nodes   : task cost column (nodes scaled to the trace's rate)" << std::endl;
+        std::cerr << "  --csv=FILE          : also write results as CSV" << std::endl;
+        return 1;
+    }
+
+    const std::string tracePath = argv[1];
+    std::vector<int> procs = {1, 8, 32, 192, 384, 768};
+    SimConfig config;
+    bool useNodes = false;
+    std::string csvPath;
+
+    for (int i = 2; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const size_t eq = arg.find('=');
+        const std::string value = (eq == std::string::npos) ? "" : arg.substr(eq + 1);
+
+        if (arg.rfind("--procs=", 0) == 0) procs = parseList(value);
+        else if (arg.rfind("--threads=", 0) == 0) config.threadsPerRank = std::atoi(value.c_str());
+        else if (arg.rfind("--sync-interval=", 0) == 0) config.syncInterval = std::atoi(value.c_str());
+        else if (arg.rfind("--sync-latency=", 0) == 0) config.syncLatency = std::atof(value.c_str());
+        else if (arg.rfind("--dispatch=", 0) == 0) config.dispatchCost = std::atof(value.c_str());
+        else if (arg.rfind("--steal=", 0) == 0) config.stealCost = std::atof(value.c_str());
+        else if (arg.rfind("--cost=", 0) == 0) useNodes = (value == "nodes");
+        else if (arg.rfind("--csv=", 0) == 0) csvPath = value;
+        else {
+            std::cerr << "Error: unknown option " << arg << std::endl;
+            return 1;
+        }
+    }
+
+    std::vector<PrefixCost> trace;
+    if (!readPrefixTrace(tracePath, trace) || trace.empty()) {
+        std::cerr << "Error: cannot read trace " << tracePath << std::endl;
+        return 1;
+    }
+    std::sort(trace.begin(), trace.end(),
+              [](const PrefixCost& a, const PrefixCost& b) { return a.index < b.index; });
+
+    // Task costs in seconds
+    double totalTime = 0.0;
+    long long totalNodes = 0;
+    for (const PrefixCost& c : trace) {
+        totalTime += c.time;
+        totalNodes += c.nodes;
+    }
+    const double secondsPerNode = (totalNodes > 0) ? totalTime / static_cast<double>(totalNodes) : 0.0;
+
+    std::vector<double> costs;
+    costs.reserve(trace.size());
+    double maxCost = 0.0;
+    for (const PrefixCost& c : trace) {
+        costs.push_back(useNodes ? static_cast<double>(c.nodes) * secondsPerNode : c.time);
+        maxCost = std::max(maxCost, costs.back());
+    }
+    double work = 0.0;
+    for (double c : costs) work += c;
+
+    std::cout << "=============================================================\n";
+    std::cout << "       GOLOMB SCHEDULER SIMULATOR\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Trace        : " << tracePath << "\n";
+    std::cout << "Prefixes     : " << costs.size() << "\n";
+    std::cout << std::scientific << std::setprecision(3);
+    std::cout << "Total work   : " << work << " s (" << (useNodes ? "nodes" : "time") << ")\n";
+    std::cout << "Largest task : " << maxCost << " s\n";
+    std::cout << "Threads/rank : " << config.threadsPerRank
+              << "  sync every " << config.syncInterval << " prefixes, latency "
+              << config.syncLatency << " s\n";
+    std::cout << std::endl;
+
+    struct Policy {
+        const char* name;
+        bool ranked;  // Uses the ranks x threads layout
+        std::function<double(int)> run;
+    };
+    const std::vector<Policy> policies = {
+        {"static-rr", true,  [&](int P) { return simulateStaticRR(costs, P, config); }},
+        {"dynamic",   false, [&](int P) { return simulateDynamic(costs, P, config); }},
+        {"lpt",       false, [&](int P) { return simulateLPT(costs, P); }},
+        {"stealing",  false, [&](int P) { return simulateStealing(costs, P, config); }},
+        {"lockstep",  true,  [&](int P) { return simulateLockstep(costs, P, config); }},
+    };
+
+    std::vector<SimResult> results;
+
+    std::cout << std::setw(6) << "P" << std::setw(12) << "policy"
+              << std::setw(14) << "makespan_s" << std::setw(10) << "speedup"
+              << std::setw(10) << "eff_%" << std::setw(14) << "lower_bnd_s" << "  ranks\n";
+    std::cout << std::string(78, '-') << "\n";
+
+    bool unevenLayout = false;
+    for (int P : procs) {
+        if (P < 1) continue;
+        const double lowerBound = std::max(work / P, maxCost);
+        const std::string layout = describeLayout(rankThreads(P, config.threadsPerRank));
+        unevenLayout = unevenLayout || P % std::max(1, config.threadsPerRank) != 0;
+        for (const Policy& policy : policies) {
+            const double makespan = policy.run(P);
+            results.push_back(SimResult{policy.name, P, policy.ranked ? layout : "", makespan});
+
+            std::cout << std::setw(6) << P << std::setw(12) << policy.name
+                      << std::scientific << std::setprecision(3) << std::setw(14) << makespan
+                      << std::fixed << std::setprecision(2) << std::setw(10) << (work / makespan)
+                      << std::setprecision(1) << std::setw(10) << (100.0 * work / (P * makespan))
+                      << std::scientific << std::setprecision(3) << std::setw(14) << lowerBound
+                      << (policy.ranked ? "  " + layout : "") << "\n";
+        }
+    }
+    std::cout << "=============================================================\n";
+    if (unevenLayout) {
+        std::cout << "P not a multiple of T=" << config.threadsPerRank
+                  << ": leftover workers added to the last ranks (see ranks column)\n";
+    }
+
+    if (!csvPath.empty()) {
+        std::ofstream csv(csvPath);
+        if (!csv) {
+            std::cerr << "Error: cannot write " << csvPath << std::endl;
+            return 1;
+        }
+        csv << "trace,prefixes,workers,threads_per_rank,policy,makespan_s,speedup,efficiency_pct,rank_layout\n";
+        csv << std::setprecision(9);
+        for (const SimResult& r : results) {
+            csv << tracePath << "," << costs.size() << "," << r.workers << ","
+                << config.threadsPerRank << "," << r.policy << "," << r.makespan << ","
+                << (work / r.makespan) << "," << (100.0 * work / (r.workers * r.makespan)) << ","
+                << r.layout << "\n";
+        }
+    }
+
+    return 0;
+}
@@ -147,13 +147,16 @@ void runPerformanceBenchmark() {
 
     // Logger CSV
     BenchmarkLog logger("benchmarks", "sequential");
+    EnergyMeter meter;
 
     for (int n : BENCH_SIZES) {
         GolombRuler result;
 
+        meter.start();
         auto start = std::chrono::high_resolution_clock::now();
         searchGolombSequential(n, DEFAULT_MAX_LEN, result);
         auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = meter.stop();
 
         double time = std::chrono::duration<double>(end - start).count();
         long long states = getExploredCountSequential();
@@ -190,7 +193,7 @@ void runPerformanceBenchmark() {
         std::cout << " }\n\n";
 
         // Log to CSV
-        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential optimized");
+        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential optimized", energy);
     }
 
     std::cout << "=============================================================\n";
@@ -141,13 +141,16 @@ void runPerformanceBenchmark() {
     std::cout << std::string(76, '-') << "\n";
 
     BenchmarkLog logger("benchmarks", "sequential_v2");
+    EnergyMeter meter;
 
     for (int n : BENCH_SIZES) {
         GolombRuler result;
 
+        meter.start();
         auto start = std::chrono::high_resolution_clock::now();
         searchGolombSequentialV2(n, DEFAULT_MAX_LEN, result);
         auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = meter.stop();
 
         double time = std::chrono::duration<double>(end - start).count();
         long long states = getExploredCountSequentialV2();
@@ -181,7 +184,7 @@ void runPerformanceBenchmark() {
         }
         std::cout << " }\n\n";
 
-        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential V2 (BitSet128)");
+        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential V2 (BitSet128)", energy);
     }
 
     std::cout << "=============================================================\n";
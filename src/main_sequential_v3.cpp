@@ -1,5 +1,6 @@
 #include "search_sequential_v3.hpp"
 #include "benchmark_log.hpp"
+#include "simd_bitset.hpp"
 #include <iostream>
 #include <chrono>
 #include <vector>
@@ -8,11 +9,11 @@
 #include <cassert>
 
 // =============================================================================
-// BENCHMARK SEQUENTIAL V3 - SIMD optimized (SSE2)
+// BENCHMARK SEQUENTIAL V3 - SIMD optimized (SSE / NEON)
 // =============================================================================
 // Key improvements over V2:
-// - Native __m128i SIMD operations
-// - Single instruction any() with _mm_testz_si128
+// - 128-bit vector operations (simd_bitset.hpp)
+// - Branch-free shift, single instruction any()
 // - Avoid double shift by reusing new_dist
 // - Local bestLen cache
 // - Prefetch next stack frame
@@ -127,8 +128,8 @@ void runPerformanceBenchmark() {
     std::cout << "                  BENCHMARK DE PERFORMANCE\n";
     std::cout << "=============================================================\n";
     std::cout << "Sequential V3 Optimizations:\n";
-    std::cout << "  - Native __m128i SIMD operations (SSE2)\n";
-    std::cout << "  - Single instruction any() with _mm_testz_si128\n";
+    std::cout << "  - 128-bit vector operations (" << GOLOMB_SIMD_BACKEND << ")\n";
+    std::cout << "  - Branch-free shift, single instruction any()\n";
     std::cout << "  - Avoid double shift by reusing new_dist\n";
     std::cout << "  - Local bestLen cache to reduce memory reads\n";
     std::cout << "  - Prefetch next stack frame\n";
@@ -143,13 +144,16 @@ void runPerformanceBenchmark() {
     std::cout << std::string(76, '-') << "\n";
 
     BenchmarkLog logger("benchmarks", "sequential_v3");
+    EnergyMeter meter;
 
     for (int n : BENCH_SIZES) {
         GolombRuler result;
 
+        meter.start();
         auto start = std::chrono::high_resolution_clock::now();
         searchGolombSequentialV3(n, DEFAULT_MAX_LEN, result);
         auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = meter.stop();
 
         double time = std::chrono::duration<double>(end - start).count();
         long long states = getExploredCountSequentialV3();
@@ -183,7 +187,7 @@ void runPerformanceBenchmark() {
         }
         std::cout << " }\n\n";
 
-        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential V3 (SIMD SSE2)");
+        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, "Sequential V3 (SIMD " GOLOMB_SIMD_BACKEND ")", energy);
     }
 
     std::cout << "=============================================================\n";
@@ -255,7 +259,7 @@ int main(int argc, char** argv) {
     std::cout << "       OPTIMAL GOLOMB RULER - SEQUENTIAL V3 BENCHMARK\n";
     std::cout << "=============================================================\n";
     std::cout << "Mode: " << MODE_NAME << "\n";
-    std::cout << "Optimization: SIMD SSE2 + cache optimizations\n";
+    std::cout << "Optimization: SIMD " << GOLOMB_SIMD_BACKEND << " + cache optimizations\n";
 
     bool testsOk = runCorrectnessTests();
 
@@ -1,5 +1,6 @@
 #include "search_sequential_v4.hpp"
 #include "benchmark_log.hpp"
+#include "pattern_db.hpp"
 #include <iostream>
 #include <chrono>
 #include <vector>
@@ -14,6 +15,7 @@
 // - Mirror symmetry breaking at solution time
 // - Configurable initial bound for aggressive pruning
 // - All BitSet128 optimizations from V2/V3
+// - Optional pattern database bound (--pdb)
 // =============================================================================
 
 struct KnownOptimal {
@@ -111,7 +113,7 @@ bool runCorrectnessTests() {
     return allPassed;
 }
 
-void runPerformanceBenchmark(bool useOptimalBound) {
+void runPerformanceBenchmark(bool useOptimalBound, const PatternDB* patternDb) {
     std::cout << "\n";
     std::cout << "=============================================================\n";
     std::cout << "                  BENCHMARK DE PERFORMANCE\n";
@@ -125,6 +127,9 @@ void runPerformanceBenchmark(bool useOptimalBound) {
     } else {
         std::cout << "  - Using default bound (127)\n";
     }
+    if (patternDb) {
+        std::cout << "  - Pattern database bound (k=" << patternDb->bits() << ", R=" << patternDb->maxMarks() << ")\n";
+    }
     std::cout << "=============================================================\n\n";
 
     std::cout << std::setw(5) << "n"
@@ -136,6 +141,7 @@ void runPerformanceBenchmark(bool useOptimalBound) {
     std::cout << std::string(76, '-') << "\n";
 
     BenchmarkLog logger("benchmarks", "sequential_v4");
+    EnergyMeter meter;
 
     for (int n : BENCH_SIZES) {
         GolombRuler result;
@@ -143,9 +149,11 @@ void runPerformanceBenchmark(bool useOptimalBound) {
         int initialBound = useOptimalBound ? getOptimalLength(n) : DEFAULT_MAX_LEN;
         if (initialBound < 0) initialBound = DEFAULT_MAX_LEN;
 
+        meter.start();
         auto start = std::chrono::high_resolution_clock::now();
-        searchGolombSequentialV4WithBound(n, initialBound, result);
+        searchGolombSequentialV4WithBound(n, initialBound, result, patternDb);
         auto end = std::chrono::high_resolution_clock::now();
+        const EnergyReading energy = meter.stop();
 
         double time = std::chrono::duration<double>(end - start).count();
         long long states = getExploredCountSequentialV4();
@@ -173,15 +181,17 @@ void runPerformanceBenchmark(bool useOptimalBound) {
         }
         std::cout << " }\n\n";
 
-        std::string note = useOptimalBound ? "Sequential V4 (optimal bound)" : "Sequential V4 (default bound)";
-        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, note);
+        std::string note = useOptimalBound ? "Sequential V4 (optimal bound" : "Sequential V4 (default bound";
+        if (patternDb) note += ", pdb k=" + std::to_string(patternDb->bits());
+        note += ")";
+        logger.logOpenMP(n, 1, result.length, time, 1.0, 100.0, states, note, energy);
     }
 
     std::cout << "=============================================================\n";
     std::cout << "[Results saved to benchmarks/sequential_v4_benchmark.csv]\n";
 }
 
-void runSingleN(int n, bool useOptimalBound) {
+void runSingleN(int n, bool useOptimalBound, const PatternDB* patternDb) {
     std::cout << "=============================================================\n";
     std::cout << "       OPTIMAL GOLOMB RULER - SEQUENTIAL V4 (n=" << n << ")\n";
     std::cout << "=============================================================\n\n";
@@ -194,11 +204,14 @@ void runSingleN(int n, bool useOptimalBound) {
             std::cout << "Using known optimal (" << optLen << ") as initial bound\n\n";
         }
     }
+    if (patternDb) {
+        std::cout << "Pattern database: k=" << patternDb->bits() << ", R=" << patternDb->maxMarks() << "\n\n";
+    }
 
     GolombRuler result;
 
     auto start = std::chrono::high_resolution_clock::now();
-    searchGolombSequentialV4WithBound(n, initialBound, result);
+    searchGolombSequentialV4WithBound(n, initialBound, result, patternDb);
     auto end = std::chrono::high_resolution_clock::now();
 
     double time = std::chrono::duration<double>(end - start).count();
@@ -229,9 +242,12 @@ void runSingleN(int n, bool useOptimalBound) {
 }
 
 void printUsage(const char* progName) {
-    std::cout << "Usage: " << progName << " [n] [--fast]\n";
+    std::cout << "Usage: " << progName << " [n] [--fast] [--pdb[=K]]\n";
     std::cout << "  n      : Golomb ruler size (2-24)\n";
     std::cout << "  --fast : Use known optimal as initial bound (much faster)\n";
+    std::cout << "  --pdb  : Prune with the pattern database of the K smallest distances\n";
+    std::cout << "           (default " << PDB_DEFAULT_BITS << ", " << PatternDB::defaultPath(PDB_DEFAULT_BITS, PDB_DEFAULT_MARKS)
+              << ", built on first use)\n";
     std::cout << "\nExamples:\n";
     std::cout << "  " << progName << " 12        # Find optimal Golomb(12) from scratch\n";
     std::cout << "  " << progName << " 12 --fast # Verify Golomb(12) with optimal bound\n";
@@ -242,11 +258,16 @@ void printUsage(const char* progName) {
 int main(int argc, char** argv) {
     bool useOptimalBound = false;
     int n = -1;
+    int pdbBits = 0;
 
     // Parse arguments
     for (int i = 1; i < argc; ++i) {
         if (strcmp(argv[i], "--fast") == 0 || strcmp(argv[i], "-f") == 0) {
             useOptimalBound = true;
+        } else if (strcmp(argv[i], "--pdb") == 0) {
+            pdbBits = PDB_DEFAULT_BITS;
+        } else if (strncmp(argv[i], "--pdb=", 6) == 0) {
+            pdbBits = std::atoi(argv[i] + 6);
         } else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0) {
             printUsage(argv[0]);
             return 0;
@@ -255,12 +276,21 @@ int main(int argc, char** argv) {
         }
     }
 
+    PatternDB patternDb;
+    if (pdbBits > 0 && !patternDb.open(PatternDB::defaultPath(pdbBits, PDB_DEFAULT_MARKS),
+                                       pdbBits, PDB_DEFAULT_MARKS)) {
+        std::cerr << "ERROR: pattern database k=" << pdbBits << " unavailable (k in "
+                  << PDB_MIN_BITS << ".." << PDB_MAX_BITS << ")\n";
+        return 1;
+    }
+    const PatternDB* pdb = patternDb.valid() ? &patternDb : nullptr;
+
     if (n > 0) {
         if (n < 2 || n > 24) {
             std::cerr << "ERROR: n must be between 2 and 24\n";
             return 1;
         }
-        runSingleN(n, useOptimalBound);
+        runSingleN(n, useOptimalBound, pdb);
         return 0;
     }
 
@@ -277,7 +307,7 @@ int main(int argc, char** argv) {
         return 1;
     }
 
-    runPerformanceBenchmark(useOptimalBound);
+    runPerformanceBenchmark(useOptimalBound, pdb);
 
     return 0;
 }
@@ -0,0 +1,376 @@
+#include "search_wide.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// =============================================================================
+// GOLOMB WIDE - Long-ruler engine and (n, L) sweep of its check strategies
+// =============================================================================
+// Single run:
+//   golomb_wide <n> <maxLen> [--check=auto|shift|list] [--state=inplace|copy]
+//               [--switch=K] [--first] [--nodes=N] [--pilot=N] [--forbid=d1,d2,...]
+//
+// Sweep (--sweep): every (n, L) of --n / --len with the three strategies and
+// the same node budget, shift also with the copy-per-frame state (shift/cp).
+// All runs must explore the same nodes (checked); the table gives ns/node per
+// run (Auto without its pilots, shown apart), the model's k* and whether Auto
+// was the fastest (within 10%, best of --reps runs each). Rows appended to
+// benchmarks/wide_benchmark.csv.
+// =============================================================================
+
+namespace {
+
+std::vector<int> parseIntList(const char* list) {
+    std::vector<int> values;
+    std::istringstream iss(list);
+    std::string item;
+    while (std::getline(iss, item, ',')) {
+        if (!item.empty()) values.push_back(std::atoi(item.c_str()));
+    }
+    return values;
+}
+
+void printRuler(const GolombRuler& ruler) {
+    std::cout << "Ruler      : { ";
+    for (size_t i = 0; i < ruler.marks.size(); ++i) {
+        std::cout << ruler.marks[i];
+        if (i < ruler.marks.size() - 1) std::cout << ", ";
+    }
+    std::cout << " }\n";
+}
+
+void printModel(const WideCostModel& model) {
+    std::cout << "Cost model : W=" << model.words << " words, pilots of " << model.pilotNodes
+              << " nodes (" << std::fixed << std::setprecision(1) << 1e3 * model.calibrationTime
+              << " ms), ns per check by depth:\n";
+    std::cout << "             k     checks     list    shift\n";
+    for (size_t k = 1; k < model.checks.size(); ++k) {
+        if (model.checks[k] == 0) continue;
+        std::cout << "             " << std::setw(2) << k << std::setw(11) << model.checks[k]
+                  << std::setprecision(2)
+                  << std::setw(9) << model.listNs[k] << std::setw(9) << model.shiftNs[k]
+                  << (static_cast<int>(k) == model.switchMarks ? "   <- k*" : "") << "\n";
+    }
+}
+
+int runSingle(int n, int maxLen, const WideOptions& options) {
+    std::cout << "=============================================================\n";
+    std::cout << "     GOLOMB WIDE (n=" << n << ", L<=" << maxLen << ", check="
+              << wideCheckName(options.check) << ")\n";
+    std::cout << "=============================================================\n\n";
+
+    GolombRuler result;
+    WideStats stats;
+    const auto start = std::chrono::high_resolution_clock::now();
+    const bool found = searchGolombWide(n, maxLen, options, result, stats);
+    const auto end = std::chrono::high_resolution_clock::now();
+    const double time = std::chrono::duration<double>(end - start).count();
+
+    if (stats.model.pilotNodes > 0) printModel(stats.model);
+    std::cout << "Switch     : ";
+    if (stats.switchMarks > MAX_MARKS_WIDE) {
+        std::cout << "list only\n";
+    } else if (stats.switchMarks <= 1) {
+        std::cout << "shift only (" << wideStateName(options.state) << ")\n";
+    } else {
+        std::cout << "list below " << stats.switchMarks << " marks, shift from there ("
+                  << wideStateName(options.state) << ")\n";
+    }
+    const double searchTime = time - stats.model.calibrationTime;
+    std::cout << "Length     : " << (found ? result.length : -1)
+              << (found && stats.complete && !options.firstSolution ? " (optimal)" : "")
+              << (!found && stats.complete ? " (no ruler within bound)" : "")
+              << (stats.limitReached ? " (node limit)" : "") << "\n";
+    std::cout << "Time       : " << std::fixed << std::setprecision(3) << searchTime << " s";
+    if (stats.model.calibrationTime > 0.0) {
+        std::cout << " (+ " << stats.model.calibrationTime << " s pilots)";
+    }
+    std::cout << "\n";
+    std::cout << "States     : " << stats.nodes << "\n";
+    std::cout << "Checks     : list " << stats.listChecks << ", shift " << stats.shiftChecks << "\n";
+    std::cout << "States/sec : " << std::scientific << std::setprecision(2)
+              << (searchTime > 0.0 ? stats.nodes / searchTime : 0.0) << "\n";
+
+    if (!found) {
+        std::cout << (stats.complete ? "No ruler within bound\n" : "No ruler found\n");
+        return 0;
+    }
+    const bool valid = isValidWideRuler(result.marks, options.forbidden);
+    std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
+    printRuler(result);
+    return valid ? 0 : 1;
+}
+
+struct SweepRow {
+    int n;
+    int maxLen;
+    int words;
+    int switchMarks;
+    WideCheck check;
+    WideState state;
+    long long nodes;
+    double time;
+    double pilotTime;
+    int length;
+};
+
+bool appendSweepCsv(const std::string& path, const std::vector<SweepRow>& rows) {
+    std::filesystem::path p(path);
+    if (p.has_parent_path()) std::filesystem::create_directories(p.parent_path());
+    const bool exists = std::filesystem::exists(p);
+    std::ofstream file(path, std::ios::app);
+    if (!file) return false;
+    if (!exists) {
+        file << "timestamp,n,max_len,words,switch_marks,strategy,state,nodes,time_s,pilot_s,ns_per_node,length\n";
+    }
+
+    const std::time_t now = std::time(nullptr);
+    const std::tm tm = *std::localtime(&now);
+    for (const SweepRow& row : rows) {
+        file << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << "," << row.n << "," << row.maxLen << ","
+             << row.words << "," << row.switchMarks << "," << wideCheckName(row.check) << ","
+             << wideStateName(row.state) << ","
+             << row.nodes << "," << std::fixed << std::setprecision(6) << row.time << ","
+             << row.pilotTime << ","
+             << std::setprecision(2) << (row.nodes > 0 ? 1e9 * row.time / row.nodes : 0.0) << ","
+             << row.length << "\n";
+    }
+    return static_cast<bool>(file);
+}
+
+constexpr long long MIN_SWEEP_NODES = 1000;
+
+int runSweep(const std::vector<int>& sizes, const std::vector<int>& lengths, long long nodeLimit,
+             long long pilotNodes, int reps, const std::string& csvPath) {
+    std::cout << "=============================================================\n";
+    std::cout << "   GOLOMB WIDE SWEEP - shift vs mark-list checks over (n, L)\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Node budget: " << nodeLimit << " per run (best ruler within L), auto pilots: "
+              << pilotNodes << " nodes x 2, best of " << reps << "\n\n";
+
+    std::cout << std::setw(4) << "n" << std::setw(7) << "L" << std::setw(4) << "W"
+              << std::setw(5) << "k*" << std::setw(12) << "Nodes"
+              << std::setw(10) << "list" << std::setw(10) << "shift/cp" << std::setw(10) << "shift"
+              << std::setw(10) << "auto"
+              << std::setw(8) << "Pilots" << std::setw(7) << "Best" << std::setw(6) << "Len" << "\n";
+    std::cout << std::setw(45) << "" << "(ns per node)" << std::setw(18) << "(ms)" << "\n";
+    std::cout << std::string(94, '-') << "\n";
+
+    // Runs per cell: list, shift (copy-per-frame, as V5), shift and auto (in place)
+    const WideCheck checks[4] = {WideCheck::List, WideCheck::Shift, WideCheck::Shift, WideCheck::Auto};
+    const WideState states[4] = {WideState::InPlace, WideState::Copy, WideState::InPlace,
+                                 WideState::InPlace};
+    std::vector<SweepRow> rows;
+    bool consistent = true;
+    int autoBest = 0;
+    int cells = 0;
+
+    for (int maxLen : lengths) {
+        for (int n : sizes) {
+            double ns[4] = {0.0, 0.0, 0.0, 0.0};
+            long long nodes[4] = {0, 0, 0, 0};
+            int length = -1;
+            int switchMarks = 0;
+            double pilotTime = 0.0;
+
+            for (int c = 0; c < 4; ++c) {
+                WideOptions options;
+                options.check = checks[c];
+                options.state = states[c];
+                options.nodeLimit = nodeLimit;
+                options.pilotNodes = pilotNodes;
+
+                // Best of `reps` (Auto: pilots redone each time, k* of the best run)
+                GolombRuler result;
+                WideStats stats;
+                bool found = false;
+                double time = 0.0;
+                for (int rep = 0; rep < reps; ++rep) {
+                    WideStats repStats;
+                    const auto start = std::chrono::high_resolution_clock::now();
+                    found = searchGolombWide(n, maxLen, options, result, repStats);
+                    const auto end = std::chrono::high_resolution_clock::now();
+                    const double repTime = std::chrono::duration<double>(end - start).count() -
+                                           repStats.model.calibrationTime;
+                    if (rep == 0 || repTime < time) {
+                        time = repTime;
+                        stats = repStats;
+                    }
+                }
+
+                if (found && !isValidWideRuler(result.marks, {})) {
+                    std::cerr << "ERROR: invalid ruler (n=" << n << ", L=" << maxLen << ", "
+                              << wideCheckName(checks[c]) << ")\n";
+                    consistent = false;
+                }
+                nodes[c] = stats.nodes;
+                ns[c] = stats.nodes > 0 ? 1e9 * time / stats.nodes : 0.0;
+                if (c == 0) length = found ? result.length : -1;
+                else if ((found ? result.length : -1) != length) consistent = false;
+
+                if (checks[c] == WideCheck::Auto) {
+                    switchMarks = stats.switchMarks;
+                    pilotTime = stats.model.calibrationTime;
+                }
+                rows.push_back({n, maxLen, wideWords(maxLen), stats.switchMarks, checks[c], states[c],
+                                stats.nodes, time, stats.model.calibrationTime,
+                                found ? result.length : -1});
+            }
+            for (int c = 1; c < 4; ++c) {
+                if (nodes[c] != nodes[0]) consistent = false;
+            }
+
+            // Cells pruned at the root (n too large for L) time nothing
+            const bool trivial = nodes[0] < MIN_SWEEP_NODES;
+            const int best = (ns[0] <= ns[2]) ? 0 : 2;
+            const bool autoOk = ns[3] <= 1.10 * ns[best];
+            if (!trivial) {
+                autoBest += autoOk ? 1 : 0;
+                ++cells;
+            }
+
+            std::cout << std::setw(4) << n << std::setw(7) << maxLen << std::setw(4) << wideWords(maxLen)
+                      << std::setw(5) << (switchMarks > MAX_MARKS_WIDE ? std::string("-")
+                                                                       : std::to_string(switchMarks))
+                      << std::setw(12) << nodes[0] << std::fixed << std::setprecision(1)
+                      << std::setw(10) << ns[0] << std::setw(10) << ns[1] << std::setw(10) << ns[2]
+                      << std::setw(10) << ns[3]
+                      << std::setw(8) << 1e3 * pilotTime << std::setw(7) << wideCheckName(checks[best])
+                      << std::setw(6) << length
+                      << (trivial ? "  (trivial)" : (autoOk ? "" : "  (auto slower)")) << "\n";
+        }
+    }
+
+    std::cout << std::string(94, '-') << "\n";
+    std::cout << "Auto within 10% of the best fixed strategy: " << autoBest << "/" << cells << "\n";
+    std::cout << "Node counts / lengths identical across strategies: "
+              << (consistent ? "YES" : "NO") << "\n";
+
+    if (!csvPath.empty()) {
+        if (appendSweepCsv(csvPath, rows)) {
+            std::cout << "[Results saved to " << csvPath << "]\n";
+        } else {
+            std::cerr << "Error: cannot write " << csvPath << "\n";
+        }
+    }
+    return consistent ? 0 : 1;
+}
+
+void printUsage(const char* progName) {
+    std::cout << "Usage: " << progName << " <n> <maxLen> [options]\n"
+              << "       " << progName << " --sweep [--n=LIST] [--len=LIST] [--nodes=N]\n"
+              << "  --check=MODE   auto (cost model, default), shift, list\n"
+              << "  --state=MODE   shift levels: inplace (make / unmake, default), copy (frame per level)\n"
+              << "  --switch=K     auto: switch to shift checks at K marks (skip calibration)\n"
+              << "  --pilot=N      auto: nodes per pilot run of the cost model (default 20000)\n"
+              << "  --first        stop at the first ruler of length <= maxLen\n"
+              << "  --nodes=N      stop after N nodes (sweep default 1000000)\n"
+              << "  --forbid=LIST  distances no pair of marks may have (e.g. 5,17,40)\n"
+              << "  --n=LIST       sweep sizes (default 12,16,20,24)\n"
+              << "  --len=LIST     sweep lengths (default 127,255,511,1023,2047)\n"
+              << "  --reps=R       sweep: best of R runs per strategy (default 3)\n"
+              << "  --csv=FILE     sweep CSV (default benchmarks/wide_benchmark.csv)\n"
+              << "  --no-csv       sweep: print only\n"
+              << "\nExamples:\n"
+              << "  " << progName << " 30 1200 --first     # some 30-mark ruler within 1200\n"
+              << "  " << progName << " 11 127              # optimal Golomb(11), list / shift switch\n"
+              << "  " << progName << " --sweep --n=16,24 --len=255,1023\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    WideOptions options;
+    bool sweep = false;
+    std::vector<int> sizes = {12, 16, 20, 24};
+    std::vector<int> lengths = {127, 255, 511, 1023, 2047};
+    long long sweepNodes = 1000000;
+    int reps = 3;
+    std::string csvPath = "benchmarks/wide_benchmark.csv";
+    std::vector<int> positional;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        } else if (std::strcmp(arg, "--sweep") == 0) {
+            sweep = true;
+        } else if (std::strncmp(arg, "--check=", 8) == 0) {
+            if (!parseWideCheck(arg + 8, options.check)) {
+                std::cerr << "ERROR: unknown check mode " << (arg + 8) << "\n";
+                return 1;
+            }
+        } else if (std::strncmp(arg, "--state=", 8) == 0) {
+            if (!parseWideState(arg + 8, options.state)) {
+                std::cerr << "ERROR: unknown state mode " << (arg + 8) << "\n";
+                return 1;
+            }
+        } else if (std::strncmp(arg, "--switch=", 9) == 0) {
+            options.switchMarks = std::atoi(arg + 9);
+        } else if (std::strncmp(arg, "--pilot=", 8) == 0) {
+            options.pilotNodes = std::atoll(arg + 8);
+        } else if (std::strcmp(arg, "--first") == 0) {
+            options.firstSolution = true;
+        } else if (std::strncmp(arg, "--nodes=", 8) == 0) {
+            options.nodeLimit = std::atoll(arg + 8);
+            sweepNodes = options.nodeLimit;
+        } else if (std::strncmp(arg, "--forbid=", 9) == 0) {
+            options.forbidden = parseIntList(arg + 9);
+        } else if (std::strncmp(arg, "--reps=", 7) == 0) {
+            reps = std::max(1, std::atoi(arg + 7));
+        } else if (std::strncmp(arg, "--n=", 4) == 0) {
+            sizes = parseIntList(arg + 4);
+        } else if (std::strncmp(arg, "--len=", 6) == 0) {
+            lengths = parseIntList(arg + 6);
+        } else if (std::strncmp(arg, "--csv=", 6) == 0) {
+            csvPath = arg + 6;
+        } else if (std::strcmp(arg, "--no-csv") == 0) {
+            csvPath.clear();
+        } else if (arg[0] != '-') {
+            positional.push_back(std::atoi(arg));
+        } else {
+            std::cerr << "ERROR: unknown option " << arg << "\n";
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (sweep) {
+        for (int n : sizes) {
+            if (n < 3 || n > MAX_MARKS_WIDE) {
+                std::cerr << "ERROR: n must be between 3 and " << MAX_MARKS_WIDE << "\n";
+                return 1;
+            }
+        }
+        for (int len : lengths) {
+            if (len < 1 || len > MAX_LEN_WIDE) {
+                std::cerr << "ERROR: lengths must be between 1 and " << MAX_LEN_WIDE << "\n";
+                return 1;
+            }
+        }
+        return runSweep(sizes, lengths, sweepNodes, options.pilotNodes, reps, csvPath);
+    }
+
+    if (positional.size() != 2) {
+        printUsage(argv[0]);
+        return 1;
+    }
+    const int n = positional[0];
+    const int maxLen = positional[1];
+    if (n < 2 || n > MAX_MARKS_WIDE || maxLen < 1 || maxLen > MAX_LEN_WIDE) {
+        std::cerr << "ERROR: n must be between 2 and " << MAX_MARKS_WIDE
+                  << ", maxLen between 1 and " << MAX_LEN_WIDE << "\n";
+        return 1;
+    }
+    return runSingle(n, maxLen, options);
+}
@@ -1,4 +1,5 @@
 #include "search_mpi_v2.hpp"
+#include "simd_bitset.hpp"
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
@@ -11,7 +12,7 @@
 // OPTIMIZED GOLOMB RULER SEARCH - MPI V2 (HYPERCUBE + BITSET128)
 // =============================================================================
 // Key improvements over MPI V1:
-//   - BitSet128 (2x uint64_t) instead of 4-word array
+//   - BitSet128 (simd_bitset.hpp: SSE / NEON) instead of 4-word array
 //   - reversed_marks encoding: shift computes all differences in O(1)
 //   - Prefix-based work distribution for better load balancing
 //   - Keeps hypercube topology for O(log P) bound synchronization
@@ -27,58 +28,10 @@ constexpr int MAX_MARKS_V2 = 24;
 constexpr int MAX_LEN_V2 = 127;  // Max supported with 2x uint64_t
 
 // =============================================================================
-// FAST 128-BIT BITSET using 2x uint64_t
+// 128-BIT BITSET - portable SIMD layer (simd_bitset.hpp): SSE on x86, NEON
+// on ARM, two uint64_t with -DGOLOMB_SIMD_SCALAR
 // =============================================================================
-struct alignas(16) BitSet128 {
-    uint64_t lo;  // bits 0-63
-    uint64_t hi;  // bits 64-127
-
-    BitSet128() : lo(0), hi(0) {}
-    BitSet128(uint64_t l, uint64_t h) : lo(l), hi(h) {}
-
-    inline void set(int pos) {
-        if (pos < 64) {
-            lo |= (1ULL << pos);
-        } else {
-            hi |= (1ULL << (pos - 64));
-        }
-    }
-
-    inline bool test(int pos) const {
-        if (pos < 64) {
-            return (lo >> pos) & 1;
-        } else {
-            return (hi >> (pos - 64)) & 1;
-        }
-    }
-
-    inline BitSet128 operator<<(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128(0, 0);
-        if (n >= 64) {
-            return BitSet128(0, lo << (n - 64));
-        }
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128(new_lo, new_hi);
-    }
-
-    inline BitSet128 operator&(const BitSet128& other) const {
-        return BitSet128(lo & other.lo, hi & other.hi);
-    }
-
-    inline BitSet128 operator^(const BitSet128& other) const {
-        return BitSet128(lo ^ other.lo, hi ^ other.hi);
-    }
-
-    inline bool any() const {
-        return (lo | hi) != 0;
-    }
-
-    inline void reset() {
-        lo = hi = 0;
-    }
-};
+using BitSet128 = SimdBitSet128;
 
 // =============================================================================
 // WORK ITEM - A prefix to explore
@@ -257,8 +210,7 @@ static void backtrackIterativeMPI_V2(
                 newFrame.reversed_marks = frame.reversed_marks << offset;
                 newFrame.reversed_marks.set(0);
 
-                newFrame.used_dist.lo = frame.used_dist.lo ^ new_dist.lo;
-                newFrame.used_dist.hi = frame.used_dist.hi ^ new_dist.hi;
+                newFrame.used_dist = frame.used_dist ^ new_dist;
 
                 newFrame.marks_count = newMarksCount;
                 newFrame.ruler_length = pos;
@@ -1,4 +1,6 @@
 #include "search_mpi_v3.hpp"
+#include "prefix_split.hpp"
+#include "simd_bitset.hpp"
 #include <algorithm>
 #include <atomic>
 #include <cstdint>
@@ -11,74 +13,40 @@
 // OPTIMIZED GOLOMB RULER SEARCH - MPI V3 (NO HYPERCUBE)
 // =============================================================================
 // Key features:
-//   - BitSet128 (2x uint64_t) for O(1) collision detection via shift
+//   - BitSet128 (simd_bitset.hpp: SSE / NEON) for O(1) collision detection via shift
 //   - Prefix-based work distribution for load balancing
 //   - Standard MPI_Allreduce for bound synchronization
 //   - Works with ANY number of MPI processes (no power-of-2 requirement)
 // =============================================================================
 
 static std::atomic<long long> exploredCountMPI_V3{0};
+static long long deterministicCountMPI_V3 = 0;
+
+// Per-prefix cost trace (global prefix order, complete on rank 0 after the search)
+static std::vector<PrefixCost> prefixTraceMPI_V3;
+
+// Bound policy stats of the last search, summed on rank 0
+static BoundPolicyStats boundPolicyStatsMPI_V3;
+
+// Solutions that lowered the rank bound (complete on rank 0 after the search)
+static std::vector<BoundEventMPI_V3> boundTimelineMPI_V3;
+static double boundStartMPI_V3 = 0.0;
 
 // Sync frequency: synchronize global best every N prefixes
 constexpr int SYNC_INTERVAL_V3 = 64;
 
+// Adaptive prefix splitting: target tasks per worker and probes per estimate
+constexpr int ADAPTIVE_TASKS_PER_WORKER_V3 = 64;
+constexpr int ADAPTIVE_PROBES_V3 = 16;
+
 // Maximum marks we support
 constexpr int MAX_MARKS_V3 = 24;
-constexpr int MAX_LEN_V3 = 127;  // Max supported with 2x uint64_t
 
 // =============================================================================
-// FAST 128-BIT BITSET using 2x uint64_t
+// 128-BIT BITSET - portable SIMD layer (simd_bitset.hpp): SSE on x86, NEON
+// on ARM, two uint64_t with -DGOLOMB_SIMD_SCALAR
 // =============================================================================
-struct alignas(16) BitSet128_V3 {
-    uint64_t lo;  // bits 0-63
-    uint64_t hi;  // bits 64-127
-
-    BitSet128_V3() : lo(0), hi(0) {}
-    BitSet128_V3(uint64_t l, uint64_t h) : lo(l), hi(h) {}
-
-    inline void set(int pos) {
-        if (pos < 64) {
-            lo |= (1ULL << pos);
-        } else {
-            hi |= (1ULL << (pos - 64));
-        }
-    }
-
-    inline bool test(int pos) const {
-        if (pos < 64) {
-            return (lo >> pos) & 1;
-        } else {
-            return (hi >> (pos - 64)) & 1;
-        }
-    }
-
-    inline BitSet128_V3 operator<<(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128_V3(0, 0);
-        if (n >= 64) {
-            return BitSet128_V3(0, lo << (n - 64));
-        }
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128_V3(new_lo, new_hi);
-    }
-
-    inline BitSet128_V3 operator&(const BitSet128_V3& other) const {
-        return BitSet128_V3(lo & other.lo, hi & other.hi);
-    }
-
-    inline BitSet128_V3 operator^(const BitSet128_V3& other) const {
-        return BitSet128_V3(lo ^ other.lo, hi ^ other.hi);
-    }
-
-    inline bool any() const {
-        return (lo | hi) != 0;
-    }
-
-    inline void reset() {
-        lo = hi = 0;
-    }
-};
+using BitSet128_V3 = SimdBitSet128;
 
 // =============================================================================
 // WORK ITEM - A prefix to explore
@@ -99,6 +67,7 @@ struct alignas(32) StackFrameMPI_V3 {
     int marks_count;
     int ruler_length;
     int next_candidate;
+    int threshold;       // Deterministic kernel only: visit threshold
 };
 
 // =============================================================================
@@ -108,8 +77,22 @@ struct alignas(64) ThreadBestMPI_V3 {
     int bestLen;
     int bestMarks[MAX_MARKS_V3];
     int bestNumMarks;
+    uint64_t bestKey;    // Deterministic kernel only: (length << 32) | global prefix index
 };
 
+// =============================================================================
+// BOUND TIMELINE - Every solution that lowered the rank bound (rare, so a
+// critical section is fine); rank filled in by the final gather
+// =============================================================================
+static void recordBoundMPI_V3(int length)
+{
+    const double t = MPI_Wtime() - boundStartMPI_V3;
+    #pragma omp critical(bound_timeline_mpi_v3)
+    {
+        boundTimelineMPI_V3.push_back(BoundEventMPI_V3{t, length, 0});
+    }
+}
+
 // =============================================================================
 // EXTRACT MARKS FROM reversed_marks
 // =============================================================================
@@ -179,10 +162,12 @@ static void generatePrefixesMPI_V3(
 // =============================================================================
 // CORE ITERATIVE BACKTRACKING - V3
 // =============================================================================
+template <typename BoundReader>
 static void backtrackIterativeMPI_V3(
     ThreadBestMPI_V3& threadBest,
     const int n,
-    std::atomic<int>& globalBestLen,
+    SharedBound& globalBound,
+    BoundReader& bound,
     long long& localExplored,
     StackFrameMPI_V3* stack)
 {
@@ -193,7 +178,7 @@ static void backtrackIterativeMPI_V3(
 
         StackFrameMPI_V3& frame = stack[stackTop];
 
-        const int currentGlobalBest = globalBestLen.load(std::memory_order_relaxed);
+        const int currentGlobalBest = bound.node();
 
         // Pruning: Golomb lower bound
         const int r = n - frame.marks_count;
@@ -216,7 +201,7 @@ static void backtrackIterativeMPI_V3(
         bool pushedChild = false;
 
         for (int pos = startNext; pos <= max_pos; ++pos) {
-            const int newGlobalBest = globalBestLen.load(std::memory_order_relaxed);
+            const int newGlobalBest = bound.candidate();
             if (pos >= newGlobalBest) [[unlikely]] {
                 break;
             }
@@ -243,9 +228,140 @@ static void backtrackIterativeMPI_V3(
 
                     extractMarksMPI_V3(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
 
-                    int expected = globalBestLen.load(std::memory_order_relaxed);
-                    while (solutionLen < expected &&
-                           !globalBestLen.compare_exchange_weak(expected, solutionLen,
+                    bound.improved(solutionLen);
+                    if (globalBound.lower(solutionLen)) {
+                        recordBoundMPI_V3(solutionLen);
+                    }
+                }
+            } else {
+                frame.next_candidate = pos + 1;
+
+                StackFrameMPI_V3& newFrame = stack[stackTop + 1];
+
+                newFrame.reversed_marks = frame.reversed_marks << offset;
+                newFrame.reversed_marks.set(0);
+
+                newFrame.used_dist = frame.used_dist ^ new_dist;
+
+                newFrame.marks_count = newMarksCount;
+                newFrame.ruler_length = pos;
+                newFrame.next_candidate = 0;
+
+                stackTop++;
+                pushedChild = true;
+                break;
+            }
+        }
+
+        if (!pushedChild) {
+            stackTop--;
+        }
+    }
+}
+
+// =============================================================================
+// DETERMINISTIC BACKTRACKING - Same result and node count at any P x threads
+// =============================================================================
+// Same scheme as OpenMP V5: the bound is a key (length << 32 | global prefix
+// index), earlier prefixes may still match the best length, and nodes are
+// counted per visit threshold. The rounds reduce the key with MPI_MIN, so
+// every rank converges on the same lexicographically smallest ruler.
+// =============================================================================
+constexpr int THRESHOLD_SLOTS_V3 = MAX_LEN_MPI_V3 + 2;
+
+static inline uint64_t boundKeyMPI_V3(int length, uint32_t prefix) {
+    return (static_cast<uint64_t>(length) << 32) | prefix;
+}
+
+static inline int effectiveBoundMPI_V3(uint64_t key, uint32_t prefix) {
+    const int length = static_cast<int>(key >> 32);
+    return (prefix < static_cast<uint32_t>(key)) ? length + 1 : length;
+}
+
+static int prefixThresholdMPI_V3(const BitSet128_V3& reversed_marks, int ruler_length, int n) {
+    int marks[MAX_MARKS_V3];
+    int numMarks = 0;
+    extractMarksMPI_V3(reversed_marks, ruler_length, marks, numMarks);
+
+    int threshold = 0;
+    for (int k = 1; k < numMarks; ++k) {
+        const int r = n - k;
+        threshold = std::max(threshold, marks[k - 1] + (r * (r + 1)) / 2 + 1);
+        threshold = std::max(threshold, marks[k] + ((r - 1) * r) / 2 + 1);
+    }
+    return threshold;
+}
+
+static void backtrackDeterministicMPI_V3(
+    ThreadBestMPI_V3& threadBest,
+    const int n,
+    std::atomic<uint64_t>& globalBestKey,
+    const uint32_t prefixIndex,
+    long long& localExplored,
+    long long* thresholdCounts,
+    StackFrameMPI_V3* stack)
+{
+    int stackTop = 0;
+
+    while (stackTop >= 0) {
+        localExplored++;
+
+        StackFrameMPI_V3& frame = stack[stackTop];
+        if (frame.next_candidate == 0) {
+            thresholdCounts[frame.threshold]++;
+        }
+
+        const int bound = effectiveBoundMPI_V3(globalBestKey.load(std::memory_order_relaxed), prefixIndex);
+
+        const int r = n - frame.marks_count;
+        const int minAdditionalLength = (r * (r + 1)) / 2;
+
+        if (frame.ruler_length + minAdditionalLength >= bound) [[unlikely]] {
+            stackTop--;
+            continue;
+        }
+
+        const int min_pos = frame.ruler_length + 1;
+        const int max_remaining = ((r - 1) * r) / 2;
+        const int max_pos = bound - max_remaining - 1;
+        const int childThreshold = std::max(frame.threshold, frame.ruler_length + minAdditionalLength + 1);
+
+        int startNext = frame.next_candidate;
+        if (startNext == 0) {
+            startNext = min_pos;
+        }
+
+        bool pushedChild = false;
+
+        for (int pos = startNext; pos <= max_pos; ++pos) {
+            const int newBound = effectiveBoundMPI_V3(globalBestKey.load(std::memory_order_relaxed), prefixIndex);
+            if (pos >= newBound) [[unlikely]] {
+                break;
+            }
+
+            const int offset = pos - frame.ruler_length;
+            BitSet128_V3 new_dist = frame.reversed_marks << offset;
+
+            if ((new_dist & frame.used_dist).any()) [[likely]] {
+                continue;
+            }
+
+            const int newMarksCount = frame.marks_count + 1;
+
+            if (newMarksCount == n) {
+                const uint64_t key = boundKeyMPI_V3(pos, prefixIndex);
+                if (key < threadBest.bestKey) {
+                    threadBest.bestKey = key;
+                    threadBest.bestLen = pos;
+
+                    BitSet128_V3 final_marks = frame.reversed_marks << offset;
+                    final_marks.set(0);
+
+                    extractMarksMPI_V3(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
+
+                    uint64_t expected = globalBestKey.load(std::memory_order_relaxed);
+                    while (key < expected &&
+                           !globalBestKey.compare_exchange_weak(expected, key,
                                std::memory_order_release, std::memory_order_relaxed)) {
                     }
                 }
@@ -257,12 +373,12 @@ static void backtrackIterativeMPI_V3(
                 newFrame.reversed_marks = frame.reversed_marks << offset;
                 newFrame.reversed_marks.set(0);
 
-                newFrame.used_dist.lo = frame.used_dist.lo ^ new_dist.lo;
-                newFrame.used_dist.hi = frame.used_dist.hi ^ new_dist.hi;
+                newFrame.used_dist = frame.used_dist ^ new_dist;
 
                 newFrame.marks_count = newMarksCount;
                 newFrame.ruler_length = pos;
                 newFrame.next_candidate = 0;
+                newFrame.threshold = std::max(childThreshold, pos + max_remaining + 1);
 
                 stackTop++;
                 pushedChild = true;
@@ -300,16 +416,36 @@ static int computePrefixDepthMPI_V3(int n, int numProcesses, int threadsPerProce
     return depth;
 }
 
+// Deterministic rounds: reduce the (length, prefix index) key instead of the length
+static void syncBestKeyMPI_V3(std::atomic<uint64_t>& globalBestKey)
+{
+    unsigned long long myKey = globalBestKey.load(std::memory_order_acquire);
+    unsigned long long globalMin;
+    MPI_Allreduce(&myKey, &globalMin, 1, MPI_UNSIGNED_LONG_LONG, MPI_MIN, MPI_COMM_WORLD);
+
+    uint64_t expected = globalBestKey.load(std::memory_order_relaxed);
+    while (globalMin < expected &&
+           !globalBestKey.compare_exchange_weak(expected, globalMin,
+               std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
 // =============================================================================
 // MAIN SEARCH FUNCTION - MPI V3 (NO HYPERCUBE)
 // =============================================================================
-void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
+void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best, const SearchOptionsMPI_V3& options)
 {
-    if (maxLen > MAX_LEN_V3) {
-        maxLen = MAX_LEN_V3;
+    const bool deterministic = options.deterministic;
+    const bool adaptiveSplit = options.adaptiveSplit && !deterministic;
+
+    if (maxLen > MAX_LEN_MPI_V3) {
+        maxLen = MAX_LEN_MPI_V3;
     }
 
     exploredCountMPI_V3.store(0, std::memory_order_relaxed);
+    deterministicCountMPI_V3 = 0;
+    boundTimelineMPI_V3.clear();
+    boundStartMPI_V3 = MPI_Wtime();
 
     int rank, size;
     MPI_Comm_rank(MPI_COMM_WORLD, &rank);
@@ -317,21 +453,35 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
 
     const int numThreads = omp_get_max_threads();
 
-    std::atomic<int> globalBestLen(maxLen + 1);
+    SharedBound globalBound(maxLen + 1, options.boundPolicy);
+    boundPolicyStatsMPI_V3 = BoundPolicyStats{};
+    BoundPolicyStats localBoundStats;
+
+    // Deterministic mode: a virtual ruler of length maxLen after every prefix
+    std::atomic<uint64_t> globalBestKey(boundKeyMPI_V3(maxLen, UINT32_MAX));
+    long long thresholdCounts[THRESHOLD_SLOTS_V3] = {0};
 
     int localBestLen = maxLen + 1;
     int localBestMarks[MAX_MARKS_V3] = {0};
     int localBestNumMarks = 0;
+    uint64_t localBestKey = UINT64_MAX;
 
     // ==========================================================================
     // PHASE 1: Generate all valid prefixes (done on all ranks identically)
     // ==========================================================================
-    int prefixDepth = computePrefixDepthMPI_V3(n, size, numThreads);
+    // Deterministic: the prefix set must not depend on the number of workers
+    int prefixDepth = deterministic ? computePrefixDepthMPI_V3(n, 1, 1)
+                                    : computePrefixDepthMPI_V3(n, size, numThreads);
 
     std::vector<WorkItemMPI_V3> allPrefixes;
     allPrefixes.reserve(100000);
 
-    {
+    if (adaptiveSplit) {
+        // Mixed-depth prefixes, identical on all ranks (node-seeded estimator)
+        generatePrefixesAdaptive<BitSet128_V3, WorkItemMPI_V3>(
+            n, maxLen + 1, size * numThreads, ADAPTIVE_TASKS_PER_WORKER_V3,
+            ADAPTIVE_PROBES_V3, allPrefixes);
+    } else {
         BitSet128_V3 reversed_marks;
         BitSet128_V3 used_dist;
         reversed_marks.set(0);
@@ -342,6 +492,9 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
 
     const int totalPrefixes = static_cast<int>(allPrefixes.size());
 
+    prefixTraceMPI_V3.assign(options.recordPrefixCosts ? static_cast<size_t>(totalPrefixes) : 0,
+                             PrefixCost{});
+
     // ==========================================================================
     // PHASE 2: Distribute prefixes among MPI ranks (static distribution)
     // ==========================================================================
@@ -367,25 +520,49 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
         int startIdx = prefixIndex;
         int endIdx = prefixIndex + prefixesThisRound;
 
-        #pragma omp parallel shared(globalBestLen, localBestLen, localBestMarks, localBestNumMarks)
+        #pragma omp parallel shared(globalBound, globalBestKey, thresholdCounts, localBoundStats, localBestLen, localBestMarks, localBestNumMarks, localBestKey)
         {
             ThreadBestMPI_V3 threadBest{};
             threadBest.bestLen = maxLen + 1;
             threadBest.bestNumMarks = 0;
+            threadBest.bestKey = UINT64_MAX;
             long long threadExplored = 0;
+            long long threadThresholds[THRESHOLD_SLOTS_V3] = {0};
 
             alignas(64) StackFrameMPI_V3 stack[MAX_MARKS_V3];
 
-            #pragma omp for schedule(dynamic, 1)
-            for (int idx = startIdx; idx < endIdx; ++idx) {
+            // Bound readers (one per policy, only the selected one is used)
+            AtomicBoundReader atomicBound(globalBound);
+            CachedBoundReader cachedBound(globalBound, options.boundRefresh);
+            EpochBoundReader epochBound(globalBound);
+            NumaBoundReader numaBound(globalBound);
+
+            auto explorePrefix = [&](int idx) {
                 const WorkItemMPI_V3& prefix = myPrefixes[static_cast<size_t>(idx)];
 
-                const int currentGlobal = globalBestLen.load(std::memory_order_acquire);
+                if (deterministic) {
+                    // Round-robin distribution: local idx -> global prefix index
+                    const uint32_t globalIndex = static_cast<uint32_t>(idx * size + rank);
+
+                    StackFrameMPI_V3& frame0 = stack[0];
+                    frame0.reversed_marks = prefix.reversed_marks;
+                    frame0.used_dist = prefix.used_dist;
+                    frame0.marks_count = prefix.marks_count;
+                    frame0.ruler_length = prefix.ruler_length;
+                    frame0.next_candidate = 0;
+                    frame0.threshold = prefixThresholdMPI_V3(prefix.reversed_marks, prefix.ruler_length, n);
+
+                    backtrackDeterministicMPI_V3(threadBest, n, globalBestKey, globalIndex,
+                                                 threadExplored, threadThresholds, stack);
+                    return;
+                }
+
+                const int currentGlobal = globalBound.load();
                 const int remaining = n - prefix.marks_count;
                 const int minAdditional = (remaining * (remaining + 1)) / 2;
 
                 if (prefix.ruler_length + minAdditional >= currentGlobal) {
-                    continue;
+                    return;
                 }
 
                 StackFrameMPI_V3& frame0 = stack[0];
@@ -395,15 +572,70 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
                 frame0.ruler_length = prefix.ruler_length;
                 frame0.next_candidate = 0;
 
-                backtrackIterativeMPI_V3(threadBest, n, globalBestLen, threadExplored, stack);
+                switch (options.boundPolicy) {
+                    case BoundPolicy::Atomic:
+                        backtrackIterativeMPI_V3(threadBest, n, globalBound, atomicBound, threadExplored, stack);
+                        break;
+                    case BoundPolicy::Cached:
+                        cachedBound.begin();
+                        backtrackIterativeMPI_V3(threadBest, n, globalBound, cachedBound, threadExplored, stack);
+                        break;
+                    case BoundPolicy::Epoch: {
+                        const long long nodesBefore = threadExplored;
+                        backtrackIterativeMPI_V3(threadBest, n, globalBound, epochBound, threadExplored, stack);
+                        epochBound.countChecks(threadExplored - nodesBefore);
+                        break;
+                    }
+                    case BoundPolicy::NumaReplica:
+                        backtrackIterativeMPI_V3(threadBest, n, globalBound, numaBound, threadExplored, stack);
+                        break;
+                }
+            };
+
+            #pragma omp for schedule(dynamic, 1)
+            for (int idx = startIdx; idx < endIdx; ++idx) {
+                if (!options.recordPrefixCosts) {
+                    explorePrefix(idx);
+                    continue;
+                }
+
+                const long long nodesBefore = threadExplored;
+                const double t0 = omp_get_wtime();
+                explorePrefix(idx);
+
+                // Round-robin distribution: local idx -> global prefix index
+                const WorkItemMPI_V3& prefix = myPrefixes[static_cast<size_t>(idx)];
+                PrefixCost& cost = prefixTraceMPI_V3[static_cast<size_t>(idx * size + rank)];
+                cost.depth = prefix.marks_count;
+                cost.ruler_length = prefix.ruler_length;
+                cost.nodes = threadExplored - nodesBefore;
+                cost.time = omp_get_wtime() - t0;
             }
 
             exploredCountMPI_V3.fetch_add(threadExplored, std::memory_order_relaxed);
 
+            #pragma omp critical(merge_bound_stats_mpi_v3)
+            {
+                localBoundStats.add(cachedBound.stats());
+                localBoundStats.add(epochBound.stats());
+            }
+
+            if (deterministic) {
+                #pragma omp critical(merge_thresholds_mpi_v3)
+                {
+                    for (int t = 0; t < THRESHOLD_SLOTS_V3; ++t) {
+                        thresholdCounts[t] += threadThresholds[t];
+                    }
+                }
+            }
+
             if (threadBest.bestNumMarks > 0) {
                 #pragma omp critical(merge_best_mpi_v3)
                 {
-                    if (threadBest.bestLen < localBestLen) {
+                    const bool better = deterministic ? (threadBest.bestKey < localBestKey)
+                                                      : (threadBest.bestLen < localBestLen);
+                    if (better) {
+                        localBestKey = threadBest.bestKey;
                         localBestLen = threadBest.bestLen;
                         localBestNumMarks = threadBest.bestNumMarks;
                         for (int i = 0; i < threadBest.bestNumMarks; ++i) {
@@ -423,14 +655,14 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
         // Simpler than hypercube, works with any number of processes
         // Slightly higher latency for large P, but optimized by MPI impl
         // =====================================================================
-        int myBest = globalBestLen.load(std::memory_order_acquire);
-        int globalMin;
-        MPI_Allreduce(&myBest, &globalMin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
-
-        int expected = globalBestLen.load(std::memory_order_relaxed);
-        while (globalMin < expected &&
-               !globalBestLen.compare_exchange_weak(expected, globalMin,
-                   std::memory_order_release, std::memory_order_relaxed)) {
+        if (deterministic) {
+            syncBestKeyMPI_V3(globalBestKey);
+        } else {
+            int myBest = globalBound.load();
+            int globalMin;
+            MPI_Allreduce(&myBest, &globalMin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+            globalBound.lower(globalMin);
         }
     }
 
@@ -440,14 +672,14 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
     int maxRounds = (maxPrefixes + SYNC_INTERVAL_V3 - 1) / SYNC_INTERVAL_V3;
 
     while (round < maxRounds) {
-        int myBest = globalBestLen.load(std::memory_order_acquire);
-        int globalMin;
-        MPI_Allreduce(&myBest, &globalMin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
-
-        int expected = globalBestLen.load(std::memory_order_relaxed);
-        while (globalMin < expected &&
-               !globalBestLen.compare_exchange_weak(expected, globalMin,
-                   std::memory_order_release, std::memory_order_relaxed)) {
+        if (deterministic) {
+            syncBestKeyMPI_V3(globalBestKey);
+        } else {
+            int myBest = globalBound.load();
+            int globalMin;
+            MPI_Allreduce(&myBest, &globalMin, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
+
+            globalBound.lower(globalMin);
         }
         round++;
     }
@@ -457,10 +689,99 @@ void searchGolombMPI_V3(int n, int maxLen, GolombRuler& best)
     // ==========================================================================
     MPI_Barrier(MPI_COMM_WORLD);
 
+    long long localBoundCounts[3] = {localBoundStats.checks, localBoundStats.refreshes,
+                                     localBoundStats.staleNodes};
+    long long boundCounts[3] = {0, 0, 0};
+    MPI_Reduce(localBoundCounts, boundCounts, 3, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+    boundPolicyStatsMPI_V3.checks = boundCounts[0];
+    boundPolicyStatsMPI_V3.refreshes = boundCounts[1];
+    boundPolicyStatsMPI_V3.staleNodes = boundCounts[2];
+
+    // Bound timeline: every rank's events to rank 0, merged by time, keeping
+    // the ones that lowered the bound of the whole run
+    int localEvents = static_cast<int>(boundTimelineMPI_V3.size());
+    std::vector<int> eventCounts(static_cast<size_t>(size), 0);
+    MPI_Gather(&localEvents, 1, MPI_INT, eventCounts.data(), 1, MPI_INT, 0, MPI_COMM_WORLD);
+    std::vector<int> eventOffsets(static_cast<size_t>(size), 0);
+    int totalEvents = 0;
+    for (int r = 0; r < size; ++r) {
+        eventOffsets[static_cast<size_t>(r)] = totalEvents;
+        totalEvents += eventCounts[static_cast<size_t>(r)];
+    }
+    std::vector<double> localTimes(static_cast<size_t>(localEvents));
+    std::vector<int> localLengths(static_cast<size_t>(localEvents));
+    for (int e = 0; e < localEvents; ++e) {
+        localTimes[static_cast<size_t>(e)] = boundTimelineMPI_V3[static_cast<size_t>(e)].time;
+        localLengths[static_cast<size_t>(e)] = boundTimelineMPI_V3[static_cast<size_t>(e)].length;
+    }
+    std::vector<double> allTimes(static_cast<size_t>(std::max(totalEvents, 1)));
+    std::vector<int> allLengths(static_cast<size_t>(std::max(totalEvents, 1)));
+    MPI_Gatherv(localTimes.data(), localEvents, MPI_DOUBLE, allTimes.data(), eventCounts.data(),
+                eventOffsets.data(), MPI_DOUBLE, 0, MPI_COMM_WORLD);
+    MPI_Gatherv(localLengths.data(), localEvents, MPI_INT, allLengths.data(), eventCounts.data(),
+                eventOffsets.data(), MPI_INT, 0, MPI_COMM_WORLD);
+    boundTimelineMPI_V3.clear();
+    if (rank == 0) {
+        std::vector<BoundEventMPI_V3> events;
+        for (int r = 0; r < size; ++r) {
+            for (int e = 0; e < eventCounts[static_cast<size_t>(r)]; ++e) {
+                const size_t at = static_cast<size_t>(eventOffsets[static_cast<size_t>(r)] + e);
+                events.push_back(BoundEventMPI_V3{allTimes[at], allLengths[at], r});
+            }
+        }
+        std::sort(events.begin(), events.end(),
+                  [](const BoundEventMPI_V3& a, const BoundEventMPI_V3& b) { return a.time < b.time; });
+        int current = maxLen + 1;
+        for (const BoundEventMPI_V3& event : events) {
+            if (event.length < current) {
+                boundTimelineMPI_V3.push_back(event);
+                current = event.length;
+            }
+        }
+    }
+
+    if (options.recordPrefixCosts) {
+        // Each prefix was run by exactly one rank: summing fills the trace on rank 0
+        std::vector<long long> nodes(static_cast<size_t>(totalPrefixes));
+        std::vector<double> times(static_cast<size_t>(totalPrefixes));
+        for (int i = 0; i < totalPrefixes; ++i) {
+            nodes[static_cast<size_t>(i)] = prefixTraceMPI_V3[static_cast<size_t>(i)].nodes;
+            times[static_cast<size_t>(i)] = prefixTraceMPI_V3[static_cast<size_t>(i)].time;
+        }
+        std::vector<long long> nodesSum(nodes.size());
+        std::vector<double> timesSum(times.size());
+        MPI_Reduce(nodes.data(), nodesSum.data(), totalPrefixes, MPI_LONG_LONG, MPI_SUM, 0, MPI_COMM_WORLD);
+        MPI_Reduce(times.data(), timesSum.data(), totalPrefixes, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+
+        for (int i = 0; i < totalPrefixes; ++i) {
+            PrefixCost& cost = prefixTraceMPI_V3[static_cast<size_t>(i)];
+            const WorkItemMPI_V3& prefix = allPrefixes[static_cast<size_t>(i)];
+            cost.index = i;
+            cost.depth = prefix.marks_count;
+            cost.ruler_length = prefix.ruler_length;
+            cost.nodes = nodesSum[static_cast<size_t>(i)];
+            cost.time = timesSum[static_cast<size_t>(i)];
+        }
+    }
+
     int globalMinLen;
     MPI_Allreduce(&localBestLen, &globalMinLen, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
 
     int hasWinner = (localBestLen == globalMinLen && localBestNumMarks > 0) ? rank : size;
+    if (deterministic) {
+        // Winner = owner of the smallest key (a prefix belongs to one rank)
+        unsigned long long myKey = localBestKey;
+        unsigned long long minKey;
+        MPI_Allreduce(&myKey, &minKey, 1, MPI_UNSIGNED_LONG_LONG, MPI_MIN, MPI_COMM_WORLD);
+        hasWinner = (localBestNumMarks > 0 && myKey == minKey) ? rank : size;
+
+        const int finalLen = std::min(globalMinLen, maxLen + 1);
+        long long localCount = 0;
+        for (int t = 0; t <= finalLen && t < THRESHOLD_SLOTS_V3; ++t) {
+            localCount += thresholdCounts[t];
+        }
+        MPI_Allreduce(&localCount, &deterministicCountMPI_V3, 1, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD);
+    }
     int globalWinner;
     MPI_Allreduce(&hasWinner, &globalWinner, 1, MPI_INT, MPI_MIN, MPI_COMM_WORLD);
 
@@ -498,3 +819,23 @@ long long getExploredCountMPI_V3()
 
     return globalCount;
 }
+
+long long getDeterministicCountMPI_V3()
+{
+    return deterministicCountMPI_V3;
+}
+
+const std::vector<PrefixCost>& getPrefixTraceMPI_V3()
+{
+    return prefixTraceMPI_V3;
+}
+
+const BoundPolicyStats& getBoundPolicyStatsMPI_V3()
+{
+    return boundPolicyStatsMPI_V3;
+}
+
+const std::vector<BoundEventMPI_V3>& getBoundTimelineMPI_V3()
+{
+    return boundTimelineMPI_V3;
+}
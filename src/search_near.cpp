@@ -0,0 +1,336 @@
+#include "search_near.hpp"
+#include "bound_policy.hpp"
+#include "simd_bitset.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include <omp.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define POPCOUNT64(x) __popcnt64(x)
+#else
+#define POPCOUNT64(x) __builtin_popcountll(x)
+#endif
+
+// =============================================================================
+// NEAR-GOLOMB SEARCH - One template instance per plane count P (1..4)
+// =============================================================================
+// Frames carry { reversed_marks, planes[P], excess } and are copied on push
+// as in V5. Symmetry: the mirror of a ruler has the same distances, so keep
+// a_1 <= a_{n-1} - a_{n-2} (ties are possible here, unlike Golomb rulers)
+// and a_1 < bound / 2.
+// =============================================================================
+
+namespace {
+
+using BitSet128 = SimdBitSet128;
+
+inline int popcount128(const BitSet128& x) {
+    return static_cast<int>(POPCOUNT64(x.lo()) + POPCOUNT64(x.hi()));
+}
+
+// Span still needed by r marks with e repeats left (see search_near.hpp)
+struct MinSpanTable {
+    int span[MAX_MARKS_NEAR + 1][MAX_MARKS_NEAR + 1];
+
+    MinSpanTable() {
+        for (int r = 0; r <= MAX_MARKS_NEAR; ++r) {
+            for (int e = 0; e <= MAX_MARKS_NEAR; ++e) {
+                const int u = std::max(r - e, 1);
+                span[r][e] = (r == 0) ? 0 : (u * (u + 1)) / 2 + (r - u);
+            }
+        }
+    }
+
+    // Any e >= r behaves like e = r
+    inline int operator()(int r, int e) const { return span[r][std::min(e, MAX_MARKS_NEAR)]; }
+};
+
+const MinSpanTable minSpan;
+
+template <int P>
+struct alignas(32) NearFrame {
+    BitSet128 reversed_marks;
+    BitSet128 planes[P];
+    int excess;
+    int marks_count;
+    int ruler_length;
+    int next_candidate;
+};
+
+struct alignas(64) ThreadBestNear {
+    int bestLen;
+    int bestMarks[MAX_MARKS_NEAR];
+    int bestNumMarks;
+};
+
+struct NearConfig {
+    int n;
+    int excess;     // k
+    bool capped;    // Plane P - 1 full means multiplicity maxRepeat reached
+};
+
+void extractMarksNear(const BitSet128& reversed_marks, int ruler_length, int* marks, int& numMarks) {
+    numMarks = 0;
+    for (int i = 0; i <= ruler_length; ++i) {
+        if (reversed_marks.test(ruler_length - i)) {
+            marks[numMarks++] = i;
+        }
+    }
+}
+
+// Candidate check: repeats it adds (-1 if rejected)
+template <int P>
+inline int repeatsNear(const NearFrame<P>& frame, const BitSet128& new_dist, const NearConfig& config) {
+    const BitSet128 seen = new_dist & frame.planes[0];
+    if (!seen.any()) [[likely]] return 0;
+    if (config.capped && (new_dist & frame.planes[P - 1]).any()) return -1;
+    const int repeats = popcount128(seen);
+    return (frame.excess + repeats <= config.excess) ? repeats : -1;
+}
+
+// Saturating increment of the multiplicities by new_dist (top plane first)
+template <int P>
+inline void addDistancesNear(const NearFrame<P>& frame, const BitSet128& new_dist,
+                             NearFrame<P>& child) {
+    for (int j = P - 1; j >= 1; --j) {
+        child.planes[j] = frame.planes[j] | (new_dist & frame.planes[j - 1]);
+    }
+    child.planes[0] = frame.planes[0] | new_dist;
+}
+
+// Ruler completed by a mark at pos: first gap a_1 <= last gap pos - ruler_length
+inline bool canonicalNear(const BitSet128& reversed_marks, int ruler_length, int pos) {
+    int firstMark = 0;
+    for (int i = 1; i <= ruler_length; ++i) {
+        if (reversed_marks.test(ruler_length - i)) {
+            firstMark = i;
+            break;
+        }
+    }
+    return firstMark <= pos - ruler_length;
+}
+
+template <int P>
+void generatePrefixesNear(const NearFrame<P>& frame, int targetDepth, int bound,
+                          const NearConfig& config, std::vector<NearFrame<P>>& prefixes) {
+    if (frame.marks_count == targetDepth) {
+        prefixes.push_back(frame);
+        return;
+    }
+
+    const int r = config.n - frame.marks_count;
+    const int left = config.excess - frame.excess;
+    if (frame.ruler_length + minSpan(r, left) >= bound) return;
+    const int max_pos = bound - minSpan(r - 1, left) - 1;
+
+    for (int pos = frame.ruler_length + 1; pos <= max_pos; ++pos) {
+        if (frame.marks_count == 1 && 2 * pos >= bound) break;
+
+        const BitSet128 new_dist = frame.reversed_marks << (pos - frame.ruler_length);
+        const int repeats = repeatsNear(frame, new_dist, config);
+        if (repeats < 0) continue;
+
+        NearFrame<P> child;
+        child.reversed_marks = new_dist;
+        child.reversed_marks.set(0);
+        addDistancesNear(frame, new_dist, child);
+        child.excess = frame.excess + repeats;
+        child.marks_count = frame.marks_count + 1;
+        child.ruler_length = pos;
+        child.next_candidate = 0;
+        generatePrefixesNear(child, targetDepth, bound, config, prefixes);
+    }
+}
+
+template <int P>
+void backtrackNear(ThreadBestNear& threadBest, const NearConfig& config, SharedBound& globalBound,
+                   long long& localExplored, NearFrame<P>* stack) {
+    const int n = config.n;
+    int stackTop = 0;
+
+    while (stackTop >= 0) {
+        localExplored++;
+
+        NearFrame<P>& frame = stack[stackTop];
+        const int currentGlobalBest = globalBound.value().load(std::memory_order_relaxed);
+
+        const int r = n - frame.marks_count;
+        const int left = config.excess - frame.excess;
+        if (frame.ruler_length + minSpan(r, left) >= currentGlobalBest) [[unlikely]] {
+            stackTop--;
+            continue;
+        }
+
+        const int max_pos = currentGlobalBest - minSpan(r - 1, left) - 1;
+        int startNext = frame.next_candidate;
+        if (startNext == 0) {
+            startNext = frame.ruler_length + 1;
+        }
+
+        bool pushedChild = false;
+
+        for (int pos = startNext; pos <= max_pos; ++pos) {
+            const int newGlobalBest = globalBound.value().load(std::memory_order_relaxed);
+            if (pos >= newGlobalBest) [[unlikely]] break;
+            if (frame.marks_count == 1 && 2 * pos >= newGlobalBest) break;
+
+            const int offset = pos - frame.ruler_length;
+            const BitSet128 new_dist = frame.reversed_marks << offset;
+            const int repeats = repeatsNear(frame, new_dist, config);
+            if (repeats < 0) continue;
+
+            const int newMarksCount = frame.marks_count + 1;
+
+            if (newMarksCount == n) {
+                if (pos < threadBest.bestLen &&
+                    canonicalNear(frame.reversed_marks, frame.ruler_length, pos)) {
+                    threadBest.bestLen = pos;
+                    BitSet128 final_marks = new_dist;
+                    final_marks.set(0);
+                    extractMarksNear(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
+                    globalBound.lower(pos);
+                }
+            } else {
+                frame.next_candidate = pos + 1;
+
+                NearFrame<P>& child = stack[stackTop + 1];
+                child.reversed_marks = new_dist;
+                child.reversed_marks.set(0);
+                addDistancesNear(frame, new_dist, child);
+                child.excess = frame.excess + repeats;
+                child.marks_count = newMarksCount;
+                child.ruler_length = pos;
+                child.next_candidate = 0;
+
+                stackTop++;
+                pushedChild = true;
+                break;
+            }
+        }
+
+        if (!pushedChild) {
+            stackTop--;
+        }
+    }
+}
+
+int prefixDepthNear(int n) {
+    if (n <= 6) return 2;
+    if (n <= 10) return 3;
+    if (n <= 14) return 4;
+    return std::max(2, std::min(5, n - 3));
+}
+
+template <int P>
+bool runNear(int n, int maxLen, const NearConfig& config, int prefixDepth,
+             GolombRuler& best, NearStats& stats) {
+    stats.planes = P;
+
+    if (prefixDepth <= 0) prefixDepth = prefixDepthNear(n);
+    prefixDepth = std::max(2, std::min(prefixDepth, n - 1));
+    stats.prefixDepth = prefixDepth;
+
+    NearFrame<P> root{};
+    root.reversed_marks.set(0);
+    root.excess = 0;
+    root.marks_count = 1;
+    root.ruler_length = 0;
+    root.next_candidate = 0;
+
+    std::vector<NearFrame<P>> prefixes;
+    generatePrefixesNear(root, prefixDepth, maxLen + 1, config, prefixes);
+    const int numPrefixes = static_cast<int>(prefixes.size());
+    stats.prefixCount = numPrefixes;
+
+    SharedBound globalBound(maxLen + 1, BoundPolicy::Atomic);
+    std::atomic<long long> explored(0);
+    int finalBestLen = maxLen + 1;
+    int finalBestMarks[MAX_MARKS_NEAR] = {0};
+    int finalBestNumMarks = 0;
+
+    #pragma omp parallel shared(globalBound, explored, finalBestLen, finalBestMarks, finalBestNumMarks)
+    {
+        ThreadBestNear threadBest{};
+        threadBest.bestLen = maxLen + 1;
+        threadBest.bestNumMarks = 0;
+        long long threadExplored = 0;
+        alignas(64) NearFrame<P> stack[MAX_MARKS_NEAR];
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < numPrefixes; ++i) {
+            stack[0] = prefixes[static_cast<size_t>(i)];
+            backtrackNear(threadBest, config, globalBound, threadExplored, stack);
+        }
+
+        explored.fetch_add(threadExplored, std::memory_order_relaxed);
+
+        if (threadBest.bestNumMarks > 0) {
+            #pragma omp critical(merge_best_near)
+            {
+                if (threadBest.bestLen < finalBestLen) {
+                    finalBestLen = threadBest.bestLen;
+                    finalBestNumMarks = threadBest.bestNumMarks;
+                    std::copy(threadBest.bestMarks, threadBest.bestMarks + threadBest.bestNumMarks,
+                              finalBestMarks);
+                }
+            }
+        }
+    }
+
+    stats.explored = explored.load(std::memory_order_relaxed);
+    best.marks.assign(finalBestMarks, finalBestMarks + finalBestNumMarks);
+    best.computeLength();
+    return finalBestNumMarks > 0;
+}
+
+} // namespace
+
+bool searchNearGolomb(int n, int maxLen, const NearOptions& options,
+                      GolombRuler& best, NearStats& stats) {
+    stats = NearStats{};
+    maxLen = std::min(maxLen, MAX_LEN_NEAR);
+    best.marks.clear();
+
+    if (n <= 2 || n > MAX_MARKS_NEAR) {
+        if (n == 1) best.marks = {0};
+        if (n == 2 && maxLen >= 1) best.marks = {0, 1};
+        best.computeLength();
+        return !best.marks.empty();
+    }
+
+    // maxRepeat binds only below k + 1; 1 is a Golomb ruler
+    NearConfig config{n, std::max(0, options.excess), false};
+    int planes = 1;
+    if (options.maxRepeat == 1) {
+        config.excess = 0;
+    } else if (options.maxRepeat > 1 && options.maxRepeat <= config.excess) {
+        planes = std::min(options.maxRepeat, MAX_REPEAT_NEAR);
+        config.capped = true;
+    }
+
+    switch (planes) {
+        case 1: return runNear<1>(n, maxLen, config, options.prefixDepth, best, stats);
+        case 2: return runNear<2>(n, maxLen, config, options.prefixDepth, best, stats);
+        case 3: return runNear<3>(n, maxLen, config, options.prefixDepth, best, stats);
+        default: return runNear<4>(n, maxLen, config, options.prefixDepth, best, stats);
+    }
+}
+
+int nearRulerExcess(const std::vector<int>& marks, int* maxMultiplicity) {
+    std::vector<int> count(marks.empty() ? 1 : static_cast<size_t>(marks.back()) + 1, 0);
+    int excess = 0;
+    int maxMult = 0;
+    for (size_t i = 0; i < marks.size(); ++i) {
+        for (size_t j = i + 1; j < marks.size(); ++j) {
+            const int d = marks[j] - marks[i];
+            if (d <= 0 || d >= static_cast<int>(count.size())) return -1;
+            if (count[static_cast<size_t>(d)]++ > 0) excess++;
+            maxMult = std::max(maxMult, count[static_cast<size_t>(d)]);
+        }
+    }
+    if (maxMultiplicity) *maxMultiplicity = maxMult;
+    return excess;
+}
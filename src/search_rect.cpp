@@ -0,0 +1,389 @@
+#include "search_rect.hpp"
+#include "simd_bitset.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <omp.h>
+
+// =============================================================================
+// 2-D SEARCH - One template instance per word count W of the padded bitmap
+// =============================================================================
+// Frames { reversed_marks, used_dist, columns } are copied on push as in V5.
+// A candidate is a padded index pos > last with pos % S < width (Costas: in
+// row `count`, free column); its new differences are reversed_marks shifted
+// by pos - last, tested on the words below pos only.
+// =============================================================================
+
+namespace {
+
+#ifdef _MSC_VER
+inline int ctz64(uint64_t x) { unsigned long i; _BitScanForward64(&i, x); return static_cast<int>(i); }
+#else
+inline int ctz64(uint64_t x) { return __builtin_ctzll(x); }
+#endif
+
+struct RectConfig {
+    int width;
+    int height;
+    int stride;      // S = 2 width - 1
+    int points;
+    int lastIndex;   // Padded index of the bottom-right cell
+    bool costas;
+    RectMode mode;
+};
+
+// First cell >= pos where point `count` may go, -1 if none up to limit
+inline int nextCell(const RectConfig& c, int count, uint64_t columns, int pos, int limit) {
+    if (c.costas) {
+        const int rowStart = count * c.stride;
+        const int x = std::max(pos - rowStart, 0);
+        uint64_t free = ~columns & ((1ULL << c.width) - 1);
+        free &= ~0ULL << x;
+        if (!free) return -1;
+        const int cell = rowStart + ctz64(free);
+        return cell <= limit ? cell : -1;
+    }
+    while (pos <= limit) {
+        const int x = pos % c.stride;
+        if (x < c.width) return pos;
+        pos += c.stride - x;
+    }
+    return -1;
+}
+
+// =============================================================================
+// DIHEDRAL SYMMETRY - lexicographic leader over the images of a point set
+// =============================================================================
+inline RectPoint transformPoint(const RectPoint& p, int t, int w, int h) {
+    switch (t) {
+        case 0: return {p.x, p.y};
+        case 1: return {w - 1 - p.x, p.y};
+        case 2: return {p.x, h - 1 - p.y};
+        case 3: return {w - 1 - p.x, h - 1 - p.y};
+        case 4: return {p.y, p.x};                   // Transpositions: square grids only
+        case 5: return {h - 1 - p.y, p.x};
+        case 6: return {p.y, w - 1 - p.x};
+        default: return {h - 1 - p.y, w - 1 - p.x};
+    }
+}
+
+// Sorted row-major keys of the image, translated to the top-left corner
+void normalizedKeys(const std::vector<RectPoint>& points, int t, int w, int h, std::vector<int>& keys) {
+    keys.clear();
+    int minX = MAX_SIDE_RECT;
+    int minY = MAX_SIDE_RECT;
+    for (const RectPoint& p : points) {
+        const RectPoint q = transformPoint(p, t, w, h);
+        minX = std::min(minX, q.x);
+        minY = std::min(minY, q.y);
+    }
+    for (const RectPoint& p : points) {
+        const RectPoint q = transformPoint(p, t, w, h);
+        keys.push_back((q.y - minY) * 64 + (q.x - minX));
+    }
+    std::sort(keys.begin(), keys.end());
+}
+
+// Orbit size if the set is the leader of its class, 0 otherwise
+int leaderOrbit(const std::vector<RectPoint>& points, int w, int h, int symmetries,
+                std::vector<int>& keys, std::vector<int>& image) {
+    normalizedKeys(points, 0, w, h, keys);
+    int stabilizer = 1;
+    for (int t = 1; t < symmetries; ++t) {
+        normalizedKeys(points, t, w, h, image);
+        if (image < keys) return 0;
+        if (image == keys) ++stabilizer;
+    }
+    return symmetries / stabilizer;
+}
+
+template <int W>
+struct alignas(64) RectFrame {
+    simd_bits::WideBitSet<W> reversed_marks;  // bit j: point at padded index last - j
+    simd_bits::WideBitSet<W> used_dist;
+    uint64_t columns;
+    int count;
+    int last;
+    int next;
+};
+
+struct RectShared {
+    std::atomic<bool> stop{false};
+    std::vector<RectPoint> found;
+};
+
+template <int W>
+void pointsOf(const simd_bits::WideBitSet<W>& reversed_marks, int last, int stride,
+              std::vector<RectPoint>& points) {
+    points.clear();
+    for (int i = 0; i < W; ++i) {
+        for (uint64_t word = reversed_marks.w[i]; word; word &= word - 1) {
+            const int index = last - (i * 64 + ctz64(word));
+            points.push_back({index % stride, index / stride});
+        }
+    }
+    std::reverse(points.begin(), points.end());  // Row-major order
+}
+
+struct RectThread {
+    long long explored = 0;
+    long long classes = 0;
+    long long placements = 0;
+    std::vector<RectPoint> points;
+    std::vector<int> keys;
+    std::vector<int> image;
+};
+
+template <int W>
+void leafRect(const RectConfig& c, const RectFrame<W>& frame, int pos, int symmetries,
+              RectShared& shared, RectThread& thread) {
+    simd_bits::WideBitSet<W> marks;
+    frame.reversed_marks.shiftLeftInto(pos - frame.last, marks);
+    marks.set(0);
+    pointsOf(marks, pos, c.stride, thread.points);
+
+    if (c.mode == RectMode::Find) {
+        if (!shared.stop.exchange(true)) {
+            shared.found = thread.points;
+        }
+        return;
+    }
+
+    // Translation: leftmost point in column 0 (row 0 holds the first point)
+    int minX = c.width;
+    for (const RectPoint& p : thread.points) minX = std::min(minX, p.x);
+    if (minX != 0) return;
+
+    const int orbit = leaderOrbit(thread.points, c.width, c.height, symmetries,
+                                  thread.keys, thread.image);
+    if (orbit > 0) {
+        thread.classes++;
+        thread.placements += orbit;
+    }
+}
+
+template <int W>
+inline void childRect(const RectFrame<W>& frame, int pos, RectFrame<W>& child, int stride) {
+    frame.reversed_marks.shiftLeftInto(pos - frame.last, child.reversed_marks);  // New differences
+    child.used_dist = frame.used_dist;
+    child.used_dist.orWith(child.reversed_marks);
+    child.reversed_marks.set(0);
+    child.columns = frame.columns | (1ULL << (pos % stride));
+    child.count = frame.count + 1;
+    child.last = pos;
+    child.next = 0;
+}
+
+inline int limitRect(const RectConfig& c, int count) {
+    const int r = c.points - count - 1;  // Points after the candidate
+    return c.lastIndex - (r * (r + 1)) / 2;
+}
+
+template <int W>
+void generatePrefixesRect(const RectConfig& c, const RectFrame<W>& frame, int depth,
+                          std::vector<RectFrame<W>>& prefixes) {
+    if (frame.count == depth) {
+        prefixes.push_back(frame);
+        return;
+    }
+    const int limit = limitRect(c, frame.count);
+    for (int pos = nextCell(c, frame.count, frame.columns, frame.last + 1, limit); pos >= 0;
+         pos = nextCell(c, frame.count, frame.columns, pos + 1, limit)) {
+        if (frame.reversed_marks.shiftedIntersects(pos - frame.last, frame.used_dist, (pos >> 6) + 1)) {
+            continue;
+        }
+        RectFrame<W> child;
+        childRect(frame, pos, child, c.stride);
+        generatePrefixesRect(c, child, depth, prefixes);
+    }
+}
+
+template <int W>
+void backtrackRect(const RectConfig& c, int symmetries, RectFrame<W>* stack,
+                   RectShared& shared, RectThread& thread) {
+    int stackTop = 0;
+
+    while (stackTop >= 0) {
+        if (shared.stop.load(std::memory_order_relaxed)) [[unlikely]] return;
+        thread.explored++;
+
+        RectFrame<W>& frame = stack[stackTop];
+        const int limit = limitRect(c, frame.count);
+        const int start = frame.next ? frame.next : frame.last + 1;
+        bool pushedChild = false;
+
+        for (int pos = nextCell(c, frame.count, frame.columns, start, limit); pos >= 0;
+             pos = nextCell(c, frame.count, frame.columns, pos + 1, limit)) {
+            if (frame.reversed_marks.shiftedIntersects(pos - frame.last, frame.used_dist,
+                                                       (pos >> 6) + 1)) [[likely]] {
+                continue;
+            }
+
+            if (frame.count + 1 == c.points) {
+                leafRect(c, frame, pos, symmetries, shared, thread);
+                if (shared.stop.load(std::memory_order_relaxed)) return;
+                continue;
+            }
+
+            frame.next = pos + 1;
+            childRect(frame, pos, stack[stackTop + 1], c.stride);
+            stackTop++;
+            pushedChild = true;
+            break;
+        }
+
+        if (!pushedChild) {
+            stackTop--;
+        }
+    }
+}
+
+int autoPrefixDepthRect(const RectConfig& c) {
+    return std::min(c.points - 1, c.costas ? 4 : 3);
+}
+
+template <int W>
+void runRect(const RectConfig& c, int prefixDepth, RectResult& result) {
+    using Frame = RectFrame<W>;
+    result.words = W;
+    result.symmetries = (c.width == c.height) ? 8 : 4;
+
+    if (prefixDepth <= 0) prefixDepth = autoPrefixDepthRect(c);
+    prefixDepth = std::max(1, std::min(prefixDepth, c.points - 1));
+    result.prefixDepth = prefixDepth;
+
+    // Roots: the first point, in row 0 (translation). Costas Count: a leader
+    // is not above its horizontal mirror, whose first point is in column
+    // width - 1 - x, so x <= (width - 1) / 2
+    const int rootColumns = (c.costas && c.mode == RectMode::Count) ? (c.width + 1) / 2 : c.width;
+    std::vector<Frame> prefixes;
+    for (int x = 0; x < rootColumns; ++x) {
+        Frame root;
+        root.reversed_marks.set(0);
+        root.columns = 1ULL << x;
+        root.count = 1;
+        root.last = x;
+        root.next = 0;
+        generatePrefixesRect(c, root, prefixDepth, prefixes);
+    }
+    const int numPrefixes = static_cast<int>(prefixes.size());
+    result.prefixCount = numPrefixes;
+
+    RectShared shared;
+    long long explored = 0;
+    long long classes = 0;
+    long long placements = 0;
+
+    #pragma omp parallel reduction(+ : explored, classes, placements)
+    {
+        RectThread thread;
+        auto stack = std::make_unique<Frame[]>(static_cast<size_t>(MAX_POINTS_RECT));
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int i = 0; i < numPrefixes; ++i) {
+            if (shared.stop.load(std::memory_order_relaxed)) continue;
+            stack[0] = prefixes[static_cast<size_t>(i)];
+            backtrackRect(c, result.symmetries, stack.get(), shared, thread);
+        }
+
+        explored += thread.explored;
+        classes += thread.classes;
+        placements += thread.placements;
+    }
+
+    result.explored = explored;
+    result.classes = classes;
+    result.placements = placements;
+    result.points = shared.found;
+    result.found = (c.mode == RectMode::Find) ? !shared.found.empty() : classes > 0;
+}
+
+int wordsForBits(int bits) {
+    int words = 2;
+    while (words * 64 < bits) words *= 2;
+    return words;
+}
+
+} // namespace
+
+bool searchGolombRect(const RectOptions& options, RectResult& result) {
+    result = RectResult{};
+
+    RectConfig c;
+    c.costas = options.costas;
+    c.width = c.costas ? options.points : options.width;
+    c.height = c.costas ? options.points : options.height;
+    c.points = options.points;
+    c.mode = options.mode;
+    if (c.width < 1 || c.height < 1 || c.width > MAX_SIDE_RECT || c.height > MAX_SIDE_RECT ||
+        c.points > MAX_POINTS_RECT) {
+        return false;
+    }
+    c.stride = 2 * c.width - 1;
+    c.lastIndex = (c.height - 1) * c.stride + c.width - 1;
+
+    if (c.points < 2) {
+        // One point (or none): always, one class
+        result.found = c.points >= 0;
+        if (c.points == 1) result.points = {{0, 0}};
+        result.classes = result.found ? 1 : 0;
+        result.placements = result.classes;
+        return true;
+    }
+
+    switch (wordsForBits(c.lastIndex + 1)) {
+        case 2: runRect<2>(c, options.prefixDepth, result); break;
+        case 4: runRect<4>(c, options.prefixDepth, result); break;
+        case 8: runRect<8>(c, options.prefixDepth, result); break;
+        case 16: runRect<16>(c, options.prefixDepth, result); break;
+        default: runRect<32>(c, options.prefixDepth, result); break;
+    }
+    return true;
+}
+
+int maxGolombRect(int width, int height, int prefixDepth, RectResult& result,
+                  std::vector<RectResult>* steps) {
+    RectOptions options;
+    options.width = width;
+    options.height = height;
+    options.prefixDepth = prefixDepth;
+    options.mode = RectMode::Find;
+
+    result = RectResult{};
+    int best = 0;
+    for (int points = 1; points <= width * height; ++points) {
+        options.points = points;
+        RectResult step;
+        if (!searchGolombRect(options, step)) return -1;
+        if (steps) steps->push_back(step);
+        if (!step.found) break;
+        best = points;
+        result = step;
+    }
+    return best;
+}
+
+bool isGolombRectangle(const std::vector<RectPoint>& points, int width, int height) {
+    std::vector<char> seen(static_cast<size_t>(4 * width * height), 0);
+    for (size_t i = 0; i < points.size(); ++i) {
+        const RectPoint& p = points[i];
+        if (p.x < 0 || p.x >= width || p.y < 0 || p.y >= height) return false;
+        for (size_t j = i + 1; j < points.size(); ++j) {
+            const RectPoint& q = points[j];
+            // Unordered pair: orient the vector so that (dy, dx) > (0, 0)
+            int dx = q.x - p.x;
+            int dy = q.y - p.y;
+            if (dy < 0 || (dy == 0 && dx < 0)) {
+                dx = -dx;
+                dy = -dy;
+            }
+            if (dx == 0 && dy == 0) return false;
+            const size_t key = static_cast<size_t>(dy * (2 * width) + dx + width);
+            if (seen[key]) return false;
+            seen[key] = 1;
+        }
+    }
+    return true;
+}
@@ -1,4 +1,5 @@
 #include "search_sequential_v2.hpp"
+#include "simd_bitset.hpp"
 #include <cstdint>
 #include <cstring>
 
@@ -10,7 +11,7 @@
 //   - V5 uses BitSet128 shift trick: O(1) collision detection
 //
 // This version applies the V5 optimization to sequential code:
-//   - BitSet128 (2x uint64_t) for reversed_marks and used_dist
+//   - BitSet128 (simd_bitset.hpp: SSE / NEON) for reversed_marks and used_dist
 //   - reversed_marks << offset computes ALL new differences in one op
 //   - Single (new_dist & used_dist).any() for collision test
 //   - No explicit marks array - marks encoded in reversed_marks bits
@@ -22,61 +23,10 @@ constexpr int MAX_MARKS_V2 = 24;
 constexpr int MAX_LEN_V2 = 127;
 
 // =============================================================================
-// FAST 128-BIT BITSET using 2x uint64_t
+// 128-BIT BITSET - portable SIMD layer (simd_bitset.hpp): SSE on x86, NEON
+// on ARM, two uint64_t with -DGOLOMB_SIMD_SCALAR
 // =============================================================================
-struct alignas(16) BitSet128 {
-    uint64_t lo;  // bits 0-63
-    uint64_t hi;  // bits 64-127
-
-    BitSet128() : lo(0), hi(0) {}
-    BitSet128(uint64_t l, uint64_t h) : lo(l), hi(h) {}
-
-    // Set bit at position
-    inline void set(int pos) {
-        if (pos < 64) {
-            lo |= (1ULL << pos);
-        } else {
-            hi |= (1ULL << (pos - 64));
-        }
-    }
-
-    // Test bit at position
-    inline bool test(int pos) const {
-        if (pos < 64) {
-            return (lo >> pos) & 1;
-        } else {
-            return (hi >> (pos - 64)) & 1;
-        }
-    }
-
-    // Left shift by n positions
-    inline BitSet128 operator<<(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128(0, 0);
-        if (n >= 64) {
-            return BitSet128(0, lo << (n - 64));
-        }
-        // n < 64
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128(new_lo, new_hi);
-    }
-
-    // Bitwise AND
-    inline BitSet128 operator&(const BitSet128& other) const {
-        return BitSet128(lo & other.lo, hi & other.hi);
-    }
-
-    // Bitwise XOR
-    inline BitSet128 operator^(const BitSet128& other) const {
-        return BitSet128(lo ^ other.lo, hi ^ other.hi);
-    }
-
-    // Check if any bit is set
-    inline bool any() const {
-        return (lo | hi) != 0;
-    }
-};
+using BitSet128 = SimdBitSet128;
 
 // =============================================================================
 // STACK FRAME - Minimal state for iterative backtracking
@@ -204,8 +154,7 @@ static void backtrackIterativeV2(
                 newFrame.reversed_marks.set(0);
 
                 // Update used_dist: XOR in new differences
-                newFrame.used_dist.lo = frame.used_dist.lo ^ new_dist.lo;
-                newFrame.used_dist.hi = frame.used_dist.hi ^ new_dist.hi;
+                newFrame.used_dist = frame.used_dist ^ new_dist;
 
                 newFrame.marks_count = newMarksCount;
                 newFrame.ruler_length = pos;
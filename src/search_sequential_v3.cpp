@@ -1,10 +1,11 @@
 #include "search_sequential_v3.hpp"
 #include <cstdint>
 #include <cstring>
-#include <immintrin.h>
+#include "simd_bitset.hpp"
 
 // Cross-platform prefetch macro
 #ifdef _MSC_VER
+    #include <immintrin.h>
     #define PREFETCH(addr) _mm_prefetch((const char*)(addr), _MM_HINT_T0)
 #else
     #define PREFETCH(addr) __builtin_prefetch((addr), 1, 3)
@@ -14,8 +15,8 @@
 // OPTIMIZED GOLOMB RULER SEARCH - SEQUENTIAL VERSION 3 (SIMD)
 // =============================================================================
 // Key optimizations over V2:
-// 1. Native __m128i SIMD operations (SSE2)
-// 2. _mm_testz_si128 for fast any() check (single instruction)
+// 1. Native 128-bit vector operations (SSE2/SSE4.1 on x86, NEON on ARM)
+// 2. Branch-free shift, single-instruction any() (PTEST with SSE4.1)
 // 3. Avoid double shift - reuse new_dist for reversed_marks update
 // 4. Local bestLen cache to reduce memory reads
 // 5. Prefetch next stack frame for better cache behavior
@@ -28,106 +29,17 @@ constexpr int MAX_MARKS_V3 = 24;
 constexpr int MAX_LEN_V3 = 127;
 
 // =============================================================================
-// FAST 128-BIT BITSET using SSE2 intrinsics
+// 128-BIT BITSET - portable SIMD layer (SSE on x86, NEON on ARM, see
+// simd_bitset.hpp): shift, set and test stay in vector registers
 // =============================================================================
-struct alignas(16) BitSet128SSE {
-    __m128i data;
-
-    BitSet128SSE() : data(_mm_setzero_si128()) {}
-    BitSet128SSE(__m128i d) : data(d) {}
-    BitSet128SSE(uint64_t lo, uint64_t hi) : data(_mm_set_epi64x(hi, lo)) {}
-
-    // Set bit at position
-    inline void set(int pos) {
-        alignas(16) uint64_t vals[2];
-        _mm_store_si128((__m128i*)vals, data);
-        if (pos < 64) {
-            vals[0] |= (1ULL << pos);
-        } else {
-            vals[1] |= (1ULL << (pos - 64));
-        }
-        data = _mm_load_si128((__m128i*)vals);
-    }
-
-    // Test bit at position
-    inline bool test(int pos) const {
-        alignas(16) uint64_t vals[2];
-        _mm_store_si128((__m128i*)vals, data);
-        if (pos < 64) {
-            return (vals[0] >> pos) & 1;
-        } else {
-            return (vals[1] >> (pos - 64)) & 1;
-        }
-    }
-
-    // Left shift by n positions - optimized SIMD version
-    inline BitSet128SSE operator<<(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128SSE();
-
-        alignas(16) uint64_t vals[2];
-        _mm_store_si128((__m128i*)vals, data);
-
-        uint64_t lo = vals[0];
-        uint64_t hi = vals[1];
-
-        if (n >= 64) {
-            // Shift by 64+ bits: lo goes to hi, lo becomes 0
-            uint64_t new_hi = lo << (n - 64);
-            return BitSet128SSE(0, new_hi);
-        }
-
-        // n < 64: need to handle carry from lo to hi
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128SSE(new_lo, new_hi);
-    }
-
-    // Bitwise AND - single SIMD instruction
-    inline BitSet128SSE operator&(const BitSet128SSE& other) const {
-        return BitSet128SSE(_mm_and_si128(data, other.data));
-    }
-
-    // Bitwise OR - single SIMD instruction
-    inline BitSet128SSE operator|(const BitSet128SSE& other) const {
-        return BitSet128SSE(_mm_or_si128(data, other.data));
-    }
-
-    // Bitwise XOR - single SIMD instruction
-    inline BitSet128SSE operator^(const BitSet128SSE& other) const {
-        return BitSet128SSE(_mm_xor_si128(data, other.data));
-    }
-
-    // Check if any bit is set - single SIMD instruction!
-    inline bool any() const {
-        return !_mm_testz_si128(data, data);
-    }
-
-    // Check if zero
-    inline bool none() const {
-        return _mm_testz_si128(data, data);
-    }
-
-    // Get lo/hi for direct manipulation
-    inline uint64_t getLo() const {
-        alignas(16) uint64_t vals[2];
-        _mm_store_si128((__m128i*)vals, data);
-        return vals[0];
-    }
-
-    inline uint64_t getHi() const {
-        alignas(16) uint64_t vals[2];
-        _mm_store_si128((__m128i*)vals, data);
-        return vals[1];
-    }
-};
+using BitSet128SIMD = SimdBitSet128;
 
 // =============================================================================
 // STACK FRAME - Minimal state for iterative backtracking
 // =============================================================================
 struct alignas(64) StackFrameV3 {
-    BitSet128SSE reversed_marks;  // Marks encoded as bits
-    BitSet128SSE used_dist;       // Differences used so far
+    BitSet128SIMD reversed_marks;  // Marks encoded as bits
+    BitSet128SIMD used_dist;       // Differences used so far
     int marks_count;              // Number of marks placed
     int ruler_length;             // Current ruler length
     int next_candidate;           // Next position to try
@@ -146,7 +58,7 @@ struct alignas(64) SearchStateV3 {
 // =============================================================================
 // EXTRACT MARKS FROM reversed_marks
 // =============================================================================
-static void extractMarks(const BitSet128SSE& reversed_marks,
+static void extractMarks(const BitSet128SIMD& reversed_marks,
                          int ruler_length, int* marks, int& numMarks) {
     numMarks = 0;
     for (int i = 0; i <= ruler_length; ++i) {
@@ -207,7 +119,7 @@ static void backtrackIterativeV3(
             const int offset = pos - frame.ruler_length;
 
             // O(1) COLLISION DETECTION: shift computes all new differences
-            BitSet128SSE new_dist = frame.reversed_marks << offset;
+            BitSet128SIMD new_dist = frame.reversed_marks << offset;
 
             // Single SIMD AND + testz check
             if ((new_dist & frame.used_dist).any()) [[likely]] {
@@ -225,7 +137,7 @@ static void backtrackIterativeV3(
                     state.bestLen = solutionLen;  // Sync to state
 
                     // Reuse new_dist, just set bit 0
-                    BitSet128SSE final_marks = new_dist;
+                    BitSet128SIMD final_marks = new_dist;
                     final_marks.set(0);
 
                     extractMarks(final_marks, pos, state.bestMarks, state.bestNumMarks);
@@ -301,12 +213,12 @@ void searchGolombSequentialV3(int n, int maxLen, GolombRuler& best)
         StackFrameV3& frame0 = stack[0];
 
         // reversed_marks for {0, firstMark}
-        frame0.reversed_marks = BitSet128SSE();
+        frame0.reversed_marks = BitSet128SIMD();
         frame0.reversed_marks.set(0);         // mark at ruler_length
         frame0.reversed_marks.set(firstMark); // mark at 0
 
         // used_dist: only difference is firstMark
-        frame0.used_dist = BitSet128SSE();
+        frame0.used_dist = BitSet128SIMD();
         frame0.used_dist.set(firstMark);
 
         frame0.marks_count = 2;
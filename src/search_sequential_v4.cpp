@@ -1,4 +1,5 @@
 #include "search_sequential_v4.hpp"
+#include "simd_bitset.hpp"
 #include <cstdint>
 #include <cstring>
 
@@ -6,13 +7,14 @@
 // OPTIMIZED GOLOMB RULER SEARCH - SEQUENTIAL VERSION 4
 // =============================================================================
 // Combines ALL optimizations:
-// 1. BitSet128 (2x uint64_t) for O(1) collision detection via shift
+// 1. BitSet128 (simd_bitset.hpp: SSE / NEON) for O(1) collision detection via shift
 // 2. Mirror symmetry breaking: skip solutions where a_1 >= a_{n-1} - a_{n-2}
 // 3. Configurable initial bound for aggressive early pruning
 // 4. Track firstMark separately for symmetry check at solution time
 // 5. Reuse new_dist to avoid computing shift twice
 // 6. Local bestLen cache to minimize memory access
 // 7. Tight bounds: a_1 <= bestLen/2 (prefix symmetry)
+// 8. Optional pattern database bound (pattern_db.hpp) on the remaining marks
 // =============================================================================
 
 static long long g_exploredCountV4 = 0;
@@ -21,50 +23,10 @@ constexpr int MAX_MARKS_V4 = 24;
 constexpr int MAX_LEN_V4 = 127;
 
 // =============================================================================
-// FAST 128-BIT BITSET using 2x uint64_t (proven fastest for this use case)
+// 128-BIT BITSET - portable SIMD layer (simd_bitset.hpp): SSE on x86, NEON
+// on ARM, two uint64_t with -DGOLOMB_SIMD_SCALAR
 // =============================================================================
-struct alignas(16) BitSet128V4 {
-    uint64_t lo;  // bits 0-63
-    uint64_t hi;  // bits 64-127
-
-    BitSet128V4() : lo(0), hi(0) {}
-    BitSet128V4(uint64_t l, uint64_t h) : lo(l), hi(h) {}
-
-    inline void set(int pos) {
-        if (pos < 64) {
-            lo |= (1ULL << pos);
-        } else {
-            hi |= (1ULL << (pos - 64));
-        }
-    }
-
-    inline bool test(int pos) const {
-        if (pos < 64) {
-            return (lo >> pos) & 1;
-        } else {
-            return (hi >> (pos - 64)) & 1;
-        }
-    }
-
-    inline BitSet128V4 shiftLeft(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128V4(0, 0);
-        if (n >= 64) {
-            return BitSet128V4(0, lo << (n - 64));
-        }
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128V4(new_lo, new_hi);
-    }
-
-    inline bool hasOverlap(const BitSet128V4& other) const {
-        return ((lo & other.lo) | (hi & other.hi)) != 0;
-    }
-
-    inline BitSet128V4 xorWith(const BitSet128V4& other) const {
-        return BitSet128V4(lo ^ other.lo, hi ^ other.hi);
-    }
-};
+using BitSet128V4 = SimdBitSet128;
 
 // =============================================================================
 // STACK FRAME - State at each level
@@ -106,7 +68,8 @@ static void extractMarksV4(const BitSet128V4& reversed_marks,
 static void backtrackIterativeV4(
     SearchStateV4& state,
     const int n,
-    StackFrameV4* stack)
+    StackFrameV4* stack,
+    const PatternDB* patternDb)
 {
     int stackTop = 0;
     long long localExplored = 0;
@@ -117,9 +80,10 @@ static void backtrackIterativeV4(
 
         StackFrameV4& frame = stack[stackTop];
 
-        // Pruning: Golomb lower bound
+        // Pruning: Golomb lower bound, or the pattern database span
         const int r = n - frame.marks_count;
-        const int minAdditionalLength = (r * (r + 1)) / 2;
+        const int minAdditionalLength = patternDb ? patternDb->minSpan(r, frame.used_dist.lo())
+                                                  : (r * (r + 1)) / 2;
 
         if (frame.ruler_length + minAdditionalLength >= localBestLen) [[unlikely]] {
             stackTop--;
@@ -146,9 +110,9 @@ static void backtrackIterativeV4(
             const int offset = pos - frame.ruler_length;
 
             // O(1) collision detection via shift
-            BitSet128V4 new_dist = frame.reversed_marks.shiftLeft(offset);
+            BitSet128V4 new_dist = frame.reversed_marks << offset;
 
-            if (new_dist.hasOverlap(frame.used_dist)) [[likely]] {
+            if ((new_dist & frame.used_dist).any()) [[likely]] {
                 continue;
             }
 
@@ -185,7 +149,7 @@ static void backtrackIterativeV4(
                 newFrame.reversed_marks = new_dist;
                 newFrame.reversed_marks.set(0);
 
-                newFrame.used_dist = frame.used_dist.xorWith(new_dist);
+                newFrame.used_dist = frame.used_dist ^ new_dist;
                 newFrame.marks_count = newMarksCount;
                 newFrame.ruler_length = pos;
                 newFrame.next_candidate = 0;
@@ -208,7 +172,8 @@ static void backtrackIterativeV4(
 // =============================================================================
 // MAIN SEARCH FUNCTION - V4 with configurable bound
 // =============================================================================
-void searchGolombSequentialV4WithBound(int n, int initialBound, GolombRuler& best)
+void searchGolombSequentialV4WithBound(int n, int initialBound, GolombRuler& best,
+                                       const PatternDB* patternDb)
 {
     g_exploredCountV4 = 0;
 
@@ -252,7 +217,7 @@ void searchGolombSequentialV4WithBound(int n, int initialBound, GolombRuler& bes
         frame0.next_candidate = 0;
         frame0.first_mark = firstMark;  // Track for symmetry breaking
 
-        backtrackIterativeV4(state, n, stack);
+        backtrackIterativeV4(state, n, stack, patternDb);
     }
 
     if (state.bestNumMarks > 0) {
@@ -1,8 +1,11 @@
 #include "search_v5.hpp"
+#include "prefix_split.hpp"
+#include "simd_bitset.hpp"
 #include <atomic>
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <vector>
 #include <omp.h>
 
@@ -20,83 +23,22 @@
 //   - 43% of time spent in (new_dist & used_dist).any()
 //   - 33% of time spent in bitset<256>::operator<<=
 //
-// Solution: Use 2x uint64_t instead of bitset<256>
+// Solution: Use a 128-bit set instead of bitset<256>
 //   - Direct bit ops without abstraction overhead
-//   - Fits in 2 registers (128 bits total)
+//   - Fits in 1 vector register (SSE / NEON) or 2 GPRs (scalar build)
 //   - Sufficient for rulers up to length 127
 // =============================================================================
 
 static std::atomic<long long> exploredCountV5{0};
+static SearchStatsV5 searchStatsV5;
 
 constexpr int MAX_MARKS_V5 = 24;
-constexpr int MAX_LEN_V5 = 127;  // Max supported length with 2x uint64_t
 
 // =============================================================================
-// FAST 128-BIT BITSET using 2x uint64_t
+// 128-BIT BITSET - portable SIMD layer (simd_bitset.hpp): SSE on x86, NEON
+// on ARM, two uint64_t with -DGOLOMB_SIMD_SCALAR
 // =============================================================================
-struct alignas(16) BitSet128 {
-    uint64_t lo;  // bits 0-63
-    uint64_t hi;  // bits 64-127
-
-    BitSet128() : lo(0), hi(0) {}
-    BitSet128(uint64_t l, uint64_t h) : lo(l), hi(h) {}
-
-    // Set bit at position
-    inline void set(int pos) {
-        if (pos < 64) {
-            lo |= (1ULL << pos);
-        } else {
-            hi |= (1ULL << (pos - 64));
-        }
-    }
-
-    // Test bit at position
-    inline bool test(int pos) const {
-        if (pos < 64) {
-            return (lo >> pos) & 1;
-        } else {
-            return (hi >> (pos - 64)) & 1;
-        }
-    }
-
-    // Left shift by n positions (n < 64 for simplicity in hot path)
-    inline BitSet128 operator<<(int n) const {
-        if (n == 0) return *this;
-        if (n >= 128) return BitSet128(0, 0);
-        if (n >= 64) {
-            return BitSet128(0, lo << (n - 64));
-        }
-        // n < 64
-        uint64_t new_hi = (hi << n) | (lo >> (64 - n));
-        uint64_t new_lo = lo << n;
-        return BitSet128(new_lo, new_hi);
-    }
-
-    // Bitwise AND
-    inline BitSet128 operator&(const BitSet128& other) const {
-        return BitSet128(lo & other.lo, hi & other.hi);
-    }
-
-    // Bitwise OR
-    inline BitSet128 operator|(const BitSet128& other) const {
-        return BitSet128(lo | other.lo, hi | other.hi);
-    }
-
-    // Bitwise XOR
-    inline BitSet128 operator^(const BitSet128& other) const {
-        return BitSet128(lo ^ other.lo, hi ^ other.hi);
-    }
-
-    // Check if any bit is set
-    inline bool any() const {
-        return (lo | hi) != 0;
-    }
-
-    // Reset all bits
-    inline void reset() {
-        lo = hi = 0;
-    }
-};
+using BitSet128 = SimdBitSet128;
 
 // =============================================================================
 // WORK ITEM - A prefix to explore
@@ -117,6 +59,21 @@ struct alignas(32) StackFrameV5 {
     int marks_count;
     int ruler_length;
     int next_candidate;
+    int threshold;       // Deterministic kernel only: visit threshold
+};
+
+// =============================================================================
+// ORDERED STACK FRAME - Frame with a precomputed, scored candidate list
+// (CandidateOrderV5::FreeSmallDistances)
+// =============================================================================
+struct alignas(32) StackFrameOrderedV5 {
+    BitSet128 reversed_marks;
+    BitSet128 used_dist;
+    int marks_count;
+    int ruler_length;
+    int num_candidates;  // -1 until the candidate list is built
+    int next_index;
+    uint8_t candidates[MAX_LEN_V5 + 1];
 };
 
 // =============================================================================
@@ -126,6 +83,7 @@ struct alignas(64) ThreadBestV5 {
     int bestLen;
     int bestMarks[MAX_MARKS_V5];
     int bestNumMarks;
+    uint64_t bestKey;    // Deterministic kernel only: (length << 32) | prefix index
 };
 
 // =============================================================================
@@ -197,15 +155,116 @@ static void generatePrefixesV5(
     }
 }
 
+// =============================================================================
+// BOUND TIMELINE - Every improvement of the shared bound (rare, so a critical
+// section is fine)
+// =============================================================================
+struct BoundLogV5 {
+    SearchStatsV5& stats;
+    double start;
+};
+
+static void recordBoundV5(BoundLogV5& log, int length, bool heuristic)
+{
+    const double t = omp_get_wtime() - log.start;
+    #pragma omp critical(bound_timeline_v5)
+    {
+        log.stats.boundTimeline.push_back(BoundEventV5{t, length, heuristic});
+    }
+}
+
+// =============================================================================
+// RANDOMIZED GREEDY CONSTRUCTION (portfolio heuristic threads)
+// =============================================================================
+// Builds rulers mark by mark, picking at random among the HEURISTIC_CHOICES_V5
+// smallest valid positions. Every improvement is published straight into
+// the shared bound so the exact threads prune with it immediately.
+// Returns when no improvement was found for stallLimit attempts or when the
+// exact work queue is drained.
+// =============================================================================
+constexpr int HEURISTIC_CHOICES_V5 = 3;
+
+static void greedyPortfolioV5(
+    ThreadBestV5& threadBest,
+    const int n,
+    SharedBound& globalBound,
+    const std::atomic<int>& nextPrefix,
+    const int numPrefixes,
+    const int stallLimit,
+    uint64_t seed,
+    const BitSet128& forbidden,
+    BoundLogV5& boundLog)
+{
+    int attemptsSinceImprovement = 0;
+
+    while (attemptsSinceImprovement < stallLimit &&
+           nextPrefix.load(std::memory_order_relaxed) < numPrefixes) {
+        attemptsSinceImprovement++;
+
+        const int bound = globalBound.value().load(std::memory_order_relaxed);
+
+        BitSet128 reversed_marks;
+        BitSet128 used_dist = forbidden;
+        reversed_marks.set(0);
+        int marks_count = 1;
+        int ruler_length = 0;
+
+        while (marks_count < n) {
+            const int r = n - marks_count;
+            const int max_remaining = ((r - 1) * r) / 2;
+            const int max_pos = bound - max_remaining - 1;
+
+            int candidates[HEURISTIC_CHOICES_V5];
+            int numCandidates = 0;
+            for (int pos = ruler_length + 1;
+                 pos <= max_pos && numCandidates < HEURISTIC_CHOICES_V5; ++pos) {
+                BitSet128 new_dist = reversed_marks << (pos - ruler_length);
+                if (!(new_dist & used_dist).any()) {
+                    candidates[numCandidates++] = pos;
+                }
+            }
+            if (numCandidates == 0) break;
+
+            const int pos = candidates[prefix_split::splitmix64(seed) %
+                                       static_cast<uint64_t>(numCandidates)];
+            BitSet128 new_dist = reversed_marks << (pos - ruler_length);
+            used_dist = used_dist ^ new_dist;
+            reversed_marks = new_dist;
+            reversed_marks.set(0);
+            ruler_length = pos;
+            marks_count++;
+        }
+
+        if (marks_count < n || ruler_length >= threadBest.bestLen) {
+            continue;
+        }
+
+        threadBest.bestLen = ruler_length;
+        extractMarksV5(reversed_marks, ruler_length, threadBest.bestMarks, threadBest.bestNumMarks);
+
+        if (globalBound.lower(ruler_length)) {
+            recordBoundV5(boundLog, ruler_length, true);
+            attemptsSinceImprovement = 0;
+        }
+    }
+}
+
 // =============================================================================
 // CORE ITERATIVE BACKTRACKING - OPTIMIZED
 // =============================================================================
+// Bound: reader of the shared bound (bound_policy.hpp), fixed at compile
+// time so the Atomic policy costs exactly the plain atomic loads.
+// =============================================================================
+template <typename BoundReader>
 static void backtrackIterativeV5(
     ThreadBestV5& threadBest,
     const int n,
-    std::atomic<int>& globalBestLen,
+    SharedBound& globalBound,
+    BoundReader& bound,
     long long& localExplored,
-    StackFrameV5* stack)
+    StackFrameV5* stack,
+    BoundLogV5& boundLog,
+    const PatternDB* patternDb)
 {
     int stackTop = 0;
 
@@ -214,11 +273,13 @@ static void backtrackIterativeV5(
 
         StackFrameV5& frame = stack[stackTop];
 
-        const int currentGlobalBest = globalBestLen.load(std::memory_order_relaxed);
+        const int currentGlobalBest = bound.node();
 
-        // Pruning: Golomb lower bound
+        // Pruning: Golomb lower bound, or the pattern database span of the
+        // r remaining marks given the small distances already used
         const int r = n - frame.marks_count;
-        const int minAdditionalLength = (r * (r + 1)) / 2;
+        const int minAdditionalLength = patternDb ? patternDb->minSpan(r, frame.used_dist.lo())
+                                                  : (r * (r + 1)) / 2;
 
         if (frame.ruler_length + minAdditionalLength >= currentGlobalBest) [[unlikely]] {
             stackTop--;
@@ -240,7 +301,7 @@ static void backtrackIterativeV5(
 
         for (int pos = startNext; pos <= max_pos; ++pos) {
             // Re-check global best
-            const int newGlobalBest = globalBestLen.load(std::memory_order_relaxed);
+            const int newGlobalBest = bound.candidate();
             if (pos >= newGlobalBest) [[unlikely]] {
                 break;
             }
@@ -270,10 +331,9 @@ static void backtrackIterativeV5(
                     extractMarksV5(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
 
                     // Update global best atomically
-                    int expected = globalBestLen.load(std::memory_order_relaxed);
-                    while (solutionLen < expected &&
-                           !globalBestLen.compare_exchange_weak(expected, solutionLen,
-                               std::memory_order_release, std::memory_order_relaxed)) {
+                    bound.improved(solutionLen);
+                    if (globalBound.lower(solutionLen)) {
+                        recordBoundV5(boundLog, solutionLen, false);
                     }
                 }
             } else {
@@ -285,12 +345,183 @@ static void backtrackIterativeV5(
                 newFrame.reversed_marks = frame.reversed_marks << offset;
                 newFrame.reversed_marks.set(0);
 
-                newFrame.used_dist.lo = frame.used_dist.lo ^ new_dist.lo;
-                newFrame.used_dist.hi = frame.used_dist.hi ^ new_dist.hi;
+                newFrame.used_dist = frame.used_dist ^ new_dist;
+
+                newFrame.marks_count = newMarksCount;
+                newFrame.ruler_length = pos;
+                newFrame.next_candidate = 0;
+
+                stackTop++;
+                pushedChild = true;
+                break;
+            }
+        }
+
+        if (!pushedChild) {
+            stackTop--;
+        }
+    }
+}
+
+// =============================================================================
+// DETERMINISTIC BACKTRACKING - Same result and node count at any thread count
+// =============================================================================
+// The shared bound is a 64-bit key (length << 32 | prefix index) instead of a
+// length. Prefix i may still accept a ruler of the current best length when
+// i precedes the prefix that found it, so the search always returns the first
+// optimal ruler in DFS order (the lexicographically smallest) at the cost of
+// a one-unit looser bound on the earlier prefixes.
+//
+// Each frame carries its visit threshold: the smallest exclusive bound under
+// which a search reaches it. Nodes are counted per threshold; those with a
+// threshold <= the final length are visited by every run, whatever the
+// thread count or timing.
+// =============================================================================
+constexpr int THRESHOLD_SLOTS_V5 = MAX_LEN_V5 + 2;
+
+static inline uint64_t boundKeyV5(int length, uint32_t prefix) {
+    return (static_cast<uint64_t>(length) << 32) | prefix;
+}
+
+static inline int effectiveBoundV5(uint64_t key, uint32_t prefix) {
+    const int length = static_cast<int>(key >> 32);
+    return (prefix < static_cast<uint32_t>(key)) ? length + 1 : length;
+}
+
+// Visit threshold of a prefix root (replays the prefix generation tests)
+static int prefixThresholdV5(const BitSet128& reversed_marks, int ruler_length, int n) {
+    int marks[MAX_MARKS_V5];
+    int numMarks = 0;
+    extractMarksV5(reversed_marks, ruler_length, marks, numMarks);
+
+    int threshold = 0;
+    for (int k = 1; k < numMarks; ++k) {
+        const int r = n - k;
+        threshold = std::max(threshold, marks[k - 1] + (r * (r + 1)) / 2 + 1);
+        threshold = std::max(threshold, marks[k] + ((r - 1) * r) / 2 + 1);
+    }
+    return threshold;
+}
+
+// Audit digest: hash of a node (the partial ruler; reversed_marks alone
+// determines it, ruler_length being its highest bit)
+static inline uint64_t nodeHashV5(const BitSet128& reversed_marks) {
+    uint64_t state = reversed_marks.hi();
+    uint64_t mixed = prefix_split::splitmix64(state) ^ reversed_marks.lo();
+    return prefix_split::splitmix64(mixed);
+}
+
+// Counted nodes are those with threshold <= this length: the final best
+// length, or maxLen + 1 when only the virtual ruler remains
+static inline int finalLengthV5(uint64_t key) {
+    const int length = static_cast<int>(key >> 32);
+    return (static_cast<uint32_t>(key) == UINT32_MAX) ? length + 1 : length;
+}
+
+// Per-prefix digest before the final length is known: one slot per threshold
+struct DigestSlotV5 {
+    int threshold;
+    long long nodes;
+    uint64_t hash;
+};
+
+// Digest: also sum node hashes per threshold (audit mode)
+template <bool Digest>
+static void backtrackDeterministicV5(
+    ThreadBestV5& threadBest,
+    const int n,
+    std::atomic<uint64_t>& globalBestKey,
+    const uint32_t prefixIndex,
+    long long& localExplored,
+    long long* thresholdCounts,
+    uint64_t* thresholdHashes,
+    StackFrameV5* stack,
+    BoundLogV5& boundLog)
+{
+    int stackTop = 0;
+
+    while (stackTop >= 0) {
+        localExplored++;
+
+        StackFrameV5& frame = stack[stackTop];
+        if (frame.next_candidate == 0) {
+            thresholdCounts[frame.threshold]++;
+            if constexpr (Digest) {
+                thresholdHashes[frame.threshold] += nodeHashV5(frame.reversed_marks);
+            }
+        }
+
+        const int bound = effectiveBoundV5(globalBestKey.load(std::memory_order_relaxed), prefixIndex);
+
+        const int r = n - frame.marks_count;
+        const int minAdditionalLength = (r * (r + 1)) / 2;
+
+        if (frame.ruler_length + minAdditionalLength >= bound) [[unlikely]] {
+            stackTop--;
+            continue;
+        }
+
+        const int min_pos = frame.ruler_length + 1;
+        const int max_remaining = ((r - 1) * r) / 2;
+        const int max_pos = bound - max_remaining - 1;
+        const int childThreshold = std::max(frame.threshold, frame.ruler_length + minAdditionalLength + 1);
+
+        int startNext = frame.next_candidate;
+        if (startNext == 0) {
+            startNext = min_pos;
+        }
+
+        bool pushedChild = false;
+
+        for (int pos = startNext; pos <= max_pos; ++pos) {
+            const int newBound = effectiveBoundV5(globalBestKey.load(std::memory_order_relaxed), prefixIndex);
+            if (pos >= newBound) [[unlikely]] {
+                break;
+            }
+
+            const int offset = pos - frame.ruler_length;
+            BitSet128 new_dist = frame.reversed_marks << offset;
+
+            if ((new_dist & frame.used_dist).any()) [[likely]] {
+                continue;
+            }
+
+            const int newMarksCount = frame.marks_count + 1;
+
+            if (newMarksCount == n) {
+                const uint64_t key = boundKeyV5(pos, prefixIndex);
+                if (key < threadBest.bestKey) {
+                    threadBest.bestKey = key;
+                    threadBest.bestLen = pos;
+
+                    BitSet128 final_marks = frame.reversed_marks << offset;
+                    final_marks.set(0);
+
+                    extractMarksV5(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
+
+                    uint64_t expected = globalBestKey.load(std::memory_order_relaxed);
+                    while (key < expected &&
+                           !globalBestKey.compare_exchange_weak(expected, key,
+                               std::memory_order_release, std::memory_order_relaxed)) {
+                    }
+                    if (key < expected && pos < static_cast<int>(expected >> 32)) {
+                        recordBoundV5(boundLog, pos, false);
+                    }
+                }
+            } else {
+                frame.next_candidate = pos + 1;
+
+                StackFrameV5& newFrame = stack[stackTop + 1];
+
+                newFrame.reversed_marks = frame.reversed_marks << offset;
+                newFrame.reversed_marks.set(0);
+
+                newFrame.used_dist = frame.used_dist ^ new_dist;
 
                 newFrame.marks_count = newMarksCount;
                 newFrame.ruler_length = pos;
                 newFrame.next_candidate = 0;
+                newFrame.threshold = std::max(childThreshold, pos + max_remaining + 1);
 
                 stackTop++;
                 pushedChild = true;
@@ -304,6 +535,133 @@ static void backtrackIterativeV5(
     }
 }
 
+// =============================================================================
+// ORDERED BACKTRACKING - Value ordering that keeps small distances free
+// =============================================================================
+// Same search as backtrackIterativeV5, but the children of a node are tried
+// in increasing order of how many "small" distances (<= r(r+1)/2, the ones the
+// remaining r marks need most) they consume, ties broken by position.
+// The candidate list is built once per node; since it is not sorted by
+// position, candidates beyond the current bound are skipped, not cut.
+// =============================================================================
+static inline BitSet128 lowMaskV5(int bits) {
+    if (bits >= 128) return BitSet128(~0ULL, ~0ULL);
+    if (bits >= 64) return BitSet128(~0ULL, (bits == 64) ? 0 : (~0ULL >> (128 - bits)));
+    return BitSet128((bits == 0) ? 0 : (~0ULL >> (64 - bits)), 0);
+}
+
+static void backtrackOrderedV5(
+    ThreadBestV5& threadBest,
+    const int n,
+    SharedBound& globalBound,
+    long long& localExplored,
+    StackFrameOrderedV5* stack,
+    BoundLogV5& boundLog)
+{
+    std::atomic<int>& globalBestLen = globalBound.value();
+    int stackTop = 0;
+
+    while (stackTop >= 0) {
+        localExplored++;
+
+        StackFrameOrderedV5& frame = stack[stackTop];
+
+        const int currentGlobalBest = globalBestLen.load(std::memory_order_relaxed);
+
+        const int r = n - frame.marks_count;
+        const int minAdditionalLength = (r * (r + 1)) / 2;
+
+        if (frame.ruler_length + minAdditionalLength >= currentGlobalBest) [[unlikely]] {
+            stackTop--;
+            continue;
+        }
+
+        const int min_pos = frame.ruler_length + 1;
+        const int max_remaining = ((r - 1) * r) / 2;
+        const int max_pos = currentGlobalBest - max_remaining - 1;
+
+        // Last mark: ordering is irrelevant, the smallest valid position wins
+        if (r == 1) {
+            for (int pos = min_pos; pos <= max_pos; ++pos) {
+                BitSet128 new_dist = frame.reversed_marks << (pos - frame.ruler_length);
+                if ((new_dist & frame.used_dist).any()) continue;
+
+                if (pos < threadBest.bestLen) {
+                    threadBest.bestLen = pos;
+                    BitSet128 final_marks = new_dist;
+                    final_marks.set(0);
+                    extractMarksV5(final_marks, pos, threadBest.bestMarks, threadBest.bestNumMarks);
+
+                    if (globalBound.lower(pos)) {
+                        recordBoundV5(boundLog, pos, false);
+                    }
+                }
+                break;
+            }
+            stackTop--;
+            continue;
+        }
+
+        if (frame.num_candidates < 0) {
+            // Build and score the candidate list (insertion sort, <= 127 items)
+            const BitSet128 smallMask = lowMaskV5(minAdditionalLength + 1);
+            int keys[MAX_LEN_V5 + 1];
+            int count = 0;
+
+            for (int pos = min_pos; pos <= max_pos; ++pos) {
+                BitSet128 new_dist = frame.reversed_marks << (pos - frame.ruler_length);
+                if ((new_dist & frame.used_dist).any()) continue;
+
+                const BitSet128 small = new_dist & smallMask;
+                const int key = ((POPCOUNT64(small.lo()) + POPCOUNT64(small.hi())) << 8) | pos;
+
+                int j = count++;
+                while (j > 0 && keys[j - 1] > key) {
+                    keys[j] = keys[j - 1];
+                    --j;
+                }
+                keys[j] = key;
+            }
+
+            for (int i = 0; i < count; ++i) {
+                frame.candidates[i] = static_cast<uint8_t>(keys[i] & 0xFF);
+            }
+            frame.num_candidates = count;
+            frame.next_index = 0;
+        }
+
+        bool pushedChild = false;
+
+        while (frame.next_index < frame.num_candidates) {
+            const int pos = frame.candidates[frame.next_index++];
+
+            // Bound may have tightened since the list was built
+            if (pos > globalBestLen.load(std::memory_order_relaxed) - max_remaining - 1) {
+                continue;
+            }
+
+            const int offset = pos - frame.ruler_length;
+            BitSet128 new_dist = frame.reversed_marks << offset;
+
+            StackFrameOrderedV5& newFrame = stack[stackTop + 1];
+            newFrame.reversed_marks = new_dist;
+            newFrame.reversed_marks.set(0);
+            newFrame.used_dist = frame.used_dist ^ new_dist;
+            newFrame.marks_count = frame.marks_count + 1;
+            newFrame.ruler_length = pos;
+            newFrame.num_candidates = -1;
+
+            stackTop++;
+            pushedChild = true;
+            break;
+        }
+
+        if (!pushedChild) {
+            stackTop--;
+        }
+    }
+}
+
 // =============================================================================
 // COMPUTE OPTIMAL PREFIX DEPTH
 // =============================================================================
@@ -325,24 +683,34 @@ static int computePrefixDepthV5(int n, int numThreads) {
 }
 
 // =============================================================================
-// MAIN SEARCH FUNCTION - VERSION 5
+// CONSTRAINT: forbidden distances start out as already used
 // =============================================================================
-void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
-{
-    // Check max length constraint
-    if (maxLen > MAX_LEN_V5) {
-        maxLen = MAX_LEN_V5;
+static BitSet128 forbiddenMaskV5(const std::vector<int>& distances) {
+    BitSet128 forbidden;
+    for (int d : distances) {
+        if (d > 0 && d <= MAX_LEN_V5) {
+            forbidden.set(d);
+        }
     }
+    return forbidden;
+}
 
-    exploredCountV5.store(0, std::memory_order_relaxed);
-
-    std::atomic<int> globalBestLen(maxLen + 1);
-
-    int finalBestLen = maxLen + 1;
-    int finalBestMarks[MAX_MARKS_V5] = {0};
-    int finalBestNumMarks = 0;
+// =============================================================================
+// PREFIX SET FOR ONE INSTANCE (fixed depth or adaptive)
+// =============================================================================
+// Returns the fixed prefix depth used (0 for adaptive splitting)
+static int buildPrefixesV5(int n, int maxLen, const SearchOptionsV5& options,
+                           const BitSet128& forbidden, int numThreads,
+                           std::vector<WorkItemV5>& prefixes) {
+    // Adaptive splitting depends on the thread count: not deterministic
+    if (options.split == PrefixSplitV5::Adaptive && !options.deterministic) {
+        generatePrefixesAdaptive<BitSet128, WorkItemV5>(n, maxLen + 1, numThreads,
+                                                        options.tasksPerThread,
+                                                        options.probes, prefixes, forbidden);
+        return 0;
+    }
 
-    int numThreads = omp_get_max_threads();
+    int prefixDepth = options.prefixDepth;
 
     // Compute prefix depth if not specified
     if (prefixDepth <= 0) {
@@ -357,47 +725,203 @@ void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
         prefixDepth = 2;
     }
 
+    BitSet128 reversed_marks;
+    BitSet128 used_dist = forbidden;
+    reversed_marks.set(0);
+
+    generatePrefixesV5(reversed_marks, used_dist, 1, 0,
+                      prefixDepth, n, maxLen + 1, prefixes);
+    return prefixDepth;
+}
+
+// =============================================================================
+// MAIN SEARCH FUNCTION - VERSION 5
+// =============================================================================
+void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
+{
+    SearchOptionsV5 options;
+    options.prefixDepth = prefixDepth;
+    searchGolombV5(n, maxLen, best, options);
+}
+
+void searchGolombV5(int n, int maxLen, GolombRuler& best, const SearchOptionsV5& options)
+{
+    searchGolombV5(n, maxLen, best, options, searchStatsV5);
+    exploredCountV5.store(searchStatsV5.explored, std::memory_order_relaxed);
+}
+
+// Parallel phase shared by searchGolombV5 and searchPrefixStubsV5
+static void explorePrefixesV5(int n, int maxLen, std::vector<WorkItemV5>& prefixes,
+                              const SearchOptionsV5& options, const BitSet128& forbidden,
+                              double startTime, GolombRuler& best, SearchStatsV5& stats);
+
+void searchGolombV5(int n, int maxLen, GolombRuler& best, const SearchOptionsV5& options,
+                    SearchStatsV5& stats)
+{
+    // Check max length constraint
+    if (maxLen > MAX_LEN_V5) {
+        maxLen = MAX_LEN_V5;
+    }
+
+    stats = SearchStatsV5{};
+    const double startTime = omp_get_wtime();
+
+    const BitSet128 forbidden = forbiddenMaskV5(options.forbiddenDistances);
+
     // ==========================================================================
     // PHASE 1: Generate all valid prefixes (sequential)
     // ==========================================================================
     std::vector<WorkItemV5> prefixes;
     prefixes.reserve(100000);
+    stats.prefixDepth = buildPrefixesV5(n, maxLen, options, forbidden, omp_get_max_threads(), prefixes);
 
-    {
-        BitSet128 reversed_marks;
-        BitSet128 used_dist;
-        reversed_marks.set(0);
+    explorePrefixesV5(n, maxLen, prefixes, options, forbidden, startTime, best, stats);
+}
+
+static void explorePrefixesV5(int n, int maxLen, std::vector<WorkItemV5>& prefixes,
+                              const SearchOptionsV5& options, const BitSet128& forbidden,
+                              double startTime, GolombRuler& best, SearchStatsV5& stats)
+{
+    std::atomic<long long> explored(0);
+    BoundLogV5 boundLog{stats, startTime};
+
+    SharedBound globalBound(maxLen + 1, options.boundPolicy);
+
+    // Deterministic mode: a virtual ruler of length maxLen after every prefix
+    const bool deterministic = options.deterministic;
+    std::atomic<uint64_t> globalBestKey(boundKeyV5(maxLen, UINT32_MAX));
+    long long thresholdCounts[THRESHOLD_SLOTS_V5] = {0};
+
+    // Audit digests: per-threshold slots until the final length is known
+    const bool recordDigests = deterministic && options.recordDigests;
+    std::vector<std::vector<DigestSlotV5>> digestSlots(recordDigests ? prefixes.size() : 0);
+    std::vector<int> digestThreads(recordDigests ? prefixes.size() : 0, -1);
 
-        generatePrefixesV5(reversed_marks, used_dist, 1, 0,
-                          prefixDepth, n, maxLen + 1, prefixes);
+    int finalBestLen = maxLen + 1;
+    int finalBestMarks[MAX_MARKS_V5] = {0};
+    int finalBestNumMarks = 0;
+    uint64_t finalBestKey = UINT64_MAX;
+
+    const int numThreads = omp_get_max_threads();
+
+    stats.prefixCount = static_cast<int>(prefixes.size());
+    if (!prefixes.empty()) {
+        stats.minPrefixDepth = n;
+        for (const WorkItemV5& item : prefixes) {
+            stats.minPrefixDepth = std::min(stats.minPrefixDepth, item.marks_count);
+            stats.maxPrefixDepth = std::max(stats.maxPrefixDepth, item.marks_count);
+        }
+    }
+
+    // Best-first dispatch: stable sort keeps DFS order among equal keys. The
+    // prefixes themselves stay in generation order (deterministic tie-break).
+    const int numPrefixes = static_cast<int>(prefixes.size());
+    std::vector<int> dispatchOrder(static_cast<size_t>(numPrefixes));
+    for (int i = 0; i < numPrefixes; ++i) {
+        dispatchOrder[static_cast<size_t>(i)] = i;
+    }
+    if (options.prefixOrder != PrefixOrderV5::Generation) {
+        auto key = [&](int i) {
+            const WorkItemV5& item = prefixes[static_cast<size_t>(i)];
+            if (options.prefixOrder == PrefixOrderV5::Length) {
+                return item.ruler_length;
+            }
+            // Largest slack first == smallest lower bound on the final length
+            const int r = n - item.marks_count;
+            return item.ruler_length + (r * (r + 1)) / 2;
+        };
+        std::stable_sort(dispatchOrder.begin(), dispatchOrder.end(),
+                         [&](int a, int b) { return key(a) < key(b); });
     }
 
     // ==========================================================================
     // PHASE 2: Parallel exploration of prefixes
     // ==========================================================================
-    #pragma omp parallel shared(globalBestLen, finalBestLen, finalBestMarks, finalBestNumMarks)
+    // Never dedicate every thread to the heuristic: at least one stays exact
+    const int heuristicThreads = deterministic ? 0 : std::min(options.heuristicThreads, numThreads - 1);
+    std::atomic<int> nextPrefix(0);
+
+    // Each prefix is explored by exactly one thread: its slot needs no lock
+    if (options.recordPrefixCosts) {
+        stats.prefixCosts.assign(static_cast<size_t>(numPrefixes), PrefixCost{});
+    }
+
+    #pragma omp parallel shared(globalBound, globalBestKey, thresholdCounts, finalBestLen, finalBestMarks, finalBestNumMarks, finalBestKey, nextPrefix, explored)
     {
         ThreadBestV5 threadBest{};
         threadBest.bestLen = maxLen + 1;
         threadBest.bestNumMarks = 0;
+        threadBest.bestKey = UINT64_MAX;
         long long threadExplored = 0;
+        long long threadThresholds[THRESHOLD_SLOTS_V5] = {0};
+        long long prefixCounts[THRESHOLD_SLOTS_V5] = {0};
+        uint64_t prefixHashes[THRESHOLD_SLOTS_V5] = {0};
 
-        // Pre-allocated stack
+        // Pre-allocated stacks
         alignas(64) StackFrameV5 stack[MAX_MARKS_V5];
+        alignas(64) StackFrameOrderedV5 orderedStack[MAX_MARKS_V5];
+        const bool ordered = !deterministic &&
+                             (options.candidateOrder == CandidateOrderV5::FreeSmallDistances);
 
-        const int numPrefixes = static_cast<int>(prefixes.size());
+        // Bound readers (one per policy, only the selected one is used)
+        AtomicBoundReader atomicBound(globalBound);
+        CachedBoundReader cachedBound(globalBound, options.boundRefresh);
+        EpochBoundReader epochBound(globalBound);
+        NumaBoundReader numaBound(globalBound);
 
-        #pragma omp for schedule(dynamic, 1)
-        for (int i = 0; i < numPrefixes; ++i) {
+        auto explorePrefixOnce = [&](int i) {
             const WorkItemV5& prefix = prefixes[static_cast<size_t>(i)];
 
+            if (deterministic) {
+                // No early pruning here: the kernel counts the root itself
+                StackFrameV5& frame0 = stack[0];
+                frame0.reversed_marks = prefix.reversed_marks;
+                frame0.used_dist = prefix.used_dist;
+                frame0.marks_count = prefix.marks_count;
+                frame0.ruler_length = prefix.ruler_length;
+                frame0.next_candidate = 0;
+                frame0.threshold = prefixThresholdV5(prefix.reversed_marks, prefix.ruler_length, n);
+
+                if (!recordDigests) {
+                    backtrackDeterministicV5<false>(threadBest, n, globalBestKey, static_cast<uint32_t>(i),
+                                                    threadExplored, threadThresholds, nullptr, stack, boundLog);
+                    return;
+                }
+
+                backtrackDeterministicV5<true>(threadBest, n, globalBestKey, static_cast<uint32_t>(i),
+                                               threadExplored, prefixCounts, prefixHashes, stack, boundLog);
+
+                std::vector<DigestSlotV5>& slots = digestSlots[static_cast<size_t>(i)];
+                for (int t = 0; t < THRESHOLD_SLOTS_V5; ++t) {
+                    if (prefixCounts[t] == 0) continue;
+                    threadThresholds[t] += prefixCounts[t];
+                    slots.push_back(DigestSlotV5{t, prefixCounts[t], prefixHashes[t]});
+                    prefixCounts[t] = 0;
+                    prefixHashes[t] = 0;
+                }
+                digestThreads[static_cast<size_t>(i)] = omp_get_thread_num();
+                return;
+            }
+
             // Early pruning
-            const int currentGlobal = globalBestLen.load(std::memory_order_acquire);
+            const int currentGlobal = globalBound.load();
             const int remaining = n - prefix.marks_count;
             const int minAdditional = (remaining * (remaining + 1)) / 2;
 
             if (prefix.ruler_length + minAdditional >= currentGlobal) {
-                continue;
+                return;
+            }
+
+            if (ordered) {
+                StackFrameOrderedV5& frame0 = orderedStack[0];
+                frame0.reversed_marks = prefix.reversed_marks;
+                frame0.used_dist = prefix.used_dist;
+                frame0.marks_count = prefix.marks_count;
+                frame0.ruler_length = prefix.ruler_length;
+                frame0.num_candidates = -1;
+
+                backtrackOrderedV5(threadBest, n, globalBound, threadExplored, orderedStack, boundLog);
+                return;
             }
 
             // Setup initial stack frame
@@ -409,16 +933,96 @@ void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
             frame0.next_candidate = 0;
 
             // Run iterative backtracking
-            backtrackIterativeV5(threadBest, n, globalBestLen, threadExplored, stack);
+            switch (options.boundPolicy) {
+                case BoundPolicy::Atomic:
+                    backtrackIterativeV5(threadBest, n, globalBound, atomicBound, threadExplored, stack, boundLog,
+                                         options.patternDb);
+                    break;
+                case BoundPolicy::Cached:
+                    cachedBound.begin();
+                    backtrackIterativeV5(threadBest, n, globalBound, cachedBound, threadExplored, stack, boundLog,
+                                         options.patternDb);
+                    break;
+                case BoundPolicy::Epoch: {
+                    const long long nodesBefore = threadExplored;
+                    backtrackIterativeV5(threadBest, n, globalBound, epochBound, threadExplored, stack, boundLog,
+                                         options.patternDb);
+                    epochBound.countChecks(threadExplored - nodesBefore);
+                    break;
+                }
+                case BoundPolicy::NumaReplica:
+                    backtrackIterativeV5(threadBest, n, globalBound, numaBound, threadExplored, stack, boundLog,
+                                         options.patternDb);
+                    break;
+            }
+        };
+
+        auto explorePrefix = [&](int slot) {
+            const int i = dispatchOrder[static_cast<size_t>(slot)];
+            if (!options.recordPrefixCosts) {
+                explorePrefixOnce(i);
+                return;
+            }
+
+            const long long nodesBefore = threadExplored;
+            const double t0 = omp_get_wtime();
+            explorePrefixOnce(i);
+
+            const WorkItemV5& prefix = prefixes[static_cast<size_t>(i)];
+            PrefixCost& cost = stats.prefixCosts[static_cast<size_t>(i)];
+            cost.index = i;
+            cost.depth = prefix.marks_count;
+            cost.ruler_length = prefix.ruler_length;
+            cost.nodes = threadExplored - nodesBefore;
+            cost.time = omp_get_wtime() - t0;
+        };
+
+        if (heuristicThreads > 0) {
+            // Portfolio: the first heuristicThreads threads build rulers
+            // greedily until they stall, then join the shared prefix queue.
+            const int tid = omp_get_thread_num();
+            if (tid < heuristicThreads) {
+                greedyPortfolioV5(threadBest, n, globalBound, nextPrefix, numPrefixes,
+                                  options.heuristicStallLimit,
+                                  0x9E3779B97F4A7C15ULL * static_cast<uint64_t>(tid + 1),
+                                  forbidden, boundLog);
+            }
+            for (int i = nextPrefix.fetch_add(1, std::memory_order_relaxed); i < numPrefixes;
+                 i = nextPrefix.fetch_add(1, std::memory_order_relaxed)) {
+                explorePrefix(i);
+            }
+        } else {
+            #pragma omp for schedule(dynamic, 1)
+            for (int i = 0; i < numPrefixes; ++i) {
+                explorePrefix(i);
+            }
         }
 
-        exploredCountV5.fetch_add(threadExplored, std::memory_order_relaxed);
+        explored.fetch_add(threadExplored, std::memory_order_relaxed);
+
+        #pragma omp critical(merge_bound_stats_v5)
+        {
+            stats.boundPolicy.add(cachedBound.stats());
+            stats.boundPolicy.add(epochBound.stats());
+        }
+
+        if (deterministic) {
+            #pragma omp critical(merge_thresholds_v5)
+            {
+                for (int t = 0; t < THRESHOLD_SLOTS_V5; ++t) {
+                    thresholdCounts[t] += threadThresholds[t];
+                }
+            }
+        }
 
         // Merge results
         if (threadBest.bestNumMarks > 0) {
             #pragma omp critical(merge_best_v5)
             {
-                if (threadBest.bestLen < finalBestLen) {
+                const bool better = deterministic ? (threadBest.bestKey < finalBestKey)
+                                                  : (threadBest.bestLen < finalBestLen);
+                if (better) {
+                    finalBestKey = threadBest.bestKey;
                     finalBestLen = threadBest.bestLen;
                     finalBestNumMarks = threadBest.bestNumMarks;
                     for (int j = 0; j < threadBest.bestNumMarks; ++j) {
@@ -429,6 +1033,31 @@ void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
         }
     }
 
+    stats.explored = explored.load(std::memory_order_relaxed);
+
+    if (deterministic) {
+        // Nodes every run visits: threshold <= final length (or <= maxLen + 1)
+        const int finalLen = std::min(finalBestLen, maxLen + 1);
+        for (int t = 0; t <= finalLen && t < THRESHOLD_SLOTS_V5; ++t) {
+            stats.deterministicExplored += thresholdCounts[t];
+        }
+        stats.finalBoundKey = globalBestKey.load(std::memory_order_relaxed);
+
+        if (recordDigests) {
+            stats.digests.assign(prefixes.size(), PrefixDigest{});
+            for (size_t i = 0; i < prefixes.size(); ++i) {
+                PrefixDigest& digest = stats.digests[i];
+                digest.index = static_cast<int>(i);
+                digest.thread = digestThreads[i];
+                for (const DigestSlotV5& slot : digestSlots[i]) {
+                    if (slot.threshold > finalLen) continue;
+                    digest.nodes += slot.nodes;
+                    digest.hash += slot.hash;
+                }
+            }
+        }
+    }
+
     // Copy final result
     if (finalBestNumMarks > 0) {
         best.marks.assign(finalBestMarks, finalBestMarks + finalBestNumMarks);
@@ -438,7 +1067,330 @@ void searchGolombV5(int n, int maxLen, GolombRuler& best, int prefixDepth)
     best.computeLength();
 }
 
+// =============================================================================
+// PREFIX STUBS - Exported work units (file-based spool, external schedulers)
+// =============================================================================
+void generatePrefixStubsV5(int n, int maxLen, const SearchOptionsV5& options,
+                           std::vector<PrefixStubV5>& stubs)
+{
+    if (maxLen > MAX_LEN_V5) {
+        maxLen = MAX_LEN_V5;
+    }
+
+    std::vector<WorkItemV5> prefixes;
+    buildPrefixesV5(n, maxLen, options, forbiddenMaskV5(options.forbiddenDistances),
+                    omp_get_max_threads(), prefixes);
+
+    stubs.clear();
+    stubs.reserve(prefixes.size());
+    for (const WorkItemV5& item : prefixes) {
+        PrefixStubV5 stub;
+        stub.marks_lo = item.reversed_marks.lo();
+        stub.marks_hi = item.reversed_marks.hi();
+        stub.dist_lo = item.used_dist.lo();
+        stub.dist_hi = item.used_dist.hi();
+        stub.marks_count = item.marks_count;
+        stub.ruler_length = item.ruler_length;
+        stubs.push_back(stub);
+    }
+}
+
+void searchPrefixStubsV5(int n, int maxLen, const std::vector<PrefixStubV5>& stubs,
+                         const SearchOptionsV5& options, GolombRuler& best, SearchStatsV5& stats)
+{
+    if (maxLen > MAX_LEN_V5) {
+        maxLen = MAX_LEN_V5;
+    }
+
+    stats = SearchStatsV5{};
+    const double startTime = omp_get_wtime();
+
+    std::vector<WorkItemV5> prefixes;
+    prefixes.reserve(stubs.size());
+    for (const PrefixStubV5& stub : stubs) {
+        WorkItemV5 item;
+        item.reversed_marks = BitSet128(stub.marks_lo, stub.marks_hi);
+        item.used_dist = BitSet128(stub.dist_lo, stub.dist_hi);
+        item.marks_count = stub.marks_count;
+        item.ruler_length = stub.ruler_length;
+        prefixes.push_back(item);
+    }
+
+    explorePrefixesV5(n, maxLen, prefixes, options,
+                      forbiddenMaskV5(options.forbiddenDistances), startTime, best, stats);
+}
+
+// =============================================================================
+// BATCH SEARCH - Many independent instances on one scheduler
+// =============================================================================
+// Small instances have too few prefixes to keep a whole team busy when they
+// are run one after another. Here the prefixes of every instance go into one
+// pool tagged by instance, largest instances first so they do not end up in
+// the tail, and a single dynamic loop drains it. Each instance keeps its own
+// bound and result; a thread flushes its local best whenever the instance
+// of its next task changes.
+// =============================================================================
+struct BatchTaskV5 {
+    WorkItemV5 item;
+    int instance;
+};
+
+void searchGolombBatchV5(std::vector<BatchInstanceV5>& instances, const SearchOptionsV5& options)
+{
+    const int numInstances = static_cast<int>(instances.size());
+    const int numThreads = omp_get_max_threads();
+    const double start = omp_get_wtime();
+
+    std::vector<int> maxLens(static_cast<size_t>(numInstances));
+    std::unique_ptr<SharedBound[]> bounds(new SharedBound[static_cast<size_t>(numInstances)]);
+    std::unique_ptr<std::atomic<long long>[]> explored(
+        new std::atomic<long long>[static_cast<size_t>(numInstances)]);
+    std::vector<ThreadBestV5> results(static_cast<size_t>(numInstances));
+
+    // Instance order: largest n first, then input order
+    std::vector<int> order(static_cast<size_t>(numInstances));
+    for (int i = 0; i < numInstances; ++i) order[static_cast<size_t>(i)] = i;
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) {
+        return instances[static_cast<size_t>(a)].n > instances[static_cast<size_t>(b)].n;
+    });
+
+    std::vector<BatchTaskV5> tasks;
+    std::vector<WorkItemV5> prefixes;
+
+    for (int i : order) {
+        BatchInstanceV5& inst = instances[static_cast<size_t>(i)];
+        const size_t idx = static_cast<size_t>(i);
+
+        maxLens[idx] = std::min(inst.maxLen, MAX_LEN_V5);
+        bounds[idx].init(maxLens[idx] + 1, BoundPolicy::Atomic);
+        explored[idx].store(0, std::memory_order_relaxed);
+        results[idx].bestLen = maxLens[idx] + 1;
+        results[idx].bestNumMarks = 0;
+
+        inst.stats = SearchStatsV5{};
+
+        SearchOptionsV5 instOptions = options;
+        instOptions.forbiddenDistances = inst.forbiddenDistances;
+
+        prefixes.clear();
+        buildPrefixesV5(inst.n, maxLens[idx], instOptions,
+                        forbiddenMaskV5(inst.forbiddenDistances), numThreads, prefixes);
+
+        inst.stats.prefixCount = static_cast<int>(prefixes.size());
+        inst.stats.minPrefixDepth = prefixes.empty() ? 0 : inst.n;
+        for (const WorkItemV5& item : prefixes) {
+            inst.stats.minPrefixDepth = std::min(inst.stats.minPrefixDepth, item.marks_count);
+            inst.stats.maxPrefixDepth = std::max(inst.stats.maxPrefixDepth, item.marks_count);
+            tasks.push_back(BatchTaskV5{item, i});
+        }
+    }
+
+    const int numTasks = static_cast<int>(tasks.size());
+
+    #pragma omp parallel
+    {
+        ThreadBestV5 threadBest{};
+        threadBest.bestNumMarks = 0;
+        int currentInstance = -1;
+        long long threadExplored = 0;
+
+        alignas(64) StackFrameV5 stack[MAX_MARKS_V5];
+
+        auto flush = [&]() {
+            if (currentInstance < 0) return;
+            const size_t idx = static_cast<size_t>(currentInstance);
+            explored[idx].fetch_add(threadExplored, std::memory_order_relaxed);
+            if (threadBest.bestNumMarks > 0) {
+                #pragma omp critical(merge_best_batch_v5)
+                {
+                    if (threadBest.bestLen < results[idx].bestLen) {
+                        results[idx] = threadBest;
+                    }
+                }
+            }
+        };
+
+        #pragma omp for schedule(dynamic, 1)
+        for (int t = 0; t < numTasks; ++t) {
+            const BatchTaskV5& task = tasks[static_cast<size_t>(t)];
+            const size_t idx = static_cast<size_t>(task.instance);
+
+            if (task.instance != currentInstance) {
+                flush();
+                currentInstance = task.instance;
+                threadBest.bestLen = maxLens[idx] + 1;
+                threadBest.bestNumMarks = 0;
+                threadExplored = 0;
+            }
+
+            const int n = instances[idx].n;
+            const WorkItemV5& prefix = task.item;
+            const int remaining = n - prefix.marks_count;
+            const int minAdditional = (remaining * (remaining + 1)) / 2;
+
+            if (prefix.ruler_length + minAdditional >= bounds[idx].load()) {
+                continue;
+            }
+
+            StackFrameV5& frame0 = stack[0];
+            frame0.reversed_marks = prefix.reversed_marks;
+            frame0.used_dist = prefix.used_dist;
+            frame0.marks_count = prefix.marks_count;
+            frame0.ruler_length = prefix.ruler_length;
+            frame0.next_candidate = 0;
+
+            BoundLogV5 boundLog{instances[idx].stats, start};
+            AtomicBoundReader bound(bounds[idx]);
+            backtrackIterativeV5(threadBest, n, bounds[idx], bound, threadExplored, stack, boundLog,
+                                 options.patternDb);
+        }
+
+        flush();
+    }
+
+    for (int i = 0; i < numInstances; ++i) {
+        const size_t idx = static_cast<size_t>(i);
+        BatchInstanceV5& inst = instances[idx];
+        inst.stats.explored = explored[idx].load(std::memory_order_relaxed);
+
+        if (results[idx].bestNumMarks > 0) {
+            inst.best.marks.assign(results[idx].bestMarks,
+                                   results[idx].bestMarks + results[idx].bestNumMarks);
+        } else {
+            inst.best.marks.clear();
+        }
+        inst.best.computeLength();
+    }
+}
+
+// =============================================================================
+// AUDIT - Sampled re-execution of a recorded deterministic run
+// =============================================================================
+// Prefix i is kept when splitmix64(seed, i) < fraction: the sample depends on
+// the seed only, so another node can audit the same prefixes. Each sampled
+// prefix goes to thread (recording thread + 1) mod T. The bound key is fixed
+// at the recorded final key: every node with threshold <= the final length is
+// visited again, so the digests must match exactly.
+// =============================================================================
+void auditPrefixesV5(int n, int maxLen, const SearchOptionsV5& options,
+                     const std::vector<PrefixDigest>& digests, uint64_t finalBoundKey,
+                     double fraction, uint64_t seed, AuditReportV5& report)
+{
+    if (maxLen > MAX_LEN_V5) {
+        maxLen = MAX_LEN_V5;
+    }
+
+    report = AuditReportV5{};
+    const double startTime = omp_get_wtime();
+
+    SearchOptionsV5 detOptions = options;
+    detOptions.deterministic = true;
+
+    std::vector<WorkItemV5> prefixes;
+    buildPrefixesV5(n, maxLen, detOptions, forbiddenMaskV5(options.forbiddenDistances),
+                    omp_get_max_threads(), prefixes);
+
+    report.prefixes = static_cast<int>(prefixes.size());
+    for (const PrefixDigest& digest : digests) {
+        report.recordedNodes += digest.nodes;
+    }
+    if (prefixes.size() != digests.size() || prefixes.empty()) {
+        // Different prefix set: options do not match the recorded run
+        report.mismatches = -1;
+        return;
+    }
+
+    std::vector<int> sample;
+    for (int i = 0; i < report.prefixes; ++i) {
+        uint64_t state = seed ^ (static_cast<uint64_t>(i) * 0xD1B54A32D192ED03ULL);
+        const double u = static_cast<double>(prefix_split::splitmix64(state) >> 11) * 0x1.0p-53;
+        if (u < fraction) {
+            sample.push_back(i);
+        }
+    }
+    if (sample.empty() && fraction > 0.0) {
+        sample.push_back(static_cast<int>(seed % static_cast<uint64_t>(report.prefixes)));
+    }
+    report.sampled = static_cast<int>(sample.size());
+
+    const int finalLen = finalLengthV5(finalBoundKey);
+    const int numThreads = omp_get_max_threads();
+    std::atomic<uint64_t> boundKey(finalBoundKey);
+    std::vector<PrefixDigest> results(sample.size());
+    long long reexecuted = 0;
+    int sameThread = 0;
+
+    #pragma omp parallel reduction(+:reexecuted, sameThread)
+    {
+        const int tid = omp_get_thread_num();
+
+        ThreadBestV5 threadBest{};
+        threadBest.bestLen = maxLen + 1;
+        threadBest.bestNumMarks = 0;
+        threadBest.bestKey = UINT64_MAX;
+        long long threadExplored = 0;
+        long long prefixCounts[THRESHOLD_SLOTS_V5] = {0};
+        uint64_t prefixHashes[THRESHOLD_SLOTS_V5] = {0};
+        alignas(64) StackFrameV5 stack[MAX_MARKS_V5];
+
+        SearchStatsV5 scratch;
+        BoundLogV5 boundLog{scratch, startTime};
+
+        for (size_t j = 0; j < sample.size(); ++j) {
+            const int i = sample[j];
+            const PrefixDigest& recorded = digests[static_cast<size_t>(i)];
+            const int target = ((recorded.thread >= 0 ? recorded.thread + 1 : static_cast<int>(j))) % numThreads;
+            if (target != tid) continue;
+
+            const WorkItemV5& prefix = prefixes[static_cast<size_t>(i)];
+            StackFrameV5& frame0 = stack[0];
+            frame0.reversed_marks = prefix.reversed_marks;
+            frame0.used_dist = prefix.used_dist;
+            frame0.marks_count = prefix.marks_count;
+            frame0.ruler_length = prefix.ruler_length;
+            frame0.next_candidate = 0;
+            frame0.threshold = prefixThresholdV5(prefix.reversed_marks, prefix.ruler_length, n);
+
+            backtrackDeterministicV5<true>(threadBest, n, boundKey, static_cast<uint32_t>(i),
+                                           threadExplored, prefixCounts, prefixHashes, stack, boundLog);
+
+            PrefixDigest& digest = results[j];
+            digest.index = i;
+            digest.thread = tid;
+            for (int t = 0; t < THRESHOLD_SLOTS_V5; ++t) {
+                if (t <= finalLen) {
+                    digest.nodes += prefixCounts[t];
+                    digest.hash += prefixHashes[t];
+                }
+                prefixCounts[t] = 0;
+                prefixHashes[t] = 0;
+            }
+            reexecuted += digest.nodes;
+            if (tid == recorded.thread) sameThread++;
+        }
+    }
+
+    report.reexecutedNodes = reexecuted;
+    report.sameThread = sameThread;
+    report.betterRulerFound = boundKey.load(std::memory_order_relaxed) < finalBoundKey;
+
+    for (size_t j = 0; j < sample.size(); ++j) {
+        const PrefixDigest& recorded = digests[static_cast<size_t>(sample[j])];
+        if (results[j].nodes != recorded.nodes || results[j].hash != recorded.hash) {
+            report.mismatches++;
+            report.expected.push_back(recorded);
+            report.actual.push_back(results[j]);
+        }
+    }
+    report.time = omp_get_wtime() - startTime;
+}
+
 long long getExploredCountV5()
 {
     return exploredCountV5.load(std::memory_order_relaxed);
 }
+
+const SearchStatsV5& getSearchStatsV5()
+{
+    return searchStatsV5;
+}
@@ -0,0 +1,422 @@
+#include "search_wide.hpp"
+#include "simd_bitset.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+// =============================================================================
+// WIDE SEARCH - Recursive, one template instance per word count W
+// =============================================================================
+// State shared by all levels:
+//   marks_[0..count)   : the ruler so far (both modes, gives the solution)
+//   used_              : distance set of the list levels, set / cleared in
+//                        place (the new distances of a mark are all distinct)
+// Shift levels (count >= k*), WideState::Copy: a frame { reversed_marks,
+// used_dist } per level, built from the parent frame (shift + OR) or, at the
+// switch depth, from marks_. WideState::InPlace: fixedMarks_ (bit BITS-1-a_i,
+// built at the switch depth) and used_ itself, changed by wideMake /
+// wideUnmake; the undo record of level k is marks_[k].
+//
+// Pruning and symmetry as in Sequential V4: len + r(r+1)/2 < bound, last
+// candidate bound - r(r-1)/2 - 1, a_1 < a_{n-1} - a_{n-2} on solutions.
+// =============================================================================
+
+const char* wideCheckName(WideCheck check) {
+    switch (check) {
+        case WideCheck::Auto: return "auto";
+        case WideCheck::Shift: return "shift";
+        case WideCheck::List: return "list";
+    }
+    return "auto";
+}
+
+bool parseWideCheck(const char* name, WideCheck& check) {
+    if (std::strcmp(name, "auto") == 0) check = WideCheck::Auto;
+    else if (std::strcmp(name, "shift") == 0) check = WideCheck::Shift;
+    else if (std::strcmp(name, "list") == 0) check = WideCheck::List;
+    else return false;
+    return true;
+}
+
+const char* wideStateName(WideState state) {
+    return state == WideState::Copy ? "copy" : "inplace";
+}
+
+bool parseWideState(const char* name, WideState& state) {
+    if (std::strcmp(name, "copy") == 0) state = WideState::Copy;
+    else if (std::strcmp(name, "inplace") == 0) state = WideState::InPlace;
+    else return false;
+    return true;
+}
+
+int wideWords(int maxLen) {
+    int words = 2;
+    while (words * 64 <= maxLen) words *= 2;
+    return words;
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+template <int W, bool Pilot>
+class WideSearch {
+private:
+    using Bits = simd_bits::WideBitSet<W>;
+
+    struct Frame {
+        Bits rev;   // bit j: mark at ruler_length - j
+        Bits used;  // distances
+    };
+
+    const int n_;
+    const WideOptions& options_;
+    WideStats& stats_;
+    const int switchMarks_;
+    const bool inPlace_;
+
+    int bound_;        // Exclusive
+    bool stop_ = false;
+    int marks_[MAX_MARKS_WIDE];
+    int bestMarks_[MAX_MARKS_WIDE];
+    int bestCount_ = 0;
+    Bits used_;
+    Bits fixedMarks_;  // InPlace shift levels: bit BITS - 1 - a_i
+    Bits forbidden_;
+    Frame frames_[MAX_MARKS_WIDE + 1];
+
+    // Pilot: per-depth time excluding children, and candidate checks
+    double childNs_[MAX_MARKS_WIDE + 1] = {};
+    long long childChecks_[MAX_MARKS_WIDE + 1] = {};
+    double depthNs_[MAX_MARKS_WIDE + 1] = {};
+    long long depthChecks_[MAX_MARKS_WIDE + 1] = {};
+
+    bool countNode() {
+        stats_.nodes++;
+        if (options_.nodeLimit > 0 && stats_.nodes >= options_.nodeLimit) [[unlikely]] {
+            stats_.limitReached = true;
+            stop_ = true;
+        }
+        return !stop_;
+    }
+
+    // Last mark pos completes the ruler: keep it if not the mirror of one kept
+    void solution(int pos, int count) {
+        if (marks_[1] >= pos - marks_[count - 1]) return;
+        if (pos >= bound_) return;
+        bound_ = pos;
+        std::memcpy(bestMarks_, marks_, sizeof(int) * static_cast<size_t>(count));
+        bestMarks_[count] = pos;
+        bestCount_ = count + 1;
+        if (options_.firstSolution) stop_ = true;
+    }
+
+    // First shift level: marks from the list (and used_dist, Copy)
+    void buildFrame(int count) {
+        if (inPlace_) {
+            fixedMarks_.reset();
+            for (int i = 0; i < count; ++i) {
+                fixedMarks_.set(Bits::BITS - 1 - marks_[i]);
+            }
+            return;
+        }
+        Frame& f = frames_[count];
+        const int len = marks_[count - 1];
+        f.rev.reset();
+        for (int i = 0; i < count; ++i) {
+            f.rev.set(len - marks_[i]);
+        }
+        f.used = used_;
+    }
+
+    void node(int count) {
+        if (!countNode()) return;
+
+        const int len = marks_[count - 1];
+        const int r = n_ - count;
+        if (len + (r * (r + 1)) / 2 >= bound_) return;
+
+        if constexpr (Pilot) {
+            const long long before = stats_.listChecks + stats_.shiftChecks;
+            childNs_[count] = 0.0;
+            childChecks_[count] = 0;
+            const auto start = Clock::now();
+            expand(count);
+            const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+            const long long checks = stats_.listChecks + stats_.shiftChecks - before;
+            depthNs_[count] += ns - childNs_[count];
+            depthChecks_[count] += checks - childChecks_[count];
+            childNs_[count - 1] += ns;
+            childChecks_[count - 1] += checks;
+        } else {
+            expand(count);
+        }
+    }
+
+    inline void expand(int count) {
+        if (count >= switchMarks_) {
+            if (inPlace_) {
+                expandShiftInPlace(count);
+            } else {
+                expandShift(count);
+            }
+        } else {
+            expandList(count);
+        }
+    }
+
+    void expandList(int count) {
+        const int len = marks_[count - 1];
+        const int r = n_ - count;
+        const int tail = ((r - 1) * r) / 2;
+
+        for (int pos = len + 1; pos < bound_ - tail && !stop_; ++pos) {
+            if (count == 1 && 2 * pos >= bound_) break;  // a_1 < bound / 2
+
+            stats_.listChecks++;
+            if (used_.anyAtDistances(pos, marks_, count)) [[likely]] continue;
+
+            if (count + 1 == n_) {
+                solution(pos, count);
+                continue;
+            }
+
+            for (int i = 0; i < count; ++i) used_.set(pos - marks_[i]);
+            marks_[count] = pos;
+            if (count + 1 == switchMarks_) buildFrame(count + 1);
+
+            node(count + 1);
+
+            for (int i = 0; i < count; ++i) used_.clear(pos - marks_[i]);
+        }
+    }
+
+    void expandShift(int count) {
+        const Frame& f = frames_[count];
+        Frame& child = frames_[count + 1];
+        const int len = marks_[count - 1];
+        const int r = n_ - count;
+        const int tail = ((r - 1) * r) / 2;
+
+        for (int pos = len + 1; pos < bound_ - tail && !stop_; ++pos) {
+            if (count == 1 && 2 * pos >= bound_) break;
+
+            stats_.shiftChecks++;
+            const int offset = pos - len;
+            if (f.rev.shiftedIntersects(offset, f.used, (pos >> 6) + 1)) [[likely]] continue;
+
+            if (count + 1 == n_) {
+                marks_[count] = pos;
+                solution(pos, count);
+                continue;
+            }
+
+            f.rev.shiftLeftInto(offset, child.rev);  // New distances
+            child.used = f.used;
+            child.used.orWith(child.rev);
+            child.rev.set(0);
+            marks_[count] = pos;
+
+            node(count + 1);
+        }
+    }
+
+    void expandShiftInPlace(int count) {
+        const int len = marks_[count - 1];
+        const int r = n_ - count;
+        const int tail = ((r - 1) * r) / 2;
+
+        for (int pos = len + 1; pos < bound_ - tail && !stop_; ++pos) {
+            if (count == 1 && 2 * pos >= bound_) break;
+
+            stats_.shiftChecks++;
+            const int words = (pos >> 6) + 1;
+            if (fixedMarks_.shiftedRightIntersects(Bits::BITS - 1 - pos, used_, words)) [[likely]] {
+                continue;
+            }
+
+            marks_[count] = pos;
+            if (count + 1 == n_) {
+                solution(pos, count);
+                continue;
+            }
+
+            simd_bits::wideMake(fixedMarks_, used_, pos, words);
+            node(count + 1);
+            simd_bits::wideUnmake(fixedMarks_, used_, pos, words);
+        }
+    }
+
+public:
+    WideSearch(int n, int maxLen, const WideOptions& options, WideStats& stats, int switchMarks)
+        : n_(n), options_(options), stats_(stats), switchMarks_(switchMarks),
+          inPlace_(options.state == WideState::InPlace), bound_(maxLen + 1) {
+        for (int d : options.forbidden) {
+            if (d > 0 && d <= maxLen) forbidden_.set(d);
+        }
+    }
+
+    void run() {
+        // Forbidden distances start in the used set: never placed, never cleared
+        used_ = forbidden_;
+        marks_[0] = 0;
+        if (switchMarks_ <= 1) buildFrame(1);
+        node(1);
+        stats_.complete = !stop_;
+    }
+
+    // Pilot: ns per check at each depth (0 where no check was made)
+    std::vector<double> depthCost() const {
+        std::vector<double> cost(static_cast<size_t>(n_) + 1, 0.0);
+        for (int k = 1; k < n_; ++k) {
+            if (depthChecks_[k] > 0) {
+                cost[static_cast<size_t>(k)] = std::max(0.0, depthNs_[k] / depthChecks_[k]);
+            }
+        }
+        return cost;
+    }
+
+    std::vector<long long> depthChecks() const {
+        return std::vector<long long>(depthChecks_, depthChecks_ + n_ + 1);
+    }
+
+    bool result(GolombRuler& best) const {
+        if (bestCount_ == 0) {
+            best.marks.clear();
+            best.computeLength();
+            return false;
+        }
+        best.marks.assign(bestMarks_, bestMarks_ + bestCount_);
+        best.computeLength();
+        return true;
+    }
+};
+
+// =============================================================================
+// COST MODEL - pilot runs (see search_wide.hpp)
+// =============================================================================
+template <int W>
+WideCostModel calibrate(int n, int maxLen, const WideOptions& options) {
+    const auto start = Clock::now();
+
+    WideOptions pilotOptions = options;
+    pilotOptions.nodeLimit = options.pilotNodes;
+
+    WideStats listStats, shiftStats;
+    auto listPilot = std::make_unique<WideSearch<W, true>>(n, maxLen, pilotOptions, listStats,
+                                                          MAX_MARKS_WIDE + 1);
+    listPilot->run();
+    auto shiftPilot = std::make_unique<WideSearch<W, true>>(n, maxLen, pilotOptions, shiftStats, 1);
+    shiftPilot->run();
+
+    WideCostModel model;
+    model.words = W;
+    model.pilotNodes = pilotOptions.nodeLimit;
+    model.listNs = listPilot->depthCost();
+    model.shiftNs = shiftPilot->depthCost();
+
+    // Same nodes in both pilots: checks per depth are equal, compare totals
+    model.checks = listPilot->depthChecks();
+    const std::vector<long long>& checks = model.checks;
+    double bestCost = 0.0;
+    for (int k = 1; k < n; ++k) {
+        bestCost += checks[static_cast<size_t>(k)] * model.listNs[static_cast<size_t>(k)];
+    }
+    model.switchMarks = MAX_MARKS_WIDE + 1;
+    double suffixShift = 0.0;
+    double prefixList = bestCost;
+    for (int k = n - 1; k >= 1; --k) {
+        const double c = static_cast<double>(checks[static_cast<size_t>(k)]);
+        suffixShift += c * model.shiftNs[static_cast<size_t>(k)];
+        prefixList -= c * model.listNs[static_cast<size_t>(k)];
+        if (prefixList + suffixShift < bestCost) {
+            bestCost = prefixList + suffixShift;
+            model.switchMarks = k;
+        }
+    }
+
+    model.calibrationTime = std::chrono::duration<double>(Clock::now() - start).count();
+    return model;
+}
+
+template <int W>
+void runWide(int n, int maxLen, const WideOptions& options, GolombRuler& best, WideStats& stats,
+             bool& found) {
+    int switchMarks = MAX_MARKS_WIDE + 1;
+    if (options.check == WideCheck::Shift) {
+        switchMarks = 1;
+    } else if (options.check == WideCheck::Auto) {
+        if (options.switchMarks > 0) {
+            switchMarks = options.switchMarks;
+        } else {
+            const WideCostModel model = calibrate<W>(n, maxLen, options);
+            switchMarks = model.switchMarks;
+            stats.model = model;
+        }
+    }
+    stats.model.words = W;
+    stats.switchMarks = switchMarks;
+
+    auto search = std::make_unique<WideSearch<W, false>>(n, maxLen, options, stats, switchMarks);
+    search->run();
+    found = search->result(best);
+}
+
+} // namespace
+
+WideCostModel calibrateWideCostModel(int n, int maxLen, const WideOptions& options) {
+    maxLen = std::min(maxLen, MAX_LEN_WIDE);
+    if (n <= 2 || n > MAX_MARKS_WIDE) return WideCostModel{};
+    switch (wideWords(maxLen)) {
+        case 2: return calibrate<2>(n, maxLen, options);
+        case 4: return calibrate<4>(n, maxLen, options);
+        case 8: return calibrate<8>(n, maxLen, options);
+        case 16: return calibrate<16>(n, maxLen, options);
+        case 32: return calibrate<32>(n, maxLen, options);
+        default: return calibrate<64>(n, maxLen, options);
+    }
+}
+
+bool searchGolombWide(int n, int maxLen, const WideOptions& options,
+                      GolombRuler& best, WideStats& stats) {
+    stats = WideStats{};
+    maxLen = std::min(maxLen, MAX_LEN_WIDE);
+
+    if (n <= 2 || n > MAX_MARKS_WIDE) {
+        best.marks.clear();
+        if (n == 1) best.marks = {0};
+        if (n == 2 && maxLen >= 1) best.marks = {0, 1};
+        best.computeLength();
+        stats.complete = true;
+        return !best.marks.empty();
+    }
+
+    bool found = false;
+    switch (wideWords(maxLen)) {
+        case 2: runWide<2>(n, maxLen, options, best, stats, found); break;
+        case 4: runWide<4>(n, maxLen, options, best, stats, found); break;
+        case 8: runWide<8>(n, maxLen, options, best, stats, found); break;
+        case 16: runWide<16>(n, maxLen, options, best, stats, found); break;
+        case 32: runWide<32>(n, maxLen, options, best, stats, found); break;
+        default: runWide<64>(n, maxLen, options, best, stats, found); break;
+    }
+    return found;
+}
+
+bool isValidWideRuler(const std::vector<int>& marks, const std::vector<int>& forbidden) {
+    if (marks.empty()) return false;
+    std::vector<char> seen(static_cast<size_t>(marks.back()) + 1, 0);
+    for (int d : forbidden) {
+        if (d > 0 && d < static_cast<int>(seen.size())) seen[static_cast<size_t>(d)] = 1;
+    }
+    for (size_t i = 0; i < marks.size(); ++i) {
+        for (size_t j = i + 1; j < marks.size(); ++j) {
+            const int d = marks[j] - marks[i];
+            if (d <= 0 || d >= static_cast<int>(seen.size()) || seen[static_cast<size_t>(d)]) return false;
+            seen[static_cast<size_t>(d)] = 1;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,542 @@
+#include "spool_v5.hpp"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <csignal>
+#include <unistd.h>
+#include <omp.h>
+
+namespace fs = std::filesystem;
+
+// =============================================================================
+// ON-DISK FORMAT
+// =============================================================================
+static const char SPOOL_MAGIC_V5[8] = {'G', 'O', 'L', 'S', 'P', 'L', '5', '\0'};
+
+struct SpoolUnitHeaderV5 {
+    char magic[8];
+    uint32_t unitId;
+    int32_t n;
+    int32_t bound;   // Inclusive bound when the unit was written
+    int32_t count;   // Number of PrefixStubV5 records that follow
+};
+
+struct SpoolConfigV5 {
+    int n = 0;
+    int bound = 0;
+    int units = 0;
+    int prefixes = 0;
+    int unitSize = 0;
+};
+
+struct SpoolResultV5 {
+    int unit = -1;
+    std::string worker;
+    int bound = 0;
+    int length = -1;
+    long long nodes = 0;
+    double time = 0.0;
+    std::vector<int> marks;
+};
+
+// =============================================================================
+// HELPERS
+// =============================================================================
+static std::string unitNameV5(int id)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "unit_%06d", id);
+    return name;
+}
+
+static std::string hostNameV5()
+{
+    char host[256] = {0};
+    if (gethostname(host, sizeof(host) - 1) != 0) {
+        std::strcpy(host, "unknown");
+    }
+    return host;
+}
+
+static std::string workerIdV5()
+{
+    return hostNameV5() + ":" + std::to_string(getpid());
+}
+
+// running/ names carry the owner: unit_N@host:pid.bin (legacy claims: unit_N.bin)
+static std::string claimedNameV5(const std::string& pendingName, const std::string& worker)
+{
+    return pendingName.substr(0, pendingName.size() - 4) + "@" + worker + ".bin";
+}
+
+static std::string unitBaseV5(const std::string& name)
+{
+    const size_t at = name.find('@');
+    return name.substr(0, at == std::string::npos ? name.size() - 4 : at);
+}
+
+static std::string claimOwnerV5(const std::string& name)
+{
+    const size_t at = name.find('@');
+    return at == std::string::npos ? "" : name.substr(at + 1, name.size() - 4 - at - 1);
+}
+
+// Only a worker on this host can be checked: its pid no longer exists
+static bool workerGoneV5(const std::string& owner)
+{
+    const size_t colon = owner.rfind(':');
+    if (colon == std::string::npos || owner.substr(0, colon) != hostNameV5()) return false;
+    const pid_t pid = static_cast<pid_t>(std::atol(owner.c_str() + colon + 1));
+    return pid > 0 && kill(pid, 0) != 0 && errno == ESRCH;
+}
+
+static bool touchV5(const fs::path& path)
+{
+    std::error_code ec;
+    fs::last_write_time(path, fs::file_time_type::clock::now(), ec);
+    return !ec;
+}
+
+// Lease renewal: the claimed file's mtime is refreshed every
+// SPOOL_HEARTBEAT_V5 seconds while its unit is searched, so spool-requeue
+// --stale=S only takes units whose worker stopped renewing (S > heartbeat)
+class SpoolLeaseV5 {
+public:
+    explicit SpoolLeaseV5(fs::path path) : path_(std::move(path)), thread_([this] { run(); }) {}
+    ~SpoolLeaseV5()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_one();
+        thread_.join();
+    }
+
+private:
+    void run()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!cv_.wait_for(lock, std::chrono::seconds(SPOOL_HEARTBEAT_V5), [this] { return stop_; })) {
+            touchV5(path_);
+        }
+    }
+
+    fs::path path_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stop_ = false;
+    std::thread thread_;
+};
+
+// Sorted file names of a directory with the given suffix (temp files skipped)
+static std::vector<std::string> listDirV5(const fs::path& path, const std::string& suffix)
+{
+    std::vector<std::string> names;
+    std::error_code ec;
+    for (fs::directory_iterator it(path, ec), end; !ec && it != end; it.increment(ec)) {
+        const std::string name = it->path().filename().string();
+        if (name[0] == '.') continue;
+        if (name.size() >= suffix.size() &&
+            name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0) {
+            names.push_back(name);
+        }
+    }
+    std::sort(names.begin(), names.end());
+    return names;
+}
+
+// Write to a hidden temp file in the same directory, then rename into place:
+// readers never see a partially written file
+static bool writeFileAtomicV5(const fs::path& path, const std::string& content)
+{
+    const fs::path tmp = path.parent_path() /
+        ("." + path.filename().string() + ".tmp." + std::to_string(getpid()));
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        if (!out) return false;
+        out.write(content.data(), static_cast<std::streamsize>(content.size()));
+        if (!out) return false;
+    }
+    return std::rename(tmp.c_str(), path.c_str()) == 0;
+}
+
+static bool readConfigV5(const std::string& dir, SpoolConfigV5& config)
+{
+    std::ifstream in(fs::path(dir) / "spool.cfg");
+    if (!in) {
+        std::cerr << "Error: " << dir << " is not an initialized spool (missing spool.cfg)" << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(in, line)) {
+        const size_t eq = line.find('=');
+        if (eq == std::string::npos) continue;
+        const std::string key = line.substr(0, eq);
+        const int value = std::atoi(line.c_str() + eq + 1);
+        if (key == "n") config.n = value;
+        else if (key == "bound") config.bound = value;
+        else if (key == "units") config.units = value;
+        else if (key == "prefixes") config.prefixes = value;
+        else if (key == "unit_size") config.unitSize = value;
+    }
+    return config.n >= 2 && config.units >= 0;
+}
+
+// Shared bound: smallest published length, or the initial bound + 1 (exclusive)
+static int readSharedBoundV5(const std::string& dir, int initialBound)
+{
+    int limit = initialBound + 1;
+    for (const std::string& name : listDirV5(fs::path(dir) / "bounds", "")) {
+        if (name.rfind("len_", 0) == 0) {
+            limit = std::min(limit, std::atoi(name.c_str() + 4));
+        }
+    }
+    return limit;
+}
+
+static void publishBoundV5(const std::string& dir, int length, const std::string& worker)
+{
+    char name[32];
+    std::snprintf(name, sizeof(name), "len_%03d", length);
+    writeFileAtomicV5(fs::path(dir) / "bounds" / name, worker + "\n");
+}
+
+static bool parseResultV5(const fs::path& path, SpoolResultV5& result)
+{
+    std::ifstream in(path);
+    std::string token;
+    while (in >> token) {
+        const size_t eq = token.find('=');
+        if (eq == std::string::npos) continue;
+        const std::string key = token.substr(0, eq);
+        const std::string value = token.substr(eq + 1);
+        if (key == "unit") result.unit = std::atoi(value.c_str());
+        else if (key == "worker") result.worker = value;
+        else if (key == "bound") result.bound = std::atoi(value.c_str());
+        else if (key == "length") result.length = std::atoi(value.c_str());
+        else if (key == "nodes") result.nodes = std::atoll(value.c_str());
+        else if (key == "time") result.time = std::atof(value.c_str());
+        else if (key == "marks") {
+            std::istringstream list(value);
+            std::string item;
+            while (std::getline(list, item, ',')) {
+                if (!item.empty()) result.marks.push_back(std::atoi(item.c_str()));
+            }
+        }
+    }
+    return result.unit >= 0;
+}
+
+// =============================================================================
+// COORDINATOR
+// =============================================================================
+int spoolInitV5(const std::string& dir, int n, int maxLen, const SearchOptionsV5& options,
+                int unitSize)
+{
+    const fs::path root(dir);
+    std::error_code ec;
+    if (fs::exists(root / "spool.cfg", ec)) {
+        std::cerr << "Error: " << dir << " already holds a spool (remove it first)" << std::endl;
+        return 1;
+    }
+    for (const char* sub : {"pending", "running", "done", "bounds"}) {
+        fs::create_directories(root / sub, ec);
+        if (ec) {
+            std::cerr << "Error: cannot create " << (root / sub) << ": " << ec.message() << std::endl;
+            return 1;
+        }
+    }
+    if (unitSize < 1) unitSize = 1;
+
+    // Workers search with the engine's clamp: record the bound actually searched
+    const bool clamped = maxLen > MAX_LEN_V5;
+    if (clamped) maxLen = MAX_LEN_V5;
+
+    std::vector<PrefixStubV5> stubs;
+    generatePrefixStubsV5(n, maxLen, options, stubs);
+
+    const int numUnits = static_cast<int>((stubs.size() + unitSize - 1) / unitSize);
+    for (int u = 0; u < numUnits; ++u) {
+        const size_t first = static_cast<size_t>(u) * unitSize;
+        const size_t count = std::min(stubs.size() - first, static_cast<size_t>(unitSize));
+
+        SpoolUnitHeaderV5 header;
+        std::memcpy(header.magic, SPOOL_MAGIC_V5, sizeof(header.magic));
+        header.unitId = static_cast<uint32_t>(u);
+        header.n = n;
+        header.bound = maxLen;
+        header.count = static_cast<int32_t>(count);
+
+        std::string payload(reinterpret_cast<const char*>(&header), sizeof(header));
+        payload.append(reinterpret_cast<const char*>(&stubs[first]), count * sizeof(PrefixStubV5));
+        if (!writeFileAtomicV5(root / "pending" / (unitNameV5(u) + ".bin"), payload)) {
+            std::cerr << "Error: cannot write unit " << u << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostringstream cfg;
+    cfg << "n=" << n << "\n"
+        << "bound=" << maxLen << "\n"
+        << "units=" << numUnits << "\n"
+        << "prefixes=" << stubs.size() << "\n"
+        << "unit_size=" << unitSize << "\n";
+    if (!writeFileAtomicV5(root / "spool.cfg", cfg.str())) {
+        std::cerr << "Error: cannot write spool.cfg" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Spool      : " << dir << "\n";
+    std::cout << "n          : " << n << "\n";
+    std::cout << "Bound      : " << maxLen << (clamped ? " (clamped, 128-bit distance set)" : "") << "\n";
+    std::cout << "Prefixes   : " << stubs.size() << "\n";
+    std::cout << "Units      : " << numUnits << " (" << unitSize << " prefixes/unit)\n";
+    return 0;
+}
+
+// =============================================================================
+// WORKER
+// =============================================================================
+int spoolWorkV5(const std::string& dir, int maxUnits)
+{
+    SpoolConfigV5 config;
+    if (!readConfigV5(dir, config)) return 1;
+
+    const fs::path root(dir);
+    const std::string worker = workerIdV5();
+    const SearchOptionsV5 options;
+
+    std::cout << "Worker     : " << worker << " (" << omp_get_max_threads() << " threads)\n";
+
+    int processed = 0;
+    long long totalNodes = 0;
+    while (maxUnits <= 0 || processed < maxUnits) {
+        const std::vector<std::string> pending = listDirV5(root / "pending", ".bin");
+        if (pending.empty()) break;
+
+        // Claim: rename is atomic, exactly one worker wins each unit. The
+        // new name records the owner, the mtime the claim time; if a requeue
+        // took the file back before the touch, the claim is simply lost
+        std::string name;
+        for (const std::string& candidate : pending) {
+            const std::string claimed = claimedNameV5(candidate, worker);
+            if (std::rename((root / "pending" / candidate).c_str(),
+                            (root / "running" / claimed).c_str()) == 0) {
+                if (touchV5(root / "running" / claimed)) name = claimed;
+                break;
+            }
+        }
+        if (name.empty()) continue;
+
+        const fs::path unitPath = root / "running" / name;
+        std::ifstream in(unitPath, std::ios::binary);
+        SpoolUnitHeaderV5 header;
+        in.read(reinterpret_cast<char*>(&header), sizeof(header));
+        if (!in || std::memcmp(header.magic, SPOOL_MAGIC_V5, sizeof(header.magic)) != 0 ||
+            header.n != config.n || header.count < 0) {
+            std::cerr << "Error: corrupt unit " << name << " (left in running/)" << std::endl;
+            return 1;
+        }
+        std::vector<PrefixStubV5> stubs(header.count);
+        in.read(reinterpret_cast<char*>(stubs.data()),
+                static_cast<std::streamsize>(stubs.size() * sizeof(PrefixStubV5)));
+        if (!in) {
+            std::cerr << "Error: truncated unit " << name << " (left in running/)" << std::endl;
+            return 1;
+        }
+        in.close();
+
+        // Search strictly below the best length any worker has published
+        const int bound = std::min<int>(header.bound, readSharedBoundV5(dir, config.bound) - 1);
+
+        GolombRuler best;
+        SearchStatsV5 stats;
+        auto start = std::chrono::high_resolution_clock::now();
+        {
+            SpoolLeaseV5 lease(unitPath);
+            searchPrefixStubsV5(config.n, bound, stubs, options, best, stats);
+        }
+        auto end = std::chrono::high_resolution_clock::now();
+        const double elapsed = std::chrono::duration<double>(end - start).count();
+
+        const bool found = !best.marks.empty();
+        if (found) {
+            publishBoundV5(dir, best.length, worker);
+        }
+
+        std::ostringstream line;
+        line << "unit=" << header.unitId << " worker=" << worker << " bound=" << bound
+             << " length=" << (found ? best.length : -1) << " nodes=" << stats.explored
+             << " time=" << std::fixed << std::setprecision(6) << elapsed << " marks=";
+        for (size_t i = 0; i < best.marks.size(); ++i) {
+            line << (i > 0 ? "," : "") << best.marks[i];
+        }
+        line << "\n";
+
+        // The result is valid even if the unit was requeued meanwhile (a
+        // second finisher writes the same unit's line); the claimed name is
+        // this worker's own, so removing it never touches another claim
+        const std::string base = unitBaseV5(name);
+        if (!writeFileAtomicV5(root / "done" / (base + ".result"), line.str())) {
+            std::cerr << "Error: cannot write result for " << name << std::endl;
+            return 1;
+        }
+        std::error_code ec;
+        if (!fs::remove(unitPath, ec)) {
+            std::cout << "  " << base << "  lease lost (requeued while running)\n";
+        }
+
+        processed++;
+        totalNodes += stats.explored;
+        std::cout << std::fixed << std::setprecision(3)
+                  << "  " << base << "  bound " << std::setw(4) << bound
+                  << "  " << (found ? "found " + std::to_string(best.length) : std::string("-"))
+                  << "  " << stats.explored << " states  " << elapsed << " s\n" << std::flush;
+    }
+
+    std::cout << "Units      : " << processed << "\n";
+    std::cout << "States     : " << totalNodes << "\n";
+    return 0;
+}
+
+// =============================================================================
+// MERGE / STATUS / REQUEUE
+// =============================================================================
+int spoolMergeV5(const std::string& dir)
+{
+    SpoolConfigV5 config;
+    if (!readConfigV5(dir, config)) return 1;
+
+    const fs::path root(dir);
+    std::vector<SpoolResultV5> results;
+    std::vector<bool> seen(config.units, false);
+    for (const std::string& name : listDirV5(root / "done", ".result")) {
+        SpoolResultV5 result;
+        if (parseResultV5(root / "done" / name, result) && result.unit < config.units) {
+            seen[result.unit] = true;
+            results.push_back(result);
+        }
+    }
+
+    int missing = 0;
+    for (bool s : seen) missing += s ? 0 : 1;
+
+    const SpoolResultV5* best = nullptr;
+    long long totalNodes = 0;
+    double totalTime = 0.0;
+    std::map<std::string, int> unitsPerWorker;
+    for (const SpoolResultV5& result : results) {
+        totalNodes += result.nodes;
+        totalTime += result.time;
+        unitsPerWorker[result.worker]++;
+        if (result.length < 0) continue;
+        if (!best || result.length < best->length ||
+            (result.length == best->length && result.unit < best->unit)) {
+            best = &result;
+        }
+    }
+
+    std::cout << "=============================================================\n";
+    std::cout << "       OPTIMAL GOLOMB RULER - OPENMP V5 SPOOL MERGE (n=" << config.n << ")\n";
+    std::cout << "=============================================================\n";
+    std::cout << "Units      : " << (config.units - missing) << " / " << config.units << " done\n";
+    std::cout << "Workers    : " << unitsPerWorker.size() << "\n";
+    for (const auto& entry : unitsPerWorker) {
+        std::cout << "  " << entry.first << " : " << entry.second << " units\n";
+    }
+    std::cout << "States     : " << totalNodes << "\n";
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "Work time  : " << totalTime << " s (sum over units)\n";
+
+    if (missing > 0) {
+        std::cout << "Incomplete : " << missing << " unit(s) not done, result is not final\n";
+    }
+    if (!best) {
+        std::cout << "Length     : none <= " << config.bound << "\n";
+        std::cout << "=============================================================\n";
+        return missing > 0 ? 1 : 0;
+    }
+
+    const bool valid = GolombRuler::isValid(best->marks);
+    std::cout << "Length     : " << best->length << " (unit " << best->unit << ")\n";
+    std::cout << "Valid      : " << (valid ? "YES" : "NO") << "\n";
+    std::cout << "\nRuler: { ";
+    for (size_t i = 0; i < best->marks.size(); ++i) {
+        if (i > 0) std::cout << ", ";
+        std::cout << best->marks[i];
+    }
+    std::cout << " }\n";
+    std::cout << "=============================================================\n";
+
+    return (valid && missing == 0) ? 0 : 1;
+}
+
+int spoolStatusV5(const std::string& dir)
+{
+    SpoolConfigV5 config;
+    if (!readConfigV5(dir, config)) return 1;
+
+    const fs::path root(dir);
+    const int limit = readSharedBoundV5(dir, config.bound);
+    std::cout << "n          : " << config.n << "\n";
+    std::cout << "Units      : " << config.units << " (" << config.prefixes << " prefixes)\n";
+    std::cout << "Pending    : " << listDirV5(root / "pending", ".bin").size() << "\n";
+    std::cout << "Running    : " << listDirV5(root / "running", ".bin").size() << "\n";
+    std::cout << "Done       : " << listDirV5(root / "done", ".result").size() << "\n";
+    std::cout << "Best bound : ";
+    if (limit <= config.bound) std::cout << limit << "\n";
+    else std::cout << "none yet (initial " << config.bound << ")\n";
+    return 0;
+}
+
+int spoolRequeueV5(const std::string& dir, int staleSeconds)
+{
+    SpoolConfigV5 config;
+    if (!readConfigV5(dir, config)) return 1;
+
+    const fs::path root(dir);
+    const auto now = fs::file_time_type::clock::now();
+    int moved = 0;
+    int kept = 0;
+    for (const std::string& name : listDirV5(root / "running", ".bin")) {
+        const fs::path path = root / "running" / name;
+        const std::string owner = claimOwnerV5(name);
+        std::error_code ec;
+        const auto mtime = fs::last_write_time(path, ec);
+        if (ec) continue;  // Finished meanwhile
+        const double age = std::chrono::duration<double>(now - mtime).count();
+
+        const bool gone = workerGoneV5(owner);
+        const bool stale = staleSeconds > 0 && age > staleSeconds;
+        if (!gone && !stale) {
+            kept++;
+            continue;
+        }
+        if (std::rename(path.c_str(), (root / "pending" / (unitBaseV5(name) + ".bin")).c_str()) == 0) {
+            moved++;
+            std::cout << "  " << unitBaseV5(name) << "  " << (owner.empty() ? "?" : owner)
+                      << (gone ? "  worker gone" : "") << std::fixed << std::setprecision(0)
+                      << "  lease " << age << " s\n";
+        }
+    }
+    std::cout << "Requeued   : " << moved << " unit(s)\n";
+    std::cout << "Kept       : " << kept << " unit(s) with a live lease";
+    if (staleSeconds > 0) std::cout << " (< " << staleSeconds << " s)";
+    else std::cout << " (no --stale: only units of dead local workers are requeued)";
+    std::cout << "\n";
+    return 0;
+}